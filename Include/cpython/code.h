@@ -13,6 +13,7 @@ typedef uint16_t _Py_CODEUNIT;
 #endif
 
 typedef struct _PyOpcache _PyOpcache;
+typedef struct _PyOpcacheStats _PyOpcacheStats;
 
 /* Bytecode object */
 struct PyCodeObject {
@@ -62,6 +63,8 @@ struct PyCodeObject {
     _PyOpcache *co_opcache;
     int co_opcache_flag;  // used to determine when create a cache.
     unsigned char co_opcache_size;  // length of co_opcache.
+    // Hit/miss counters, only allocated while opcache stats are enabled.
+    _PyOpcacheStats *co_opcache_stats;
 };
 
 /* Masks for co_flags above */
@@ -27,6 +27,18 @@ typedef struct {
     PyObject **ma_values;
 } PyDictObject;
 
+/* frozendict shares the PyDictObject layout and the read-only parts of the
+   dict implementation, but is not a dict subclass. */
+PyAPI_DATA(PyTypeObject) PyFrozenDict_Type;
+
+#define PyFrozenDict_CheckExact(op) Py_IS_TYPE(op, &PyFrozenDict_Type)
+#define PyFrozenDict_Check(op) \
+    (PyFrozenDict_CheckExact(op) || \
+     PyType_IsSubtype(Py_TYPE(op), &PyFrozenDict_Type))
+#define PyAnyDict_Check(op) (PyDict_Check(op) || PyFrozenDict_Check(op))
+
+PyAPI_FUNC(PyObject *) PyFrozenDict_New(PyObject *iterable);
+
 PyAPI_FUNC(PyObject *) _PyDict_GetItem_KnownHash(PyObject *mp, PyObject *key,
                                        Py_hash_t hash);
 PyAPI_FUNC(PyObject *) _PyDict_GetItemIdWithError(PyObject *dp,
@@ -45,10 +57,14 @@ PyAPI_FUNC(int) _PyDict_Next(
     PyObject *mp, Py_ssize_t *pos, PyObject **key, PyObject **value, Py_hash_t *hash);
 
 /* Get the number of items of a dictionary. */
-#define PyDict_GET_SIZE(mp)  (assert(PyDict_Check(mp)),((PyDictObject *)mp)->ma_used)
+#define PyDict_GET_SIZE(mp)  (assert(PyAnyDict_Check(mp)),((PyDictObject *)mp)->ma_used)
 PyAPI_FUNC(int) _PyDict_Contains_KnownHash(PyObject *, PyObject *, Py_hash_t);
 PyAPI_FUNC(int) _PyDict_ContainsId(PyObject *, struct _Py_Identifier *);
 PyAPI_FUNC(PyObject *) _PyDict_NewPresized(Py_ssize_t minused);
+PyAPI_FUNC(PyObject *) _PyDict_FromItems(
+    PyObject *const *keys, Py_ssize_t keys_offset,
+    PyObject *const *values, Py_ssize_t values_offset,
+    Py_ssize_t length);
 PyAPI_FUNC(void) _PyDict_MaybeUntrack(PyObject *mp);
 PyAPI_FUNC(int) _PyDict_HasOnlyStringKeys(PyObject *mp);
 Py_ssize_t _PyDict_KeysSize(PyDictKeysObject *keys);
@@ -72,6 +88,7 @@ PyAPI_FUNC(void) _PyDict_DebugMallocStats(FILE *out);
 int _PyObjectDict_SetItem(PyTypeObject *tp, PyObject **dictptr, PyObject *name, PyObject *value);
 PyObject *_PyDict_LoadGlobal(PyDictObject *, PyDictObject *, PyObject *);
 Py_ssize_t _PyDict_GetItemHint(PyDictObject *, PyObject *, Py_ssize_t, PyObject **);
+Py_ssize_t _PyDict_SetItemHint(PyDictObject *, PyObject *, Py_ssize_t, PyObject *);
 
 /* _PyDictView */
 
@@ -137,12 +137,15 @@ typedef struct PyConfig {
     int install_signal_handlers;
     int use_hash_seed;
     unsigned long hash_seed;
+    wchar_t *hash_algorithm;
     int faulthandler;
     int tracemalloc;
     int import_time;
     int show_ref_count;
+    int opcache_stats;
     int dump_refs;
     int malloc_stats;
+    int hugepages;
     wchar_t *filesystem_encoding;
     wchar_t *filesystem_errors;
     wchar_t *pycache_prefix;
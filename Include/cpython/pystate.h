@@ -59,6 +59,18 @@ typedef struct _err_stackitem {
 
 
 // The PyThreadState typedef is in Include/pystate.h.
+/* Number of pymalloc size classes, starting from the smallest one, which
+   have a per-thread cache of free blocks */
+#define _PyObject_NB_CACHED_SIZE_CLASSES 16
+
+typedef struct {
+    /* Free blocks of each size class, linked through their first word */
+    void *free_blocks[_PyObject_NB_CACHED_SIZE_CLASSES];
+    unsigned int count[_PyObject_NB_CACHED_SIZE_CLASSES];
+    /* Cleared by PyThreadState_Clear() */
+    int enabled;
+} _PyObject_BlockCache;
+
 struct _ts {
     /* See Python/ceval.c for comments explaining most fields */
 
@@ -149,6 +161,10 @@ struct _ts {
 
     CFrame root_cframe;
 
+    /* Free small memory blocks kept by pymalloc for this thread, see
+       Objects/obmalloc.c */
+    _PyObject_BlockCache obmalloc_cache;
+
     /* XXX signal handlers should also be here */
 
 };
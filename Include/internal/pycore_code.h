@@ -16,14 +16,47 @@ typedef struct {
     unsigned int tp_version_tag;
 } _PyOpCodeOpt_LoadAttr;
 
+typedef struct {
+    PyTypeObject *type;
+    PyObject *descr;  /* Cached method descriptor (borrowed reference) */
+    unsigned int tp_version_tag;
+} _PyOpcache_LoadMethod;
+
+/* Operand shapes that BINARY_ADD, INPLACE_ADD, COMPARE_OP and CALL_FUNCTION
+   can be specialized for.  The kind is chosen the first time an opcode is
+   executed with a cache and guarded on every later execution. */
+enum _PyOpcache_Kind {
+    OPCACHE_KIND_NONE = 0,
+    OPCACHE_KIND_INT,           /* both operands are exact ints */
+    OPCACHE_KIND_FLOAT,         /* both operands are exact floats */
+    OPCACHE_KIND_UNICODE,       /* both operands are exact strs */
+    OPCACHE_KIND_BUILTIN_O,     /* builtin function taking METH_O */
+    OPCACHE_KIND_BUILTIN_FAST,  /* builtin function taking METH_FASTCALL */
+};
+
+typedef struct {
+    int kind;  /* enum _PyOpcache_Kind */
+} _PyOpcache_Specialized;
+
 struct _PyOpcache {
     union {
         _PyOpcache_LoadGlobal lg;
         _PyOpCodeOpt_LoadAttr la;
+        _PyOpcache_LoadMethod lm;
+        _PyOpcache_Specialized sp;
     } u;
     char optimized;
 };
 
+/* Counters collected when opcode cache stats are enabled, see
+   sys._opcache_stats() */
+struct _PyOpcacheStats {
+    size_t hits;    /* the cached fast path was taken */
+    size_t misses;  /* the cache was consulted but its guard failed */
+    size_t opts;    /* a cache entry was filled for the first time */
+    size_t deopts;  /* a cache entry was disabled for good */
+};
+
 /* Private API */
 int _PyCode_InitOpcache(PyCodeObject *co);
 
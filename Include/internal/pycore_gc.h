@@ -8,14 +8,27 @@ extern "C" {
 #  error "this header requires Py_BUILD_CORE define"
 #endif
 
+/* The _gc_prev flags use the lowest three bits of a PyGC_Head address, so
+   PyGC_Head must be aligned to 8 bytes.  The memory allocators ensure it
+   for the objects, but the list heads embedded in structures or declared
+   on the stack only get the alignment of their type, which is 4 bytes on
+   32-bit platforms without this. */
+#if defined(_MSC_VER)
+#  define _PyGC_HEAD_ALIGNED __declspec(align(8))
+#elif defined(__GNUC__) || defined(__clang__)
+#  define _PyGC_HEAD_ALIGNED __attribute__((aligned(8)))
+#else
+#  define _PyGC_HEAD_ALIGNED
+#endif
+
 /* GC information is stored BEFORE the object structure. */
-typedef struct {
+typedef struct _PyGC_HEAD_ALIGNED {
     // Pointer to next object in the list.
     // 0 means the object is not tracked
     uintptr_t _gc_next;
 
     // Pointer to previous object in the list.
-    // Lowest two bits are used for flags documented later.
+    // Lowest three bits are used for flags documented later.
     uintptr_t _gc_prev;
 } PyGC_Head;
 
@@ -36,8 +49,11 @@ typedef struct {
 #define _PyGC_PREV_MASK_FINALIZED  (1)
 /* Bit 1 is set when the object is in generation which is GCed currently. */
 #define _PyGC_PREV_MASK_COLLECTING (2)
-/* The (N-2) most significant bits contain the real address. */
-#define _PyGC_PREV_SHIFT           (2)
+/* Bit 2 is set when the object is in the permanent generation, or was
+   already examined in the current round of incremental collection. */
+#define _PyGC_PREV_MASK_VISITED    (4)
+/* The (N-3) most significant bits contain the real address. */
+#define _PyGC_PREV_SHIFT           (3)
 #define _PyGC_PREV_MASK            (((uintptr_t) -1) << _PyGC_PREV_SHIFT)
 
 // Lowest bit of _gc_next is used for flags only in GC.
@@ -45,7 +61,7 @@ typedef struct {
 #define _PyGCHead_NEXT(g)        ((PyGC_Head*)(g)->_gc_next)
 #define _PyGCHead_SET_NEXT(g, p) ((g)->_gc_next = (uintptr_t)(p))
 
-// Lowest two bits of _gc_prev is used for _PyGC_PREV_MASK_* flags.
+// Lowest three bits of _gc_prev is used for _PyGC_PREV_MASK_* flags.
 #define _PyGCHead_PREV(g) ((PyGC_Head*)((g)->_gc_prev & _PyGC_PREV_MASK))
 #define _PyGCHead_SET_PREV(g, p) do { \
     assert(((uintptr_t)p & ~_PyGC_PREV_MASK) == 0); \
@@ -117,6 +133,21 @@ struct gc_generation {
                   generations */
 };
 
+/* Phases of a collection which are timed separately */
+enum _PyGC_Phase {
+    GC_PHASE_UPDATE_REFS,
+    GC_PHASE_SUBTRACT_REFS,
+    GC_PHASE_MOVE_UNREACHABLE,
+    GC_PHASE_FINALIZE,
+    GC_PHASE_DELETE_GARBAGE,
+    NUM_GC_PHASES
+};
+
+/* Pause histogram bucket i counts the collections which took less than
+   2**i microseconds, and at least 2**(i-1) microseconds.  The last bucket
+   also counts the longer collections. */
+#define NUM_GC_PAUSE_BUCKETS 24
+
 /* Running stats per generation */
 struct gc_generation_stats {
     /* total number of collections */
@@ -125,6 +156,13 @@ struct gc_generation_stats {
     Py_ssize_t collected;
     /* total number of uncollectable objects (put into gc.garbage) */
     Py_ssize_t uncollectable;
+    /* total and longest time spent in collections */
+    _PyTime_t pause_total;
+    _PyTime_t pause_max;
+    /* number of collections per duration bucket */
+    Py_ssize_t pause_histogram[NUM_GC_PAUSE_BUCKETS];
+    /* total time spent in each phase of the collections */
+    _PyTime_t phase_times[NUM_GC_PHASES];
 };
 
 struct _gc_runtime_state {
@@ -141,6 +179,10 @@ struct _gc_runtime_state {
     PyGC_Head *generation0;
     /* a permanent generation which won't be collected */
     struct gc_generation permanent_generation;
+    /* objects made immortal by gc.freeze(immortalize=True).  They are kept
+       out of the permanent generation, so that moving other objects in and
+       out of it never writes to their GC headers. */
+    PyGC_Head immortal;
     struct gc_generation_stats generation_stats[NUM_GENERATIONS];
     /* true if we are currently running the collector */
     int collecting;
@@ -159,6 +201,19 @@ struct _gc_runtime_state {
        collections, and are awaiting to undergo a full collection for
        the first time. */
     Py_ssize_t long_lived_pending;
+    /* Incremental collection of the oldest generation: objects of the
+       oldest generation which were already examined in the current round
+       are kept here until the round is complete.  max_pause is the pause
+       target in microseconds (0 disables incremental collection) and
+       increment_size the number of objects to examine in the next
+       increment, adjusted after each increment to meet max_pause. */
+    PyGC_Head incremental_visited;
+    Py_ssize_t max_pause;
+    Py_ssize_t increment_size;
+    /* Duration of the last collection and of its phases, reported to the
+       callbacks. */
+    _PyTime_t last_pause;
+    _PyTime_t last_phase_times[NUM_GC_PHASES];
 };
 
 extern void _PyGC_InitState(struct _gc_runtime_state *);
@@ -170,6 +225,7 @@ extern Py_ssize_t _PyGC_CollectNoFail(PyThreadState *tstate);
 extern void _PyFrame_ClearFreeList(PyInterpreterState *interp);
 extern void _PyTuple_ClearFreeList(PyInterpreterState *interp);
 extern void _PyFloat_ClearFreeList(PyInterpreterState *interp);
+extern void _PyLong_ClearFreeList(PyInterpreterState *interp);
 extern void _PyList_ClearFreeList(PyInterpreterState *interp);
 extern void _PyDict_ClearFreeList(PyInterpreterState *interp);
 extern void _PyAsyncGen_ClearFreeLists(PyInterpreterState *interp);
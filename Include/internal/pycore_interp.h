@@ -85,6 +85,14 @@ struct _Py_unicode_state {
     struct _Py_unicode_ids ids;
 };
 
+struct _Py_long_state {
+    /* Special free list of single-digit ints
+       free_list is a singly-linked list of available PyLongObjects,
+       linked via abuse of their ob_type members. */
+    int numfree;
+    PyLongObject *free_list;
+};
+
 struct _Py_float_state {
     /* Special free list
        free_list is a singly-linked list of available PyFloatObjects,
@@ -133,6 +141,9 @@ struct _Py_dict_state {
     int numfree;
     PyDictKeysObject *keys_free_list[PyDict_MAXFREELIST];
     int keys_numfree;
+    /* Same for the smaller keys of dicts created with at most 2 entries */
+    PyDictKeysObject *tiny_keys_free_list[PyDict_MAXFREELIST];
+    int tiny_keys_numfree;
 };
 
 struct _Py_frame_state {
@@ -208,8 +219,15 @@ struct type_cache {
 
 /* interpreter state */
 
-#define _PY_NSMALLPOSINTS           257
-#define _PY_NSMALLNEGINTS           5
+/* The range of preallocated small ints can be changed at build time, e.g.
+   with CFLAGS="-D_PY_NSMALLPOSINTS=4097".  The ints must fit in a single
+   digit. */
+#ifndef _PY_NSMALLPOSINTS
+#  define _PY_NSMALLPOSINTS         1025
+#endif
+#ifndef _PY_NSMALLNEGINTS
+#  define _PY_NSMALLNEGINTS         5
+#endif
 
 // _PyLong_GetZero() and _PyLong_GetOne() must always be available
 #if _PY_NSMALLPOSINTS < 2
@@ -294,6 +312,7 @@ struct _is {
        -_PY_NSMALLNEGINTS (inclusive) to _PY_NSMALLPOSINTS (not inclusive).
     */
     PyLongObject* small_ints[_PY_NSMALLNEGINTS + _PY_NSMALLPOSINTS];
+    struct _Py_long_state long_state;
     struct _Py_bytes_state bytes;
     struct _Py_unicode_state unicode;
     struct _Py_float_state float_state;
@@ -13,6 +13,11 @@ extern "C" {
 
 #define _PyList_ITEMS(op) (_PyList_CAST(op)->ob_item)
 
+/* Maximum number of threads used by list.sort(parallel=True) */
+#define _PyList_SORT_MAX_THREADS 8
+
+PyAPI_FUNC(int) _PyList_SetSortThreads(int nthreads);
+
 
 #ifdef __cplusplus
 }
@@ -7,4 +7,10 @@
 
 uint64_t _Py_KeyedHash(uint64_t, const char *, Py_ssize_t);
 
+/* Select the str, bytes and memoryview hash function by name
+   (PYTHONHASHALGORITHM).  _PyHash_SetFuncDef(NULL) selects the build
+   default. */
+extern PyHash_FuncDef* _PyHash_LookupFuncDef(const wchar_t *name);
+extern void _PyHash_SetFuncDef(PyHash_FuncDef *funcdef);
+
 #endif
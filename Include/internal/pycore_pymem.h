@@ -69,6 +69,23 @@ PyAPI_FUNC(int) _PyMem_GetAllocatorName(
    PYMEM_ALLOCATOR_NOT_SET does nothing. */
 PyAPI_FUNC(int) _PyMem_SetupAllocators(PyMemAllocatorName allocator);
 
+/* Enable or disable huge pages for the pymalloc arenas allocated by the
+   default object arena allocator (-X hugepages). */
+extern void _PyObject_SetArenaHugePages(int enabled);
+
+/* Release the memory of the free pools of the pymalloc arenas which are
+   still in use (sys._trim_memory()).  Return the number of bytes released.
+   Must be called with the GIL held. */
+extern Py_ssize_t _PyObject_TrimArenas(void);
+
+/* Return the free blocks cached by pymalloc for the thread to their pools.
+   Must be called with the GIL held. */
+extern void _PyObject_FlushBlockCache(PyThreadState *tstate);
+
+/* Same as _PyObject_FlushBlockCache(), and stop caching blocks for the
+   thread. */
+extern void _PyObject_ClearBlockCache(PyThreadState *tstate);
+
 struct _PyTraceMalloc_Config {
     /* Module initialized?
        Variable protected by the GIL */
@@ -8,11 +8,14 @@ extern "C" {
 
 /* This is published for the benefit of "friends" marshal.c and _decimal.c. */
 
-/* Parameters of the integer representation.  There are two different
+/* Parameters of the integer representation.  There are three different
    sets of parameters: one set for 30-bit digits, stored in an unsigned 32-bit
-   integer type, and one set for 15-bit digits with each digit stored in an
-   unsigned short.  The value of PYLONG_BITS_IN_DIGIT, defined either at
-   configure time or in pyport.h, is used to decide which digit size to use.
+   integer type, one set for 15-bit digits with each digit stored in an
+   unsigned short, and one set for 60-bit digits stored in an unsigned 64-bit
+   integer type, which needs a 128-bit 'twodigits' and is therefore only
+   available with compilers that provide __uint128_t.  The value of
+   PYLONG_BITS_IN_DIGIT, defined either at configure time or in pyport.h, is
+   used to decide which digit size to use.
 
    Type 'digit' should be able to hold 2*PyLong_BASE-1, and type 'twodigits'
    should be an unsigned integer type able to hold all integers up to
@@ -38,7 +41,8 @@ extern "C" {
      digit; with the current values this forces PyLong_SHIFT >= 9
 
   The values 15 and 30 should fit all of the above requirements, on any
-  platform.
+  platform.  The value 60 fits them on platforms where unsigned long is 64
+  bits wide.
 */
 
 #if PYLONG_BITS_IN_DIGIT == 30
@@ -57,8 +61,19 @@ typedef long stwodigits; /* signed variant of twodigits */
 #define PyLong_SHIFT    15
 #define _PyLong_DECIMAL_SHIFT   4 /* max(e such that 10**e fits in a digit) */
 #define _PyLong_DECIMAL_BASE    ((digit)10000) /* 10 ** DECIMAL_SHIFT */
+#elif PYLONG_BITS_IN_DIGIT == 60
+#if !defined(HAVE_GCC_UINT128_T) || SIZEOF_LONG < 8
+#error "60-bit digits require __uint128_t and a 64-bit long"
+#endif
+typedef uint64_t digit;
+typedef int64_t sdigit; /* signed variant of digit */
+typedef __uint128_t twodigits;
+typedef __int128_t stwodigits; /* signed variant of twodigits */
+#define PyLong_SHIFT    60
+#define _PyLong_DECIMAL_SHIFT   18 /* max(e such that 10**e fits in a digit) */
+#define _PyLong_DECIMAL_BASE    ((digit)1000000000000000000) /* 10 ** DECIMAL_SHIFT */
 #else
-#error "PYLONG_BITS_IN_DIGIT should be 15 or 30"
+#error "PYLONG_BITS_IN_DIGIT should be 15, 30 or 60"
 #endif
 #define PyLong_BASE     ((digit)1 << PyLong_SHIFT)
 #define PyLong_MASK     ((digit)(PyLong_BASE - 1))
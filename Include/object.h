@@ -458,6 +458,33 @@ PyAPI_FUNC(void) Py_DecRef(PyObject *);
 PyAPI_FUNC(void) _Py_IncRef(PyObject *);
 PyAPI_FUNC(void) _Py_DecRef(PyObject *);
 
+/* Immortal objects have a reference count of at least _Py_IMMORTAL_REFCNT,
+ * which Py_INCREF() and Py_DECREF() leave untouched, so that they never
+ * write to the memory of these objects.  They are never deallocated.
+ * gc.freeze(immortalize=True) makes the frozen objects immortal, so that
+ * the pages holding them remain shared with the child processes after a
+ * fork().  The value leaves room for the reference count to be shifted by
+ * the garbage collector (see _PyGC_PREV_SHIFT), and no mortal object can
+ * reach it: that would take 2**59 references, more than the address space.
+ *
+ * On 32-bit platforms, any such value is within the reach of real reference
+ * counts, so immortal objects are not supported and _Py_IMMORTAL_REFCNT is
+ * not defined.
+ */
+#if SIZEOF_VOID_P > 4
+#define _Py_IMMORTAL_REFCNT (PY_SSIZE_T_MAX >> 4)
+
+static inline int _Py_IsImmortal(const PyObject *op)
+{
+    return op->ob_refcnt >= _Py_IMMORTAL_REFCNT;
+}
+#else
+static inline int _Py_IsImmortal(const PyObject *Py_UNUSED(op))
+{
+    return 0;
+}
+#endif
+
 static inline void _Py_INCREF(PyObject *op)
 {
 #if defined(Py_REF_DEBUG) && defined(Py_LIMITED_API) && Py_LIMITED_API+0 >= 0x030A0000
@@ -466,6 +493,9 @@ static inline void _Py_INCREF(PyObject *op)
 #else
     // Non-limited C API and limited C API for Python 3.9 and older access
     // directly PyObject.ob_refcnt.
+    if (_Py_IsImmortal(op)) {
+        return;
+    }
 #ifdef Py_REF_DEBUG
     _Py_RefTotal++;
 #endif
@@ -486,6 +516,9 @@ static inline void _Py_DECREF(
 #else
     // Non-limited C API and limited C API for Python 3.9 and older access
     // directly PyObject.ob_refcnt.
+    if (_Py_IsImmortal(op)) {
+        return;
+    }
 #ifdef Py_REF_DEBUG
     _Py_RefTotal--;
 #endif
@@ -114,11 +114,14 @@ PyAPI_FUNC(PyHash_FuncDef*) PyHash_GetFuncDef(void);
 
 /* hash algorithm selection
  *
- * The values for Py_HASH_SIPHASH24 and Py_HASH_FNV are hard-coded in the
- * configure script.
+ * The values for Py_HASH_SIPHASH24, Py_HASH_FNV and Py_HASH_SIPHASH13 are
+ * hard-coded in the configure script.  Py_HASH_ALGORITHM only selects the
+ * default: all of the built-in algorithms can be selected at startup with
+ * the PYTHONHASHALGORITHM environment variable.
  *
  * - FNV is available on all platforms and architectures.
- * - SIPHASH24 only works on platforms that don't require aligned memory for integers.
+ * - SIPHASH24 and SIPHASH13 are slower on platforms that require aligned
+ *   memory for integers.
  * - With EXTERNAL embedders can provide an alternative implementation with::
  *
  *     PyHash_FuncDef PyHash_Func = {...};
@@ -128,6 +131,7 @@ PyAPI_FUNC(PyHash_FuncDef*) PyHash_GetFuncDef(void);
 #define Py_HASH_EXTERNAL 0
 #define Py_HASH_SIPHASH24 1
 #define Py_HASH_FNV 2
+#define Py_HASH_SIPHASH13 3
 
 #ifndef Py_HASH_ALGORITHM
 #  ifndef HAVE_ALIGNED_REQUIRED
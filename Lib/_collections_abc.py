@@ -845,6 +845,7 @@ def __eq__(self, other):
     __reversed__ = None
 
 Mapping.register(mappingproxy)
+Mapping.register(frozendict)
 
 
 class MappingView(Sized):
@@ -356,6 +356,26 @@ def test_find_shift_table_overflow(self):
         self.checkequal(len(text2) - N*len("de") - len(pattern2),
                         text2, 'find', pattern2)
 
+    def test_find_count_block_boundaries(self):
+        # Matches starting and ending at every offset relative to the
+        # blocks compared at once by the vectorized search.
+        for m in range(1, 40):
+            p = ''.join('xyz'[i % 3] for i in range(m - 1)) + 'w'
+            for k in range(0, 70):
+                text = 'x' * k + p + 'x' * (70 - k)
+                self.checkequal(k, text, 'find', p)
+                self.checkequal(1, text, 'count', p)
+                self.checkequal(-1, text, 'find', p[:-1] + 'v')
+                self.checkequal(0, text, 'count', p[:-1] + 'v')
+        # Overlapping candidates are not counted twice.
+        for m in range(2, 20):
+            p = 'a' * m
+            for n in range(m, 80):
+                self.checkequal(n // m, 'a' * n, 'count', p)
+                self.checkequal(n // m, ('a' * n) + 'b', 'count', p)
+                self.checkequal('a' * (n - m * min(3, n // m)),
+                                'a' * n, 'replace', p, '', 3)
+
     def test_lower(self):
         self.checkequal('hello', 'HeLLo', 'lower')
         self.checkequal('hello', 'hello', 'lower')
@@ -465,6 +485,21 @@ def test_split(self):
         self.checkraises(ValueError, 'hello', 'split', '')
         self.checkraises(ValueError, 'hello', 'split', '', 0)
 
+    def test_split_long(self):
+        # Separators before, inside and after blocks of 16 characters.
+        for n in range(1, 40):
+            words = ['x' * (k % n) for k in range(50)]
+            for sep in '|', '|-':
+                text = sep.join(words)
+                self.checkequal(words, text, 'split', sep)
+                self.checkequal(words[:3] + [sep.join(words[3:])],
+                                text, 'split', sep, 3)
+            words = ['x' * (k % n + 1) for k in range(50)]
+            self.checkequal(words, ' '.join(words), 'split')
+            self.checkequal(words, '  \t'.join(words) + '\n', 'split')
+            self.checkequal(words, '\n'.join(words), 'splitlines')
+            self.checkequal(words, '\r\n'.join(words), 'splitlines')
+
     def test_rsplit(self):
         # by a char
         self.checkequal(['a', 'b', 'c', 'd'], 'a|b|c|d', 'rsplit', '|')
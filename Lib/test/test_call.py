@@ -9,6 +9,7 @@
 import itertools
 import gc
 import contextlib
+import sys
 
 
 class FunctionCalls(unittest.TestCase):
@@ -713,5 +714,68 @@ def test_multiple_values(self):
             A().method_two_args("x", "y", x="oops")
 
 
+class TestInlinedCalls(unittest.TestCase):
+    # Calls between Python functions don't recurse on the C stack
+
+    @cpython_only
+    @unittest.skipIf(sys.gettrace(), "tracing disables inlined calls")
+    def test_deep_recursion(self):
+        def f(n):
+            return f(n - 1) + 1 if n else 0
+
+        def g(n, *, k):
+            return g(n - 1, k=k) if n else k
+
+        class C:
+            def m(self, n):
+                return self.m(n - 1) if n else n
+
+        limit = sys.getrecursionlimit()
+        self.addCleanup(sys.setrecursionlimit, limit)
+        sys.setrecursionlimit(200_000)
+        self.assertEqual(f(100_000), 100_000)
+        self.assertEqual(g(100_000, k='k'), 'k')
+        self.assertEqual(C().m(100_000), 0)
+
+    def test_recursion_limit(self):
+        def f():
+            return f()
+        self.assertRaises(RecursionError, f)
+
+    def test_exception_traceback(self):
+        def f(n):
+            if n == 0:
+                raise ValueError(n)
+            return f(n - 1)
+
+        try:
+            f(3)
+        except ValueError as exc:
+            tb = exc.__traceback__
+        frames = []
+        while tb is not None:
+            frames.append(tb.tb_frame)
+            tb = tb.tb_next
+        self.assertEqual([fr.f_locals['n'] for fr in frames[1:]],
+                         [3, 2, 1, 0])
+        self.assertIs(frames[2].f_back, frames[1])
+
+    def test_profile_enabled_in_callee(self):
+        events = []
+        def profile(frame, event, arg):
+            if event == 'return':
+                events.append(frame.f_code.co_name)
+
+        def callee():
+            sys.setprofile(profile)
+
+        def caller():
+            callee()
+
+        caller()
+        sys.setprofile(None)
+        self.assertEqual(events[:2], ['callee', 'caller'])
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -3,6 +3,7 @@
 # See test_cmd_line_script.py for testing of script execution
 
 import os
+import re
 import subprocess
 import sys
 import tempfile
@@ -774,6 +775,56 @@ def test_pythonmalloc(self):
             with self.subTest(env_var=env_var, name=name):
                 self.check_pythonmalloc(env_var, name)
 
+    def check_hugepages(self, args, env_var, expected):
+        code = textwrap.dedent('''
+            import sys, _testinternalcapi
+            print(_testinternalcapi.get_config()['hugepages'])
+            # allocate and free arenas, some of them while others of the
+            # same huge page region are still in use
+            for i in range(3):
+                data = [bytes(8) for i in range(300_000)]
+                keep = data[::50_000]
+                del data
+                del keep
+            sys._debugmallocstats()
+        ''')
+        env = dict(os.environ)
+        env.pop('PYTHONMALLOC', None)
+        if env_var is not None:
+            env['PYTHONHUGEPAGES'] = env_var
+        else:
+            env.pop('PYTHONHUGEPAGES', None)
+        proc = subprocess.run((sys.executable, *args, '-c', code),
+                              stdout=subprocess.PIPE,
+                              stderr=subprocess.PIPE,
+                              universal_newlines=True,
+                              env=env)
+        self.assertEqual(proc.returncode, 0, proc)
+        self.assertEqual(proc.stdout.rstrip(), str(expected))
+        match = re.search(r'^# regions advised for THP += +(\d+)$',
+                          proc.stderr, re.MULTILINE)
+        if match is None:
+            # no pymalloc or no mmap()
+            return
+        if expected:
+            self.assertGreater(int(match.group(1)), 0)
+        else:
+            self.assertEqual(int(match.group(1)), 0)
+
+    @support.cpython_only
+    def test_hugepages(self):
+        # Test the -X hugepages option and the PYTHONHUGEPAGES environment
+        # variable
+        tests = [
+            ((), None, 0),
+            (('-X', 'hugepages'), None, 1),
+            ((), '1', 1),
+            (('-E',), '1', 0),
+        ]
+        for args, env_var, expected in tests:
+            with self.subTest(args=args, env_var=env_var):
+                self.check_hugepages(args, env_var, expected)
+
     def test_pythondevmode_env(self):
         # Test the PYTHONDEVMODE environment variable
         code = "import sys; print(sys.flags.dev_mode)"
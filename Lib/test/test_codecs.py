@@ -852,6 +852,37 @@ def test_decode_error(self):
                 self.assertEqual(data.decode(self.encoding, error_handler),
                                  expected)
 
+    def test_decode_ascii_runs(self):
+        # runs of ASCII characters of various lengths and alignments,
+        # followed by a character of each kind
+        for char in ('\x80', '\xff', '€', '\U0001f600'):
+            for length in (15, 16, 17, 31, 32, 33, 100):
+                for offset in range(8):
+                    s = 'x' * offset + char + 'a' * length + char + 'b' * length
+                    data = memoryview(s.encode('utf-8'))[offset:]
+                    with self.subTest(char=char, length=length, offset=offset):
+                        self.assertEqual(codecs.utf_8_decode(data)[0],
+                                         s[offset:])
+                        self.assertEqual(
+                            codecs.utf_8_decode(data[:-1].tobytes() + b'\xff',
+                                                'replace')[0],
+                            s[offset:-1] + '\ufffd')
+
+    def test_encode_runs(self):
+        # runs of ASCII and 2-byte characters of various lengths, in strings
+        # of each kind
+        for char in ('\xe9', '\u0436', '\u20ac', '\U0001f600'):
+            for length in (7, 8, 9, 15, 16, 17, 100):
+                for run in ('a', '\xe9', '\u0436'):
+                    s = char + run * length + char + 'b' * length + '\udc80'
+                    expected = b''.join(c.encode('utf-8', 'surrogateescape')
+                                        for c in s)
+                    with self.subTest(char=char, length=length, run=run):
+                        self.assertEqual(s.encode('utf-8', 'surrogateescape'),
+                                         expected)
+                        self.assertEqual(s[:-1].encode('utf-8'),
+                                         expected[:-1])
+
     def test_lone_surrogates(self):
         super().test_lone_surrogates()
         # not sure if this is making sense for
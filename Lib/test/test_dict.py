@@ -374,6 +374,64 @@ def test_copy_noncompact(self):
         d2 = d.copy()
         self.assertEqual(d2, d)
 
+    @support.cpython_only
+    def test_copy_tiny(self):
+        # Copies of dicts with at most 2 entries use the smaller table.
+        tiny = sys.getsizeof({'a': 1})
+        d = {}
+        d['a'] = 1
+        self.assertGreater(sys.getsizeof(d), tiny)
+        for copy in (d.copy(), dict(d), {**d}, dict(a=1)):
+            self.assertEqual(copy, {'a': 1})
+            self.assertEqual(sys.getsizeof(copy), tiny)
+
+        # ... and grow as usual.
+        copy = d.copy()
+        for i in range(100):
+            copy[i] = i
+        self.assertEqual(list(copy), ['a', *range(100)])
+
+    def test_update_noncompact(self):
+        # Updating an empty dict from a dict with deleted entries
+        # appends the items without lookups.
+        for keys in (range(1000), [str(i) for i in range(1000)]):
+            src = dict.fromkeys(keys, 1)
+            for k in list(src)[::3]:
+                del src[k]
+            for dst in ({}, dict.fromkeys(keys[:10])):
+                for k in list(dst):
+                    del dst[k]
+                dst.update(src)
+                self.assertEqual(dst, src)
+                self.assertEqual(list(dst), list(src))
+                self.assertIn(keys[1], dst)
+                self.assertNotIn(keys[0], dst)
+
+    @support.cpython_only
+    def test_presize_from_length_hint(self):
+        class Items:
+            def __init__(self, items, hint):
+                self.items = items
+                self.hint = hint
+            def __iter__(self):
+                return iter(self.items)
+            def __length_hint__(self):
+                return self.hint
+        items = [(i, i) for i in range(100)]
+        presized = sys.getsizeof(dict(items))
+        self.assertEqual(sys.getsizeof(dict(Items(items, 100))), presized)
+        # Wrong hints only cost memory or resizes.
+        for hint in (0, 10, 1000, sys.maxsize):
+            d = dict(Items(items, hint))
+            self.assertEqual(d, dict(items))
+        d = {}
+        d.update(Items(items, sys.maxsize))
+        self.assertEqual(d, dict(items))
+        class BadHint(Items):
+            def __length_hint__(self):
+                raise ZeroDivisionError
+        self.assertRaises(ZeroDivisionError, dict, BadHint(items, 0))
+
     def test_get(self):
         d = {}
         self.assertIs(d.get('c'), None)
@@ -994,8 +1052,9 @@ class C:
 
     @support.cpython_only
     def test_splittable_setdefault(self):
-        """split table must be combined when setdefault()
-        breaks insertion order"""
+        """split table keeps its own insertion order when setdefault()
+        inserts keys in a different order"""
+        import _testcapi
         a, b = self.make_shared_key_dict(2)
 
         a['a'] = 1
@@ -1005,42 +1064,55 @@ def test_splittable_setdefault(self):
         size_b = sys.getsizeof(b)
         b['a'] = 1
 
-        self.assertGreater(size_b, size_a)
+        self.assertEqual(size_b, size_a)
+        self.assertTrue(_testcapi.dict_hassplittable(b))
         self.assertEqual(list(a), ['x', 'y', 'z', 'a', 'b'])
         self.assertEqual(list(b), ['x', 'y', 'z', 'b', 'a'])
+        self.assertEqual(list(reversed(b)), ['a', 'b', 'z', 'y', 'x'])
+        self.assertEqual(list(b.values()), [1, 2, 3, 2, 1])
 
     @support.cpython_only
     def test_splittable_del(self):
-        """split table must be combined when del d[k]"""
+        """split table stays split when del d[k]"""
+        import _testcapi
         a, b = self.make_shared_key_dict(2)
 
         orig_size = sys.getsizeof(a)
 
-        del a['y']  # split table is combined
+        del a['y']
         with self.assertRaises(KeyError):
             del a['y']
 
-        self.assertGreater(sys.getsizeof(a), orig_size)
+        self.assertEqual(sys.getsizeof(a), orig_size)
+        self.assertTrue(_testcapi.dict_hassplittable(a))
         self.assertEqual(list(a), ['x', 'z'])
         self.assertEqual(list(b), ['x', 'y', 'z'])
 
         # Two dicts have different insertion order.
         a['y'] = 42
+        self.assertTrue(_testcapi.dict_hassplittable(a))
         self.assertEqual(list(a), ['x', 'z', 'y'])
         self.assertEqual(list(b), ['x', 'y', 'z'])
+        self.assertEqual(a, {'x': 1, 'y': 42, 'z': 3})
+        self.assertEqual(list(a.copy().items()),
+                         [('x', 1), ('z', 3), ('y', 42)])
+        self.assertEqual(list(dict(a).items()),
+                         [('x', 1), ('z', 3), ('y', 42)])
 
     @support.cpython_only
     def test_splittable_pop(self):
-        """split table must be combined when d.pop(k)"""
+        """split table stays split when d.pop(k)"""
+        import _testcapi
         a, b = self.make_shared_key_dict(2)
 
         orig_size = sys.getsizeof(a)
 
-        a.pop('y')  # split table is combined
+        self.assertEqual(a.pop('y'), 2)
         with self.assertRaises(KeyError):
             a.pop('y')
 
-        self.assertGreater(sys.getsizeof(a), orig_size)
+        self.assertEqual(sys.getsizeof(a), orig_size)
+        self.assertTrue(_testcapi.dict_hassplittable(a))
         self.assertEqual(list(a), ['x', 'z'])
         self.assertEqual(list(b), ['x', 'y', 'z'])
 
@@ -1060,24 +1132,32 @@ def test_splittable_pop_pending(self):
 
     @support.cpython_only
     def test_splittable_popitem(self):
-        """split table must be combined when d.popitem()"""
+        """split table stays split when d.popitem()"""
+        import _testcapi
         a, b = self.make_shared_key_dict(2)
 
         orig_size = sys.getsizeof(a)
 
-        item = a.popitem()  # split table is combined
+        item = a.popitem()
         self.assertEqual(item, ('z', 3))
         with self.assertRaises(KeyError):
             del a['z']
 
-        self.assertGreater(sys.getsizeof(a), orig_size)
+        self.assertEqual(sys.getsizeof(a), orig_size)
+        self.assertTrue(_testcapi.dict_hassplittable(a))
         self.assertEqual(list(a), ['x', 'y'])
         self.assertEqual(list(b), ['x', 'y', 'z'])
 
+        del a['x']
+        a['z'] = 4
+        self.assertEqual(a.popitem(), ('z', 4))
+        self.assertEqual(a.popitem(), ('y', 2))
+        with self.assertRaises(KeyError):
+            a.popitem()
+
     @support.cpython_only
-    def test_splittable_setattr_after_pop(self):
-        """setattr() must not convert combined table into split table."""
-        # Issue 28147
+    def test_splittable_setattr_after_del(self):
+        """Deleting attributes doesn't stop instances sharing keys."""
         import _testcapi
 
         class C:
@@ -1087,22 +1167,20 @@ class C:
         a.a = 1
         self.assertTrue(_testcapi.dict_hassplittable(a.__dict__))
 
-        # dict.pop() convert it to combined table
         a.__dict__.pop('a')
-        self.assertFalse(_testcapi.dict_hassplittable(a.__dict__))
-
-        # But C should not convert a.__dict__ to split table again.
+        self.assertTrue(_testcapi.dict_hassplittable(a.__dict__))
         a.a = 1
-        self.assertFalse(_testcapi.dict_hassplittable(a.__dict__))
+        self.assertTrue(_testcapi.dict_hassplittable(a.__dict__))
 
-        # Same for popitem()
         a = C()
-        a.a = 2
-        self.assertTrue(_testcapi.dict_hassplittable(a.__dict__))
-        a.__dict__.popitem()
-        self.assertFalse(_testcapi.dict_hassplittable(a.__dict__))
+        a.b = 2
         a.a = 3
-        self.assertFalse(_testcapi.dict_hassplittable(a.__dict__))
+        del a.b
+        self.assertTrue(_testcapi.dict_hassplittable(a.__dict__))
+        self.assertEqual(a.__dict__, {'a': 3})
+
+        b = C()
+        self.assertTrue(_testcapi.dict_hassplittable(b.__dict__))
 
     def test_iterator_pickling(self):
         for proto in range(pickle.HIGHEST_PROTOCOL + 1):
@@ -1572,6 +1650,221 @@ def make_pairs():
                 self.assertGreaterEqual(eq_count, 1)
 
 
+class FrozenDictSubclass(frozendict):
+    pass
+
+class FrozenDictTest(unittest.TestCase):
+
+    def test_constructor(self):
+        self.assertEqual(frozendict(), {})
+        self.assertEqual(frozendict({'a': 1}), {'a': 1})
+        self.assertEqual(frozendict([('a', 1), ('b', 2)]), {'a': 1, 'b': 2})
+        self.assertEqual(frozendict(a=1, b=2), {'a': 1, 'b': 2})
+        self.assertEqual(frozendict({'a': 1}, b=2), {'a': 1, 'b': 2})
+        self.assertEqual(frozendict([('a', 1), ('a', 2)]), {'a': 2})
+        self.assertRaises(TypeError, frozendict, 1)
+        self.assertRaises(TypeError, frozendict, {}, {})
+        self.assertRaises(ValueError, frozendict, [(1, 2, 3)])
+
+        fd = frozendict(a=1)
+        self.assertIs(frozendict(fd), fd)
+        self.assertIsNot(frozendict(fd, b=2), fd)
+        self.assertIs(fd.copy(), fd)
+
+    def test_immutable(self):
+        fd = frozendict(a=1)
+        with self.assertRaises(TypeError):
+            fd['a'] = 2
+        with self.assertRaises(TypeError):
+            del fd['a']
+        fd2 = fd
+        fd2 |= {'b': 2}
+        self.assertIsNot(fd2, fd)
+        for name in ('update', 'pop', 'popitem', 'setdefault', 'clear'):
+            self.assertFalse(hasattr(fd, name), name)
+        self.assertEqual(fd, {'a': 1})
+
+    def test_lookup(self):
+        for n in (1, 2, 3, 5, 8, 100, 1000, 20000):
+            for keys in (range(n),
+                         range(0, n << 16, 1 << 16),
+                         [str(i) for i in range(n)],
+                         [float(i) / 3 for i in range(n)],
+                         [(i, str(i)) for i in range(n)]):
+                d = {k: i for i, k in enumerate(keys)}
+                fd = frozendict(d)
+                self.assertEqual(len(fd), n)
+                for k, v in d.items():
+                    self.assertEqual(fd[k], v)
+                    self.assertIn(k, fd)
+                self.assertNotIn(-1, fd)
+                self.assertNotIn('x', fd)
+                self.assertIsNone(fd.get(n << 17))
+                with self.assertRaises(KeyError):
+                    fd[n << 17]
+                self.assertEqual(list(fd), list(d))
+                self.assertEqual(list(fd.items()), list(d.items()))
+
+    def test_lookup_equal_hashes(self):
+        class Key:
+            def __init__(self, value):
+                self.value = value
+            def __hash__(self):
+                return 42
+            def __eq__(self, other):
+                return isinstance(other, Key) and self.value == other.value
+        keys = [Key(i) for i in range(50)]
+        fd = frozendict.fromkeys(keys, 1)
+        for i in range(50):
+            self.assertEqual(fd[Key(i)], 1)
+        self.assertNotIn(Key(50), fd)
+        # -1 and -2 have the same hash
+        fd = frozendict({-1: 'a', -2: 'b'})
+        self.assertEqual(fd[-1], 'a')
+        self.assertEqual(fd[-2], 'b')
+
+    def test_lookup_error(self):
+        class Exc(Exception): pass
+        class BadEq:
+            def __eq__(self, other):
+                raise Exc
+            def __hash__(self):
+                return 7
+        k = BadEq()
+        fd = frozendict({k: 1})
+        self.assertEqual(fd[k], 1)
+        self.assertRaises(Exc, fd.__getitem__, BadEq())
+
+    def test_hash(self):
+        fd = frozendict(a=1, b=(2, 3))
+        self.assertEqual(hash(fd), hash(frozendict(b=(2, 3), a=1)))
+        self.assertNotEqual(hash(frozendict(a=1, b=2)),
+                            hash(frozendict(a=2, b=1)))
+        self.assertEqual(hash(frozendict()), hash(frozendict()))
+        self.assertEqual({fd: 1}[frozendict(b=(2, 3), a=1)], 1)
+        self.assertRaises(TypeError, hash, frozendict(a=[]))
+        # The hashes of items with small int keys and values don't collide
+        hashes = {hash(frozendict({i: j})) for i in range(50) for j in range(50)}
+        self.assertEqual(len(hashes), 2500)
+
+    def test_compare(self):
+        fd = frozendict(a=1, b=2)
+        self.assertEqual(fd, {'b': 2, 'a': 1})
+        self.assertEqual({'b': 2, 'a': 1}, fd)
+        self.assertEqual(fd, frozendict(b=2, a=1))
+        self.assertNotEqual(fd, frozendict(a=1))
+        self.assertNotEqual(fd, {'a': 1, 'b': 3})
+        self.assertRaises(TypeError, lambda: fd < fd)
+
+    def test_repr(self):
+        self.assertEqual(repr(frozendict()), 'frozendict()')
+        self.assertEqual(repr(frozendict(a=1)), "frozendict({'a': 1})")
+        class FD(frozendict):
+            pass
+        self.assertEqual(repr(FD(a=1)), "FD({'a': 1})")
+        lst = []
+        fd = frozendict(a=lst)
+        lst.append(fd)
+        self.assertEqual(repr(fd), "frozendict({'a': [frozendict({...})]})")
+
+    def test_repr_deep(self):
+        fd = frozendict()
+        for i in range(sys.getrecursionlimit() + 100):
+            fd = frozendict({1: fd})
+        self.assertRaises(RecursionError, repr, fd)
+
+    def test_dealloc_deep(self):
+        # The trashcan must bound the C recursion of frozendict_dealloc()
+        for cls in frozendict, FrozenDictSubclass:
+            with self.subTest(cls=cls):
+                fd = cls()
+                for i in range(200000):
+                    fd = cls(a=fd)
+                del fd
+
+    def test_or(self):
+        fd = frozendict(a=1, b=2)
+        self.assertEqual(fd | {'b': 3, 'c': 4}, {'a': 1, 'b': 3, 'c': 4})
+        self.assertIs(type(fd | {'c': 4}), frozendict)
+        self.assertIs(type(fd | frozendict(c=4)), frozendict)
+        self.assertIs(type({'c': 4} | fd), dict)
+        self.assertEqual({'a': 0, 'c': 4} | fd, {'a': 1, 'b': 2, 'c': 4})
+        self.assertRaises(TypeError, lambda: fd | [('c', 4)])
+
+    def test_fromkeys(self):
+        fd = frozendict.fromkeys('abc')
+        self.assertIs(type(fd), frozendict)
+        self.assertEqual(fd, dict.fromkeys('abc'))
+        self.assertEqual(frozendict.fromkeys(range(3), 0), {0: 0, 1: 0, 2: 0})
+        class FD(frozendict):
+            pass
+        self.assertIs(type(FD.fromkeys('abc')), FD)
+
+    def test_views(self):
+        fd = frozendict(a=1, b=2)
+        self.assertEqual(fd.keys(), {'a', 'b'})
+        self.assertEqual(list(fd.values()), [1, 2])
+        self.assertEqual(fd.items(), {('a', 1), ('b', 2)})
+        self.assertEqual(list(reversed(fd)), ['b', 'a'])
+        self.assertEqual(fd.keys().mapping, fd)
+
+    def test_subclass(self):
+        class FD(frozendict):
+            def __missing__(self, key):
+                return key * 2
+        fd = FD(a=1)
+        self.assertEqual(fd['a'], 1)
+        self.assertEqual(fd['b'], 'bb')
+        self.assertIsNot(frozendict(fd), fd)
+        copy = fd.copy()
+        self.assertIs(type(copy), frozendict)
+        self.assertEqual(copy, fd)
+
+    def test_abc(self):
+        fd = frozendict(a=1)
+        self.assertIsInstance(fd, collections.abc.Mapping)
+        self.assertIsInstance(fd, collections.abc.Hashable)
+        self.assertNotIsInstance(fd, collections.abc.MutableMapping)
+        self.assertNotIsInstance(fd, dict)
+        match fd:
+            case {'a': x}:
+                self.assertEqual(x, 1)
+            case _:
+                self.fail('mapping pattern did not match')
+
+    def test_pickle(self):
+        FD = FrozenDictSubclass
+        for proto in range(pickle.HIGHEST_PROTOCOL + 1):
+            fd = frozendict({'a': 1, 2: [3]})
+            fd2 = pickle.loads(pickle.dumps(fd, proto))
+            self.assertEqual(fd2, fd)
+            self.assertIs(type(fd2), frozendict)
+            fd = FD(a=1)
+            fd.attr = 'x'
+            fd2 = pickle.loads(pickle.dumps(fd, proto))
+            self.assertEqual(fd2, fd)
+            self.assertIs(type(fd2), FD)
+            self.assertEqual(fd2.attr, 'x')
+
+    def test_gc(self):
+        class Value:
+            pass
+        v = Value()
+        fd = frozendict(a=v)
+        v.fd = fd
+        ref = weakref.ref(v)
+        del v, fd
+        gc.collect()
+        self.assertIsNone(ref())
+
+    @support.cpython_only
+    def test_sizeof(self):
+        # The displacement table of the perfect hash adds one byte per slot
+        d = {str(i): i for i in range(100)}
+        self.assertGreaterEqual(sys.getsizeof(frozendict(d)),
+                                sys.getsizeof(d))
+
+
 class CAPITest(unittest.TestCase):
 
     # Test _PyDict_GetItem_KnownHash()
@@ -355,12 +355,15 @@ class InitConfigTests(EmbeddingTestsMixin, unittest.TestCase):
         'install_signal_handlers': 1,
         'use_hash_seed': 0,
         'hash_seed': 0,
+        'hash_algorithm': None,
         'faulthandler': 0,
         'tracemalloc': 0,
         'import_time': 0,
         'show_ref_count': 0,
+        'opcache_stats': 0,
         'dump_refs': 0,
         'malloc_stats': 0,
+        'hugepages': 0,
 
         'filesystem_encoding': GET_DEFAULT_CONFIG,
         'filesystem_errors': GET_DEFAULT_CONFIG,
@@ -785,6 +788,7 @@ def test_init_from_config(self):
             'install_signal_handlers': 0,
             'use_hash_seed': 1,
             'hash_seed': 123,
+            'hash_algorithm': 'siphash13',
             'tracemalloc': 2,
             'import_time': 1,
             'show_ref_count': 1,
@@ -845,6 +849,7 @@ def test_init_compat_env(self):
         config = {
             'use_hash_seed': 1,
             'hash_seed': 42,
+            'hash_algorithm': 'siphash13',
             'tracemalloc': 2,
             'import_time': 1,
             'malloc_stats': 1,
@@ -874,6 +879,7 @@ def test_init_python_env(self):
         config = {
             'use_hash_seed': 1,
             'hash_seed': 42,
+            'hash_algorithm': 'siphash13',
             'tracemalloc': 2,
             'import_time': 1,
             'malloc_stats': 1,
@@ -1407,6 +1413,17 @@ def test_init_set_config(self):
         self.check_all_configs("test_init_set_config", config,
                                api=API_ISOLATED)
 
+    def test_init_hash_algorithm_reinit(self):
+        # Like the hash secret, the algorithm is chosen once per process
+        env = dict(os.environ)
+        env.pop('PYTHONHASHALGORITHM', None)
+        out, err = self.run_embedded_interpreter(
+            "test_init_hash_algorithm_reinit", env=env)
+        self.assertEqual(out.splitlines(),
+                         ['fnv', 'fnv',
+                          'the hash algorithm cannot be changed '
+                          'after the first Python initialization'])
+
     def test_get_argc_argv(self):
         self.run_embedded_interpreter("test_get_argc_argv")
         # ignore output
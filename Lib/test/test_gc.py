@@ -29,6 +29,14 @@ def __new__(cls, *args, **kwargs):
 except ImportError:
     ContainerNoGC = None
 
+# Immortal objects need a 64-bit reference count
+requires_immortal = unittest.skipUnless(sys.maxsize > 2**32,
+                                        "immortal objects need 64 bits")
+
+# The phases of a collection timed by gc.get_stats()
+PHASES = {"update_refs", "subtract_refs", "move_unreachable", "finalize",
+          "delete_garbage"}
+
 ### Support code
 ###############################################################################
 
@@ -761,10 +769,15 @@ def test_get_stats(self):
         for st in stats:
             self.assertIsInstance(st, dict)
             self.assertEqual(set(st),
-                             {"collected", "collections", "uncollectable"})
+                             {"collected", "collections", "uncollectable",
+                              "pause_total", "pause_max", "pause_histogram",
+                              "phase_times"})
             self.assertGreaterEqual(st["collected"], 0)
             self.assertGreaterEqual(st["collections"], 0)
             self.assertGreaterEqual(st["uncollectable"], 0)
+            self.assertGreaterEqual(st["pause_total"], st["pause_max"])
+            self.assertGreaterEqual(st["pause_max"], 0)
+            self.assertEqual(set(st["phase_times"]), PHASES)
         # Check that collection counts are incremented correctly
         if gc.isenabled():
             self.addCleanup(gc.enable)
@@ -781,12 +794,100 @@ def test_get_stats(self):
         self.assertEqual(new[1]["collections"], old[1]["collections"])
         self.assertEqual(new[2]["collections"], old[2]["collections"] + 1)
 
+    def test_get_stats_pauses(self):
+        if gc.isenabled():
+            self.addCleanup(gc.enable)
+            gc.disable()
+        old = gc.get_stats()[2]
+        gc.collect()
+        new = gc.get_stats()[2]
+        # Each collection falls in exactly one bucket of the histogram
+        self.assertEqual(sum(new["pause_histogram"]), new["collections"])
+        self.assertEqual(sum(new["pause_histogram"]) -
+                         sum(old["pause_histogram"]), 1)
+        self.assertGreater(new["pause_total"], old["pause_total"])
+        # The phases are part of the pause
+        self.assertLessEqual(
+            sum(new["phase_times"].values()) - sum(old["phase_times"].values()),
+            new["pause_total"] - old["pause_total"])
+        for phase in PHASES:
+            self.assertGreaterEqual(new["phase_times"][phase],
+                                    old["phase_times"][phase])
+
     def test_freeze(self):
         gc.freeze()
         self.assertGreater(gc.get_freeze_count(), 0)
         gc.unfreeze()
         self.assertEqual(gc.get_freeze_count(), 0)
 
+    @cpython_only
+    @requires_immortal
+    def test_freeze_immortalize(self):
+        # Immortal objects outlive the test, use a separate process
+        code = textwrap.dedent('''
+            import gc, sys
+            class A:
+                pass
+            a = A()
+            a.name = "".join(["frozen"] * 10)
+            a.loop = a
+            gc.freeze(immortalize=True)
+            count = gc.get_freeze_count()
+            refcnt = sys.getrefcount(a)
+            name_refcnt = sys.getrefcount(a.name)
+            refs = [a, a.name] * 100
+            assert sys.getrefcount(a) == refcnt
+            assert sys.getrefcount(a.name) == name_refcnt
+            # Mortal objects are unfrozen, immortal ones stay frozen
+            gc.freeze()
+            gc.unfreeze()
+            assert gc.get_freeze_count() == count
+            assert gc.is_tracked(a)
+            del a, refs
+            gc.collect()
+        ''')
+        assert_python_ok("-c", code)
+
+    @cpython_only
+    @requires_immortal
+    def test_freeze_immortalize_deep(self):
+        # Untracked containers nested deeper than the C stack allows
+        code = textwrap.dedent('''
+            import gc, sys
+            # References from a frozen list keep the collector from
+            # reordering the tuples, so that a single collection untracks
+            # all of them, innermost first.
+            levels = []
+            gc.freeze()
+            t = ()
+            for i in range(10**6):
+                t = (t, i)
+                levels.append(t)
+            gc.collect()
+            levels.clear()
+            gc.unfreeze()
+            assert not gc.is_tracked(t)
+            root = [t]
+            gc.freeze(immortalize=True)
+            refcnt = sys.getrefcount(t[1])
+            refs = [t[1]] * 100
+            assert sys.getrefcount(t[1]) == refcnt
+            while t:
+                t = t[0]
+            refcnt = sys.getrefcount(t)
+            refs = [t] * 100
+            assert sys.getrefcount(t) == refcnt
+        ''')
+        assert_python_ok("-c", code)
+
+    @cpython_only
+    @unittest.skipIf(sys.maxsize > 2**32, "immortal objects are supported")
+    def test_freeze_immortalize_unsupported(self):
+        self.assertRaises(NotImplementedError, gc.freeze, immortalize=True)
+        self.assertGreater(gc.get_freeze_count(), 0)
+        gc.unfreeze()
+        self.assertEqual(gc.get_freeze_count(), 0)
+
     def test_get_objects(self):
         gc.collect()
         l = []
@@ -1117,6 +1218,11 @@ def test_collect(self):
             self.assertTrue("generation" in info)
             self.assertTrue("collected" in info)
             self.assertTrue("uncollectable" in info)
+            if v[1] == "stop":
+                self.assertGreaterEqual(info["pause"], 0)
+                self.assertEqual(set(info["phase_times"]), PHASES)
+                self.assertLessEqual(sum(info["phase_times"].values()),
+                                     info["pause"])
 
     def test_collect_generation(self):
         self.preclean()
@@ -1217,6 +1323,99 @@ def test_refcount_errors(self):
             br'object repr     : \[1, 2, 3\]')
 
 
+class IncrementalGCTests(unittest.TestCase):
+    def setUp(self):
+        self.addCleanup(gc.set_max_pause, gc.get_max_pause())
+        self.addCleanup(gc.set_threshold, *gc.get_threshold())
+        if not gc.isenabled():
+            gc.enable()
+            self.addCleanup(gc.disable)
+        gc.collect()
+        # Collect the oldest generation one small increment after each
+        # collection of the middle generation.
+        gc.set_threshold(100, 1, 1)
+        gc.set_max_pause(1)
+
+    def allocate_until(self, predicate):
+        # Create garbage cycles to trigger automatic collections
+        for i in range(20000):
+            if predicate():
+                return
+            for j in range(100):
+                l = []
+                l.append(l)
+        self.fail("automatic collections did not happen")
+
+    def test_max_pause(self):
+        gc.set_max_pause(100)
+        self.assertEqual(gc.get_max_pause(), 100)
+        gc.set_max_pause(0)
+        self.assertEqual(gc.get_max_pause(), 0)
+        self.assertRaises(ValueError, gc.set_max_pause, -1)
+        self.assertRaises(TypeError, gc.set_max_pause, 1.5)
+
+    def test_collect_old_cycles(self):
+        class A:
+            pass
+        # Enough objects for a round of incremental collection to start.
+        # Automatic collections are disabled meanwhile, so that the cycles
+        # are not examined by a round before they die.
+        n = len(gc.get_objects()) // 4 + 1000
+        refs = []
+        objs = []
+        gc.disable()
+        for i in range(n):
+            a = A()
+            a.b = A()
+            a.b.a = a
+            refs.append(weakref.ref(a))
+            objs.append(a)
+        # Move the cycles to the oldest generation before they die
+        gc.collect(1)
+        del objs, a
+        gc.enable()
+
+        collected = []
+        def callback(phase, info):
+            if (phase == "stop" and info["generation"] == 2
+                    and info["collected"]):
+                collected.append(info["collected"])
+        gc.callbacks.append(callback)
+        self.addCleanup(gc.callbacks.remove, callback)
+
+        # Cycles split between increments survive until a later round
+        self.allocate_until(
+            lambda: sum(r() is None for r in refs) >= n * 9 // 10)
+        self.assertGreater(len(collected), 1)
+        gc.collect()
+        self.assertTrue(all(r() is None for r in refs))
+
+    def test_frozen_objects(self):
+        class A:
+            pass
+        a = A()
+        a.a = a
+        wr = weakref.ref(a)
+        del a
+        frozen = A()
+        # Enough live objects for a round of incremental collection to start
+        n = len(gc.get_objects()) // 4 + 1000
+        gc.freeze()
+        self.addCleanup(gc.unfreeze)
+        freeze_count = gc.get_freeze_count()
+        objs = [[frozen] for i in range(n)]
+        gc.collect(1)
+
+        collections = gc.get_stats()[2]["collections"]
+        self.allocate_until(
+            lambda: gc.get_stats()[2]["collections"] > collections + 5)
+        self.assertIsNotNone(wr())
+        self.assertEqual(gc.get_freeze_count(), freeze_count)
+        gc.unfreeze()
+        gc.collect()
+        self.assertIsNone(wr())
+
+
 class GCTogglingTests(unittest.TestCase):
     def setUp(self):
         gc.enable()
@@ -1370,7 +1569,8 @@ def test_main():
 
     try:
         gc.collect() # Delete 2nd generation garbage
-        run_unittest(GCTests, GCTogglingTests, GCCallbackTests)
+        run_unittest(GCTests, GCTogglingTests, GCCallbackTests,
+                     IncrementalGCTests)
     finally:
         gc.set_debug(debug)
         # test gc.enable() even if GC is disabled by default
@@ -7,7 +7,7 @@
 import os
 import sys
 import unittest
-from test.support.script_helper import assert_python_ok
+from test.support.script_helper import assert_python_ok, assert_python_failure
 from collections.abc import Hashable
 
 IS_64BIT = sys.maxsize > 2**32
@@ -40,10 +40,12 @@ def pysiphash(uint64):
         int32 = uint32
     return int32, int64
 
+INTERNAL_HASH_ALGORITHMS = ("siphash13", "siphash24", "fnv")
+
 def skip_unless_internalhash(test):
-    """Skip decorator for tests that depend on SipHash24 or FNV"""
-    ok = sys.hash_info.algorithm in {"fnv", "siphash24"}
-    msg = "Requires SipHash24 or FNV"
+    """Skip decorator for tests that depend on SipHash13, SipHash24 or FNV"""
+    ok = sys.hash_info.algorithm in INTERNAL_HASH_ALGORITHMS
+    msg = "Requires SipHash13, SipHash24 or FNV"
     return test if ok else unittest.skip(msg)(test)
 
 
@@ -174,7 +176,7 @@ class HashRandomizationTests:
     def get_hash_command(self, repr_):
         return 'print(hash(eval(%a)))' % repr_
 
-    def get_hash(self, repr_, seed=None):
+    def get_hash(self, repr_, seed=None, algorithm=None):
         env = os.environ.copy()
         env['__cleanenv'] = True  # signal to assert_python not to do a copy
                                   # of os.environ on its own
@@ -182,6 +184,8 @@ def get_hash(self, repr_, seed=None):
             env['PYTHONHASHSEED'] = str(seed)
         else:
             env.pop('PYTHONHASHSEED', None)
+        if algorithm is not None:
+            env['PYTHONHASHALGORITHM'] = algorithm
         out = assert_python_ok(
             '-c', self.get_hash_command(repr_),
             **env)
@@ -219,6 +223,19 @@ class StringlikeHashRandomizationTests(HashRandomizationTests):
             # seed 42, 'äú∑ℇ'
             [-1677110816, -2947981342227738144, -1860207793, -4296699217652516017],
         ],
+        'siphash13': [
+            # NOTE: PyUCS2 layout depends on endianness
+            # seed 0, 'abc'
+            [69611762, -4594863902769663758, 69611762, -4594863902769663758],
+            # seed 42, 'abc'
+            [-975800855, 3869580338025362921, -975800855, 3869580338025362921],
+            # seed 42, 'abcdefghijk'
+            [-595844228, 7764564197781545852, -595844228, 7764564197781545852],
+            # seed 0, 'äú∑ℇ'
+            [-1093288643, -2810468059467891395, -1041341092, 4925090034378237276],
+            # seed 42, 'äú∑ℇ'
+            [-585999602, -2845126246016066802, -817336969, -2219421378907968137],
+        ],
         'fnv': [
             # seed 0, 'abc'
             [-1600925533, 1453079729188098211, -1600925533,
@@ -238,10 +255,10 @@ class StringlikeHashRandomizationTests(HashRandomizationTests):
         ]
     }
 
-    def get_expected_hash(self, position, length):
+    def get_expected_hash(self, position, length, algorithm=None):
         if length < sys.hash_info.cutoff:
             algorithm = "djba33x"
-        else:
+        elif algorithm is None:
             algorithm = sys.hash_info.algorithm
         if sys.byteorder == 'little':
             platform = 1 if IS_64BIT else 0
@@ -274,6 +291,19 @@ def test_long_fixed_hash(self):
         h = self.get_expected_hash(2, 11)
         self.assertEqual(self.get_hash(self.repr_long, seed=42), h)
 
+    @skip_unless_internalhash
+    def test_hash_algorithm(self):
+        # PYTHONHASHALGORITHM selects the algorithm at startup
+        for algorithm in INTERNAL_HASH_ALGORITHMS:
+            with self.subTest(algorithm=algorithm):
+                h = self.get_expected_hash(1, 3, algorithm)
+                self.assertEqual(self.get_hash(self.repr_, seed=42,
+                                               algorithm=algorithm), h)
+                if self.repr_long is not None:
+                    h = self.get_expected_hash(2, 11, algorithm)
+                    self.assertEqual(self.get_hash(self.repr_long, seed=42,
+                                                   algorithm=algorithm), h)
+
 
 class StrHashRandomizationTests(StringlikeHashRandomizationTests,
                                 unittest.TestCase):
@@ -324,6 +354,28 @@ class DatetimeTimeTests(DatetimeTests, unittest.TestCase):
     repr_ = repr(datetime.time(0))
 
 
+class HashAlgorithmTests(unittest.TestCase):
+
+    def test_hash_info(self):
+        code = 'import sys; print(sys.hash_info.algorithm)'
+        for algorithm in INTERNAL_HASH_ALGORITHMS:
+            with self.subTest(algorithm=algorithm):
+                out = assert_python_ok('-c', code,
+                                       PYTHONHASHALGORITHM=algorithm)[1]
+                self.assertEqual(out.strip().decode(), algorithm)
+
+    def test_ignore_environment(self):
+        code = 'import sys; print(sys.hash_info.algorithm)'
+        out = assert_python_ok('-E', '-c', code,
+                               PYTHONHASHALGORITHM='invalid')[1]
+        self.assertNotEqual(out.strip().decode(), 'invalid')
+
+    def test_invalid_algorithm(self):
+        rc, out, err = assert_python_failure('-c', 'pass',
+                                             PYTHONHASHALGORITHM='sha256')
+        self.assertIn(b'PYTHONHASHALGORITHM must be', err)
+
+
 class HashDistributionTestCase(unittest.TestCase):
 
     def test_hash_distribution(self):
@@ -1,7 +1,10 @@
 import unittest
 from test import support
+from test.support import import_helper
+from test.support.script_helper import assert_python_ok
 
 import sys
+import textwrap
 
 import random
 import math
@@ -12,6 +15,8 @@
 BASE = 2 ** SHIFT
 MASK = BASE - 1
 KARATSUBA_CUTOFF = 70   # from longobject.c
+TOOM3_CUTOFF = 300      # from longobject.c
+DIVISION_CUTOFF = 2500  # from longobject.c
 
 # Max number of base BASE digits to use in test cases.  Doubling
 # this will more than double the runtime.
@@ -177,6 +182,17 @@ def test_division(self):
                 y = self.getran(leny) or 1
                 self.check_division(x, y)
 
+        # divisions by the divisor's reciprocal
+        digits = [DIVISION_CUTOFF + 1, DIVISION_CUTOFF * 3 // 2]
+        for leny in digits:
+            y = self.getran(leny)
+            for lenx in (2 * leny + 1, 3 * leny - 1, 5 * leny // 2):
+                x = self.getran(lenx)
+                self.check_division(x, y)
+                self.check_division(y * (x // y), y)
+                self.check_division(y * (x // y) - 1, y)
+                self.check_division(y * (x // y) + y - 1, y)
+
         # specific numbers chosen to exercise corner cases of the
         # current long division implementation
 
@@ -229,6 +245,31 @@ def test_karatsuba(self):
                          1)
                     self.assertEqual(x, y)
 
+    def test_toom3(self):
+        digits = [TOOM3_CUTOFF // 2 + 1, TOOM3_CUTOFF, TOOM3_CUTOFF + 1,
+                  TOOM3_CUTOFF + 2, TOOM3_CUTOFF * 4 // 3 + 1,
+                  2 * TOOM3_CUTOFF, 2 * TOOM3_CUTOFF + 1, TOOM3_CUTOFF * 10]
+        for adigits in digits:
+            a = (1 << adigits * SHIFT) - 1
+            for bdigits in digits:
+                if bdigits < adigits:
+                    continue
+                with self.subTest(adigits=adigits, bdigits=bdigits):
+                    b = (1 << bdigits * SHIFT) - 1
+                    self.assertEqual(a * b,
+                                     (1 << (adigits + bdigits) * SHIFT) -
+                                     (1 << adigits * SHIFT) -
+                                     (1 << bdigits * SHIFT) + 1)
+                    # Check against products of halves of b, which take
+                    # different paths.
+                    x = self.getran(adigits)
+                    y = self.getran(bdigits)
+                    shift = bdigits // 2 * SHIFT
+                    yhi, ylo = y >> shift, y & ((1 << shift) - 1)
+                    self.assertEqual(x * y, ((x * yhi) << shift) + x * ylo)
+                    self.assertEqual(x * x, (-x) * (-x))
+                    self.assertEqual(x * x, x * (x + 0))
+
     def check_bitop_identities_1(self, x):
         eq = self.assertEqual
         with self.subTest(x=x):
@@ -321,6 +362,55 @@ def test_format(self):
                 x = self.getran(lenx)
                 self.check_format_1(x)
 
+    def test_huge_decimal_conversion(self):
+        # Conversions of numbers big enough for the divide-and-conquer
+        # algorithms, checked against conversions in short pieces.
+        def slow_str(x, width=1000):
+            pieces = []
+            sign, x = ('-', -x) if x < 0 else ('', x)
+            while x >= 10 ** width:
+                x, r = divmod(x, 10 ** width)
+                pieces.append(self.slow_format(r, 10).zfill(width))
+            pieces.append(self.slow_format(x, 10))
+            return sign + ''.join(reversed(pieces))
+
+        def slow_int(s, base=10, width=100):
+            x = 0
+            for i in range(0, len(s), width):
+                piece = s[i:i+width]
+                x = x * base ** len(piece) + int(piece, base)
+            return x
+
+        values = [10**100000, 10**100000 - 1, 10**100000 + 1,
+                  7 * 10**50000 * (10**50000 // 3), 2**400000 - 1]
+        for bits in 70000, 300000:
+            values.append(random.getrandbits(bits) | 1 << bits - 1)
+        for x in values:
+            for v in x, -x:
+                s = slow_str(v)
+                with self.subTest(digits=len(s), negative=v < 0):
+                    self.assertEqual(str(v), s)
+                    self.assertEqual(repr(v), s)
+                    self.assertEqual('{:d}'.format(v), s)
+                    self.assertEqual(int(s), v)
+                    self.assertEqual(int(s.encode()), v)
+
+        s = ''.join(random.choice('0123456789') for _ in range(50000))
+        self.assertEqual(int(s), slow_int(s))
+        self.assertEqual(int('0' * 30000 + s), slow_int(s))
+        self.assertEqual(int('-' + '0' * 30000 + '1'), -1)
+        self.assertEqual(int('  \t' + s + '\n '), slow_int(s))
+        self.assertEqual(int('_'.join(s[i:i+7] for i in range(0, len(s), 7))),
+                         slow_int(s))
+        self.assertEqual(int('0_' + '0' * 30000, 0), 0)
+        for base in 3, 7, 36:
+            t = ''.join(random.choice('0123456789abcdefghijklmnopqrstuvwxyz'
+                                      [:base]) for _ in range(30000))
+            self.assertEqual(int(t, base), slow_int(t, base))
+        self.assertRaises(ValueError, int, s + '_')
+        self.assertRaises(ValueError, int, s + 'a')
+        self.assertRaises(ValueError, int, '0' + s, 0)
+
     def test_long(self):
         # Check conversions from string
         LL = [
@@ -965,7 +1055,7 @@ def test_small_ints_in_huge_calculation(self):
         self.assertIs(c - a, 1)
 
     def test_small_ints(self):
-        for i in range(-5, 257):
+        for i in range(-5, 1025):
             self.assertIs(i, i + 0)
             self.assertIs(i, i * 1)
             self.assertIs(i, i - 0)
@@ -982,6 +1072,66 @@ def test_small_ints(self):
         self.assertIs(i - i, 0)
         self.assertIs(0 * i, 0)
 
+    @support.cpython_only
+    def test_freelist_reuse(self):
+        # A deallocated single-digit int is reused by the next one
+        x = int('20000')
+        addr = id(x)
+        del x
+        y = int('30000')
+        self.assertEqual(id(y), addr)
+
+    @support.cpython_only
+    def test_freelist_big_block(self):
+        # An int normalized down to one digit from a big block must free
+        # that block instead of keeping it alive on the free list
+        tracemalloc = import_helper.import_module('tracemalloc')
+        a = (1 << 200_000) | 20000
+        b = (1 << 200_001) | 0x7fff
+        tracemalloc.start()
+        try:
+            before = tracemalloc.get_traced_memory()[0]
+            L = [a & b for _ in range(100)]
+            del L
+            after = tracemalloc.get_traced_memory()[0]
+        finally:
+            tracemalloc.stop()
+        self.assertLess(after - before, 100_000)
+
+    @support.cpython_only
+    def test_freelist_clear(self):
+        # gc.collect() empties the free list
+        code = textwrap.dedent("""
+            import gc, sys
+            L = [int(str(i)) for i in range(2000, 2200)]
+            del L
+            sys._debugmallocstats()
+            gc.collect()
+            sys._debugmallocstats()
+        """)
+        rc, out, err = assert_python_ok('-c', code)
+        counts = [int(line.split()[0]) for line in err.decode().splitlines()
+                  if 'free PyLongObject' in line]
+        if not counts:
+            self.skipTest("no free list statistics")
+        self.assertEqual(len(counts), 2)
+        self.assertGreater(counts[0], 0)
+        self.assertEqual(counts[1], 0)
+
+    def test_digit_boundaries(self):
+        # Products of single-digit ints need up to two digits, and gcd()
+        # of ints with up to two digits doesn't use Lehmer's algorithm.
+        for x in (MASK, MASK - 1, BASE >> 1, (BASE >> 1) + 1):
+            for y in (MASK, 3, -MASK, -(BASE >> 1)):
+                self.assertEqual(x * y, sum(y << i for i in range(SHIFT)
+                                            if x >> i & 1))
+                self.assertEqual(x * y >> SHIFT, (x * y) // BASE)
+        self.assertEqual(math.gcd(MASK * MASK, MASK * 2), MASK)
+        self.assertEqual(math.gcd(-MASK << SHIFT, BASE * 2), BASE)
+        self.assertEqual(math.gcd(BASE * BASE - 1, BASE - 1), BASE - 1)
+        self.assertEqual((BASE * BASE - 1).bit_count(), 2 * SHIFT)
+        self.assertEqual((-MASK).bit_count(), SHIFT)
+
     def test_bit_length(self):
         tiny = 1e-10
         for x in range(-65000, 65000):
@@ -1,3 +1,4 @@
+import sys
 import unittest
 
 class TestLoadAttrCache(unittest.TestCase):
@@ -21,3 +22,144 @@ def f(o):
         Descriptor.__set__ = lambda *args: None
 
         self.assertEqual(f(o), 2)
+
+    def test_store_attr_descriptor_added_after_optimization(self):
+        class C:
+            pass
+
+        def f(o, v):
+            o.x = v
+
+        o = C()
+        for i in range(1025):
+            f(o, i)
+        self.assertEqual(o.x, 1024)
+
+        C.x = property(lambda self: 'prop', lambda self, v: None)
+        f(o, -1)
+        self.assertEqual(o.x, 'prop')
+        self.assertEqual(o.__dict__['x'], 1024)
+
+    def test_store_attr_slots(self):
+        class C:
+            __slots__ = ('x',)
+
+        def f(o, v):
+            o.x = v
+
+        o = C()
+        for i in range(1025):
+            f(o, i)
+        self.assertEqual(o.x, 1024)
+        del o.x
+        f(o, 'again')
+        self.assertEqual(o.x, 'again')
+
+
+class TestLoadMethodCache(unittest.TestCase):
+    def test_instance_attribute_shadows_method(self):
+        class C:
+            def m(self):
+                return 'method'
+
+        def f(o):
+            return o.m()
+
+        o = C()
+        for i in range(1025):
+            self.assertEqual(f(o), 'method')
+
+        o.m = lambda: 'instance'
+        self.assertEqual(f(o), 'instance')
+        self.assertEqual(f(C()), 'method')
+
+        C.m = lambda self: 'replaced'
+        self.assertEqual(f(C()), 'replaced')
+
+
+class TestSpecializedOpcodes(unittest.TestCase):
+    def test_binary_add_deoptimizes(self):
+        def f(a, b):
+            return a + b
+
+        for i in range(1025):
+            self.assertEqual(f(i, 1), i + 1)
+        self.assertEqual(f(1.5, 2.0), 3.5)
+        self.assertEqual(f('a', 'b'), 'ab')
+        self.assertEqual(f([1], [2]), [1, 2])
+        self.assertEqual(f(2**100, 1), 2**100 + 1)
+
+    def test_compare_op_deoptimizes(self):
+        def f(a, b):
+            return a < b, a == b
+
+        for i in range(1025):
+            self.assertEqual(f(0.5, 1.0), (True, False))
+        nan = float('nan')
+        self.assertEqual(f(nan, nan), (False, False))
+        self.assertEqual(f('a', 'b'), (True, False))
+        self.assertEqual(f(1, 1.0), (False, True))
+
+    def test_call_builtin(self):
+        def f(x):
+            return len(x), isinstance(x, list)
+
+        for i in range(1025):
+            self.assertEqual(f([i]), (1, True))
+        self.assertRaises(TypeError, f, 1)
+        self.assertEqual(f('ab'), (2, False))
+
+
+class TestOpcacheStats(unittest.TestCase):
+    def setUp(self):
+        enabled = sys._opcache_stats()['enabled']
+        self.addCleanup(sys._set_opcache_stats, enabled)
+        sys._set_opcache_stats(True)
+
+    def test_per_opcode_and_per_code_stats(self):
+        def f(a, b):
+            return a + b
+
+        before = sys._opcache_stats()['opcodes']['BINARY_ADD']
+        for i in range(1100):
+            f(i, 1)
+        f('a', 'b')
+        after = sys._opcache_stats()['opcodes']['BINARY_ADD']
+        self.assertGreater(after['hits'], before['hits'])
+        self.assertGreater(after['misses'], before['misses'])
+
+        stats = sys._opcache_stats(f.__code__)
+        self.assertEqual(stats['opts'], 1)
+        self.assertEqual(stats['misses'], 1)
+        self.assertEqual(stats['deopts'], 0)
+        self.assertGreater(stats['hits'], 0)
+
+    def test_globals_and_attributes_have_priority(self):
+        # Only 255 sites of a code object get a cache: the LOAD_GLOBAL and
+        # LOAD_ATTR sites must not be starved by the other cached opcodes.
+        adds = ''.join(f'    x = a + {i}\n' for i in range(300))
+        ns = {}
+        exec(f'def f(a):\n{adds}    return len\n', ns)
+        f = ns['f']
+        loop = [None] * 1100
+
+        before = sys._opcache_stats()['opcodes']['LOAD_GLOBAL']
+        for _ in loop:
+            f(1)
+        after = sys._opcache_stats()['opcodes']['LOAD_GLOBAL']
+        self.assertGreater(after['hits'], before['hits'])
+        self.assertEqual(sys._opcache_stats(f.__code__)['opts'], 255)
+
+    def test_disabled(self):
+        def f(a, b):
+            return a + b
+
+        sys._set_opcache_stats(False)
+        for i in range(1100):
+            f(i, 1)
+        self.assertIsNone(sys._opcache_stats(f.__code__))
+        self.assertRaises(TypeError, sys._opcache_stats, f)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -144,6 +144,22 @@ def test_negative_exponent(self):
                         with self.assertRaises(ValueError):
                             pow(a, -1001, m)
 
+    def test_huge_modulus(self):
+        # Moduli big enough for reductions to use their reciprocal.
+        m = (1 << 100003) - 12345
+        for a in (3, m - 2, m + 5, -7, (m << 3) + 1):
+            with self.subTest(a=a):
+                r = 1
+                for i in range(25):
+                    r = r * a % m
+                self.assertEqual(pow(a, 25, m), r)
+                r = a % m
+                for i in range(10):
+                    r = r * r % m
+                self.assertEqual(pow(a, 1 << 10, m), r)
+                self.assertEqual(pow(a, 25, -m), pow(a, 25, m) - m)
+        self.assertEqual(pow(3, -1, m) * 3 % m, 1)
+
 
 if __name__ == "__main__":
     unittest.main()
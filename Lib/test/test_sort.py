@@ -1,4 +1,5 @@
 from test import support
+from test.support import import_helper
 import random
 import unittest
 from functools import cmp_to_key
@@ -378,6 +379,133 @@ def test_not_all_tuples(self):
         self.assertRaises(TypeError, [(1.0, 1.0), (False, "A"), 6].sort)
         self.assertRaises(TypeError, [('a', 1), (1, 'a')].sort)
         self.assertRaises(TypeError, [(1, 'a'), ('a', 1)].sort)
+
+class TestRadixSort(unittest.TestCase):
+    # Large lists of small ints or floats are sorted by a radix sort, which
+    # must agree exactly with the comparison sort.
+    n = 2000
+
+    def check(self, L, **kwargs):
+        reference = sorted(L, key=cmp_to_key(lambda a, b: (a > b) - (a < b)),
+                           **kwargs)
+        for result in (sorted(L, **kwargs),
+                       sorted(L, key=lambda x: x, **kwargs)):
+            self.assertEqual(len(result), len(reference))
+            for x, y in zip(result, reference):
+                self.assertIs(x, y)
+
+    def test_ints(self):
+        n = self.n
+        M = (1 << 30) - 1
+        for L in ([random.randrange(-M, M + 1) for i in range(n)],
+                  [random.randrange(100) for i in range(n)],
+                  [random.choice([-M, 0, M]) for i in range(n)],
+                  [random.randrange(-3, 3) for i in range(n)]):
+            self.check(L)
+            self.check(L, reverse=True)
+
+    def test_floats(self):
+        n = self.n
+        specials = [0.0, -0.0, 1.5, -1.5, 5e-324, -5e-324,
+                    float('inf'), float('-inf'), 1e308, -1e308]
+        for L in ([random.uniform(-1e300, 1e300) for i in range(n)],
+                  [random.choice(specials) for i in range(n)],
+                  [float(random.randrange(10)) for i in range(n)]):
+            self.check(L)
+            self.check(L, reverse=True)
+        # a NaN makes the list unsortable by radix
+        L = [random.random() for i in range(n)] + [float('nan')]
+        random.shuffle(L)
+        self.assertEqual(len(sorted(L)), n + 1)
+
+    @support.cpython_only
+    def test_scratch_memory_error(self):
+        # If the radix sort cannot allocate its scratch space, timsort sorts
+        # the list instead of raising MemoryError.
+        _testcapi = import_helper.import_module('_testcapi')
+        L = [random.randrange(1000) for i in range(self.n)]
+        expected = sorted(L)
+        _testcapi.set_nomemory(0, 1)
+        try:
+            L.sort()
+        finally:
+            _testcapi.remove_mem_hooks()
+        self.assertEqual(L, expected)
+
+    def test_stability(self):
+        L = [(random.randrange(50), i) for i in range(self.n)]
+        self.assertEqual(sorted(L, key=lambda t: t[0]), sorted(L))
+        self.assertEqual(sorted(L, key=lambda t: t[0], reverse=True),
+                         sorted(L, key=lambda t: (-t[0], t[1])))
+        L = [(random.choice([0.0, -0.0]), i) for i in range(self.n)]
+        self.assertEqual(sorted(L, key=lambda t: t[0]), L)
+
+class TestParallelSort(unittest.TestCase):
+    # Large enough to be cut into several chunks; the result must not depend
+    # on their number.
+    n = 200_003
+
+    def setUp(self):
+        # Use several threads even on a single CPU
+        self.set_threads(4)
+
+    def set_threads(self, nthreads):
+        try:
+            from _testinternalcapi import set_sort_threads
+        except ImportError:
+            return
+        old = set_sort_threads(nthreads)
+        self.addCleanup(set_sort_threads, old)
+
+    def check(self, L, **kwargs):
+        expected = sorted(L, **kwargs)
+        L = L[:]
+        L.sort(parallel=True, **kwargs)
+        self.assertEqual(L, expected)
+
+    def test_homogeneous(self):
+        n = self.n
+        for L in ([random.randrange(-1000, 1000) for i in range(n)],
+                  [random.random() for i in range(n)],
+                  [str(random.randrange(n)) for i in range(n)],
+                  list(range(n)),
+                  list(range(n, 0, -1))):
+            with self.subTest(type=type(L[0])):
+                self.check(L)
+                self.check(L, reverse=True)
+                self.check(L, key=lambda x: x)
+
+    def test_stability(self):
+        L = [(random.randrange(100), i) for i in range(self.n)]
+        for reverse in False, True:
+            result = sorted(L, key=lambda t: t[0], reverse=reverse,
+                            parallel=True)
+            self.assertEqual(result,
+                             sorted(L, key=lambda t: t[0], reverse=reverse))
+            # Equal keys keep their original order
+            for (k1, i1), (k2, i2) in zip(result, result[1:]):
+                if k1 == k2:
+                    self.assertLess(i1, i2)
+
+    def test_fallback(self):
+        # Keys whose comparisons call back into Python are sorted serially
+        n = self.n
+        self.check([random.randrange(1 << 70) for i in range(n)])
+        self.check([(random.randrange(10), i) for i in range(n)])
+        L = [random.randrange(10) for i in range(n)] + ['x']
+        self.assertRaises(TypeError, L.sort, parallel=True)
+
+    @support.cpython_only
+    def test_thread_counts(self):
+        # Odd numbers of runs leave the last one out of a merge round
+        import_helper.import_module('_testinternalcapi')
+        L = [random.randrange(-1000, 1000) for i in range(self.n)]
+        for nthreads in 1, 2, 3, 5, 6, 8:
+            with self.subTest(nthreads=nthreads):
+                self.set_threads(nthreads)
+                self.check(L)
+                self.check(L, reverse=True)
+                self.check(L, key=lambda x: -x)
 #==============================================================================
 
 if __name__ == "__main__":
@@ -1,6 +1,10 @@
 """Unit tests for zero-argument super() & related machinery."""
 
+import gc
+import sys
+import threading
 import unittest
+from test.support import threading_helper
 
 
 class A:
@@ -317,6 +321,50 @@ def test_super_init_leaks(self):
         for i in range(1000):
             super.__init__(sp, int, i)
 
+    @threading_helper.reap_threads
+    def test_super_in_inlined_calls_with_thread_switches(self):
+        # Python-to-Python calls are run in the frame loop of their caller:
+        # super() must see the frame of the callee, whatever ran in between.
+        class Base:
+            def f(self, x):
+                return x
+            def __del__(self):
+                pass
+
+        class Derived(Base):
+            def f(self, x):
+                return super().f(x) + 1
+            def g(self, x):
+                return self.f(x) + sum([self.f(i) for i in range(2)])
+            def __del__(self):
+                super().__del__()
+                # finalizers run by the GC in the middle of inlined calls
+                self.f(0)
+
+        def work(results):
+            total = 0
+            for i in range(1000):
+                obj = Derived()
+                obj.cycle = obj
+                total += obj.g(i)
+            results.append(total)
+
+        expected = sum(i + 1 + 3 for i in range(1000))
+        results = []
+        old_interval = sys.getswitchinterval()
+        old_threshold = gc.get_threshold()
+        sys.setswitchinterval(1e-6)
+        gc.set_threshold(10)
+        try:
+            threads = [threading.Thread(target=work, args=(results,))
+                       for _ in range(4)]
+            with threading_helper.start_threads(threads):
+                work(results)
+        finally:
+            sys.setswitchinterval(old_interval)
+            gc.set_threshold(*old_threshold)
+        self.assertEqual(results, [expected] * 5)
+
 
 if __name__ == "__main__":
     unittest.main()
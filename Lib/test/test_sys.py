@@ -506,16 +506,25 @@ def test_attributes(self):
         self.assertIsInstance(sys.hash_info.nan, int)
         self.assertIsInstance(sys.hash_info.imag, int)
         algo = sysconfig.get_config_var("Py_HASH_ALGORITHM")
-        if sys.hash_info.algorithm in {"fnv", "siphash24"}:
+        if sys.hash_info.algorithm in {"fnv", "siphash13", "siphash24"}:
             self.assertIn(sys.hash_info.hash_bits, {32, 64})
             self.assertIn(sys.hash_info.seed_bits, {32, 64, 128})
 
-            if algo == 1:
+            if sys.flags.ignore_environment:
+                env_algo = None
+            else:
+                env_algo = os.environ.get("PYTHONHASHALGORITHM")
+            if env_algo:
+                self.assertEqual(sys.hash_info.algorithm, env_algo)
+            elif algo == 1:
                 self.assertEqual(sys.hash_info.algorithm, "siphash24")
             elif algo == 2:
                 self.assertEqual(sys.hash_info.algorithm, "fnv")
+            elif algo == 3:
+                self.assertEqual(sys.hash_info.algorithm, "siphash13")
             else:
-                self.assertIn(sys.hash_info.algorithm, {"fnv", "siphash24"})
+                self.assertIn(sys.hash_info.algorithm,
+                              {"fnv", "siphash13", "siphash24"})
         else:
             # PY_HASH_EXTERNAL
             self.assertEqual(algo, 0)
@@ -867,6 +876,120 @@ def test_getallocatedblocks(self):
         c = sys.getallocatedblocks()
         self.assertIn(c, range(b - 50, b + 50))
 
+    @threading_helper.reap_threads
+    def test_getallocatedblocks_thread_cache(self):
+        # The free blocks kept by the other threads are not counted
+        import threading
+        ready = threading.Event()
+        done = threading.Event()
+        def fill_cache():
+            blocks = [bytes(size) for size in range(1, 256) for i in range(64)]
+            del blocks
+            ready.set()
+            done.wait()
+        thread = threading.Thread(target=fill_cache)
+        with threading_helper.start_threads([thread]):
+            ready.wait()
+            a = sys.getallocatedblocks()
+            done.set()
+        b = sys.getallocatedblocks()
+        self.assertIn(a, range(b - 50, b + 50))
+
+    @test.support.cpython_only
+    def test_block_cache_reuse(self):
+        # the block freed last by the thread is allocated again first
+        x = object()
+        addr = id(x)
+        del x
+        y = object()
+        self.assertEqual(id(y), addr)
+
+    @test.support.cpython_only
+    @threading_helper.reap_threads
+    def test_block_cache_thread_exit(self):
+        # The blocks cached by a thread are freed when it exits, and are
+        # then reused by the other threads
+        import threading
+        freed = []
+        def fill_cache():
+            blocks = [bytes(size) for size in range(1, 256) for i in range(64)]
+            del blocks
+            blocks = [object() for i in range(32)]
+            freed.extend(map(id, blocks))
+            del blocks
+        thread = threading.Thread(target=fill_cache)
+        a = sys.getallocatedblocks()
+        thread.start()
+        thread.join()
+        b = sys.getallocatedblocks()
+        # the ids kept in 'freed' are allocated
+        self.assertIn(b, range(a - 50, a + 100))
+        blocks = [object() for i in range(32)]
+        self.assertTrue(set(freed) & set(map(id, blocks)))
+
+    @test.support.cpython_only
+    def test_block_cache_arenas_released(self):
+        # The blocks cached by a thread which waits without the GIL don't
+        # keep their arenas alive.
+        code = textwrap.dedent('''
+            import sys, threading
+            ready = threading.Event()
+            done = threading.Event()
+            def fill_cache():
+                data = [bytes(8) for i in range(500_000)]
+                # the last blocks freed, one in each of 25 arenas, are cached
+                keep = data[::20_000]
+                del data, keep
+                ready.set()
+                done.wait()
+            print('before', file=sys.stderr, flush=True)
+            sys._debugmallocstats()
+            thread = threading.Thread(target=fill_cache)
+            thread.start()
+            ready.wait()
+            print('after', file=sys.stderr, flush=True)
+            sys._debugmallocstats()
+            done.set()
+            thread.join()
+        ''')
+        ret, out, err = assert_python_ok('-c', code)
+        arenas = [int(line.split(b'=')[1])
+                  for line in err.splitlines()
+                  if line.startswith(b'# arenas allocated current')]
+        if not arenas:
+            self.skipTest('requires pymalloc')
+        before, after = arenas
+        self.assertLessEqual(after, before + 5)
+
+    @test.support.cpython_only
+    def test_trim_memory(self):
+        try:
+            import _testcapi
+            alloc_name = _testcapi.pymem_getallocatorsname()
+        except (ImportError, RuntimeError):
+            alloc_name = None
+
+        n = sys._trim_memory()
+        self.assertIsInstance(n, int)
+        self.assertGreaterEqual(n, 0)
+
+        # free most of the pools of the arenas used by the lists,
+        # keeping the arenas alive
+        data = [[] for _ in range(200_000)]
+        data = data[::2000]
+        n = sys._trim_memory()
+        self.assertGreaterEqual(n, 0)
+        # Only pools larger than a page, as on 64-bit platforms, have pages
+        # to release: their first page holds the pool header.
+        if alloc_name in ('pymalloc', 'pymalloc_debug') and sys.maxsize > 2**32:
+            self.assertGreater(n, 0)
+        # trimmed pools are not released twice
+        self.assertEqual(sys._trim_memory(), 0)
+        # the trimmed pools can be used again
+        more = [[] for _ in range(200_000)]
+        self.assertEqual(more[-1], [])
+        del data, more
+
     def test_is_finalizing(self):
         self.assertIs(sys.is_finalizing(), False)
         # Don't use the atexit module because _Py_Finalizing is only set
@@ -1229,7 +1352,10 @@ def inner():
         # empty dict
         check({}, size('nQ2P'))
         # dict
-        check({"a": 1}, size('nQ2P') + calcsize('2nP2n') + 8 + (8*2//3)*calcsize('n2P'))
+        check({"a": 1}, size('nQ2P') + calcsize('2nP2n') + 4 + (4*2//3)*calcsize('n2P'))
+        d = {"a": 1}
+        d["b"] = d["c"] = 2
+        check(d, size('nQ2P') + calcsize('2nP2n') + 8 + (8*2//3)*calcsize('n2P'))
         longdict = {1:1, 2:2, 3:3, 4:4, 5:5, 6:6, 7:7, 8:8}
         check(longdict, size('nQ2P') + calcsize('2nP2n') + 16 + (16*2//3)*calcsize('n2P'))
         # dictionary-keyview
@@ -1391,13 +1517,13 @@ class newstyleclass(object): pass
         # Separate block for PyDictKeysObject with 8 keys and 5 entries
         check(newstyleclass, s + calcsize("2nP2n0P") + 8 + 5*calcsize("n2P"))
         # dict with shared keys
-        check(newstyleclass().__dict__, size('nQ2P') + 5*self.P)
+        check(newstyleclass().__dict__, size('nQ2P') + 5*(self.P + 1))
         o = newstyleclass()
         o.a = o.b = o.c = o.d = o.e = o.f = o.g = o.h = 1
         # Separate block for PyDictKeysObject with 16 keys and 10 entries
         check(newstyleclass, s + calcsize("2nP2n0P") + 16 + 10*calcsize("n2P"))
         # dict with shared keys
-        check(newstyleclass().__dict__, size('nQ2P') + 10*self.P)
+        check(newstyleclass().__dict__, size('nQ2P') + 10*(self.P + 1))
         # unicode
         # each tuple contains a string and its expected character size
         # don't put any static strings here, as they may contain
@@ -236,6 +236,18 @@ def test_find(self):
         self.checkequal(-1, 'a' * 100, 'find', 'a\u0102')
         self.checkequal(-1, 'a' * 100, 'find', 'a\U00100304')
         self.checkequal(-1, '\u0102' * 100, 'find', '\u0102\U00100304')
+        # test implementation details of the vectorized search: characters
+        # sharing some of their bytes must not match
+        for m in range(2, 12):
+            for k in range(40):
+                for fill, p in (('\u0201', '\u0102' * m),
+                                ('\U00010201', '\U00010102' * m),
+                                ('\U00020101', '\U00010101' * m)):
+                    text = fill * k + p + fill * (40 - k)
+                    self.checkequal(k, text, 'find', p)
+                    self.checkequal(1, text, 'count', p)
+                    self.checkequal(-1, fill * 60, 'find', p)
+                    self.checkequal(0, fill * 60, 'count', p[0])
 
     def test_rfind(self):
         string_tests.CommonTest.test_rfind(self)
@@ -401,6 +413,14 @@ def test_split(self):
                                 left + right, 'split', delim * 2)
                 self.checkequal([left, right],
                                 left + delim * 2 + right, 'split', delim *2)
+        # non-ASCII whitespace and line breaks in long Latin-1 strings
+        word = '\xe9' * 20
+        for ws in '\x85', '\xa0', '\x1c':
+            self.checkequal([word] * 3, ws.join([word] * 3), 'split')
+        for lb in '\x85', '\x1c', '\x0c':
+            self.checkequal([word] * 3, lb.join([word] * 3), 'splitlines')
+        self.checkequal([word + '\xa0' + word],
+                        word + '\xa0' + word, 'splitlines')
 
     def test_rsplit(self):
         string_tests.CommonTest.test_rsplit(self)
@@ -2142,8 +2142,12 @@ dec_from_long(PyTypeObject *type, const PyObject *v,
         sign = MPD_POS;
     }
 
+#if PYLONG_BITS_IN_DIGIT == 60
+    if (len == 1 && *l->ob_digit <= UINT32_MAX) {
+#else
     if (len == 1) {
-        _dec_settriple(dec, sign, *l->ob_digit, 0);
+#endif
+        _dec_settriple(dec, sign, (uint32_t)*l->ob_digit, 0);
         mpd_qfinalize(MPD(dec), ctx, status);
         return dec;
     }
@@ -2154,8 +2158,33 @@ dec_from_long(PyTypeObject *type, const PyObject *v,
 #elif PYLONG_BITS_IN_DIGIT == 15
     mpd_qimport_u16(MPD(dec), l->ob_digit, len, sign, PyLong_BASE,
                     ctx, status);
+#elif PYLONG_BITS_IN_DIGIT == 60
+    {
+        /* libmpdec has no import for 64-bit words: split every digit into
+           two base 2**30 words. */
+        uint32_t *words;
+        size_t i, n;
+
+        words = PyMem_New(uint32_t, 2 * len);
+        if (words == NULL) {
+            Py_DECREF(dec);
+            PyErr_NoMemory();
+            return NULL;
+        }
+        for (i = 0; i < len; i++) {
+            words[2*i] = (uint32_t)(l->ob_digit[i] & 0x3fffffff);
+            words[2*i+1] = (uint32_t)(l->ob_digit[i] >> 30);
+        }
+        n = 2 * len;
+        if (words[n-1] == 0) {
+            n--;
+        }
+        mpd_qimport_u32(MPD(dec), words, n, sign, (uint32_t)1 << 30,
+                        ctx, status);
+        PyMem_Free(words);
+    }
 #else
-  #error "PYLONG_BITS_IN_DIGIT should be 15 or 30"
+  #error "PYLONG_BITS_IN_DIGIT should be 15, 30 or 60"
 #endif
 
     return dec;
@@ -3385,8 +3414,31 @@ dec_as_long(PyObject *dec, PyObject *context, int round)
     n = mpd_qexport_u32(&ob_digit, 0, PyLong_BASE, x, &status);
 #elif PYLONG_BITS_IN_DIGIT == 15
     n = mpd_qexport_u16(&ob_digit, 0, PyLong_BASE, x, &status);
+#elif PYLONG_BITS_IN_DIGIT == 60
+    {
+        /* Export base 2**30 words and join them in pairs. */
+        uint32_t *words = NULL;
+
+        n = mpd_qexport_u32(&words, 0, (uint32_t)1 << 30, x, &status);
+        if (n != SIZE_MAX) {
+            ob_digit = mpd_alloc((mpd_size_t)(n + 1) / 2, sizeof *ob_digit);
+            if (ob_digit != NULL) {
+                for (i = 0; (size_t)i < n; i += 2) {
+                    ob_digit[i/2] = words[i];
+                    if ((size_t)i + 1 < n) {
+                        ob_digit[i/2] |= (digit)words[i+1] << 30;
+                    }
+                }
+                n = (n + 1) / 2;
+            }
+            else {
+                n = SIZE_MAX;
+            }
+            mpd_free(words);
+        }
+    }
 #else
-    #error "PYLONG_BITS_IN_DIGIT should be 15 or 30"
+    #error "PYLONG_BITS_IN_DIGIT should be 15, 30 or 60"
 #endif
 
     if (n == SIZE_MAX) {
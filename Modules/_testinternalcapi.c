@@ -18,6 +18,7 @@
 #include "pycore_hashtable.h"    // _Py_hashtable_new()
 #include "pycore_initconfig.h"   // _Py_GetConfigsAsDict()
 #include "pycore_interp.h"       // _PyInterpreterState_GetConfigCopy()
+#include "pycore_list.h"         // _PyList_SetSortThreads()
 #include "pycore_pyerrors.h"      // _Py_UTF8_Edit_Cost()
 
 
@@ -365,6 +366,23 @@ test_edit_cost(PyObject *self, PyObject *Py_UNUSED(args))
 }
 
 
+static PyObject *
+set_sort_threads(PyObject *self, PyObject *arg)
+{
+    int nthreads = _PyLong_AsInt(arg);
+    if (nthreads == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (nthreads < 0 || nthreads > _PyList_SORT_MAX_THREADS) {
+        PyErr_Format(PyExc_ValueError,
+                     "the number of threads must be in range 0..%d",
+                     _PyList_SORT_MAX_THREADS);
+        return NULL;
+    }
+    return PyLong_FromLong(_PyList_SetSortThreads(nthreads));
+}
+
+
 static PyMethodDef TestMethods[] = {
     {"get_configs", get_configs, METH_NOARGS},
     {"get_recursion_depth", get_recursion_depth, METH_NOARGS},
@@ -376,6 +394,7 @@ static PyMethodDef TestMethods[] = {
     {"set_config", test_set_config, METH_O},
     {"test_atomic_funcs", test_atomic_funcs, METH_NOARGS},
     {"test_edit_cost", test_edit_cost, METH_NOARGS},
+    {"set_sort_threads", set_sort_threads, METH_O},
     {NULL, NULL} /* sentinel */
 };
 
@@ -202,6 +202,74 @@ gc_get_threshold(PyObject *module, PyObject *Py_UNUSED(ignored))
     return gc_get_threshold_impl(module);
 }
 
+PyDoc_STRVAR(gc_set_max_pause__doc__,
+"set_max_pause($module, microseconds, /)\n"
+"--\n"
+"\n"
+"Set the pause target of the collection of the oldest generation.\n"
+"\n"
+"If non-zero, automatic collections of the oldest generation are split into\n"
+"increments, each aiming at pausing the program for at most that many\n"
+"microseconds.  Zero disables incremental collection.");
+
+#define GC_SET_MAX_PAUSE_METHODDEF    \
+    {"set_max_pause", (PyCFunction)gc_set_max_pause, METH_O, gc_set_max_pause__doc__},
+
+static PyObject *
+gc_set_max_pause_impl(PyObject *module, Py_ssize_t microseconds);
+
+static PyObject *
+gc_set_max_pause(PyObject *module, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    Py_ssize_t microseconds;
+
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(arg);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        microseconds = ival;
+    }
+    return_value = gc_set_max_pause_impl(module, microseconds);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_get_max_pause__doc__,
+"get_max_pause($module, /)\n"
+"--\n"
+"\n"
+"Return the pause target of the collection of the oldest generation.");
+
+#define GC_GET_MAX_PAUSE_METHODDEF    \
+    {"get_max_pause", (PyCFunction)gc_get_max_pause, METH_NOARGS, gc_get_max_pause__doc__},
+
+static Py_ssize_t
+gc_get_max_pause_impl(PyObject *module);
+
+static PyObject *
+gc_get_max_pause(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    Py_ssize_t _return_value;
+
+    _return_value = gc_get_max_pause_impl(module);
+    if ((_return_value == -1) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyLong_FromSsize_t(_return_value);
+
+exit:
+    return return_value;
+}
+
 PyDoc_STRVAR(gc_get_count__doc__,
 "get_count($module, /)\n"
 "--\n"
@@ -304,25 +372,52 @@ PyDoc_STRVAR(gc_is_finalized__doc__,
     {"is_finalized", (PyCFunction)gc_is_finalized, METH_O, gc_is_finalized__doc__},
 
 PyDoc_STRVAR(gc_freeze__doc__,
-"freeze($module, /)\n"
+"freeze($module, /, *, immortalize=False)\n"
 "--\n"
 "\n"
 "Freeze all current tracked objects and ignore them for future collections.\n"
 "\n"
 "This can be used before a POSIX fork() call to make the gc copy-on-write friendly.\n"
 "Note: collection before a POSIX fork() call may free pages for future allocation\n"
-"which can cause copy-on-write.");
+"which can cause copy-on-write.\n"
+"\n"
+"If immortalize is true, the frozen objects and the objects they refer to are\n"
+"also made immortal: their reference count is no longer updated, and they are\n"
+"never deallocated, even after unfreeze().  Immortal objects are not supported\n"
+"on 32-bit platforms.");
 
 #define GC_FREEZE_METHODDEF    \
-    {"freeze", (PyCFunction)gc_freeze, METH_NOARGS, gc_freeze__doc__},
+    {"freeze", (PyCFunction)(void(*)(void))gc_freeze, METH_FASTCALL|METH_KEYWORDS, gc_freeze__doc__},
 
 static PyObject *
-gc_freeze_impl(PyObject *module);
+gc_freeze_impl(PyObject *module, int immortalize);
 
 static PyObject *
-gc_freeze(PyObject *module, PyObject *Py_UNUSED(ignored))
+gc_freeze(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
 {
-    return gc_freeze_impl(module);
+    PyObject *return_value = NULL;
+    static const char * const _keywords[] = {"immortalize", NULL};
+    static _PyArg_Parser _parser = {NULL, _keywords, "freeze", 0};
+    PyObject *argsbuf[1];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 0;
+    int immortalize = 0;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 0, 0, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_kwonly;
+    }
+    immortalize = PyObject_IsTrue(args[0]);
+    if (immortalize < 0) {
+        goto exit;
+    }
+skip_optional_kwonly:
+    return_value = gc_freeze_impl(module, immortalize);
+
+exit:
+    return return_value;
 }
 
 PyDoc_STRVAR(gc_unfreeze__doc__,
@@ -331,7 +426,8 @@ PyDoc_STRVAR(gc_unfreeze__doc__,
 "\n"
 "Unfreeze all objects in the permanent generation.\n"
 "\n"
-"Put all objects in the permanent generation back into oldest generation.");
+"Put all objects in the permanent generation back into oldest generation.\n"
+"Immortal objects stay frozen, since they could never be collected.");
 
 #define GC_UNFREEZE_METHODDEF    \
     {"unfreeze", (PyCFunction)gc_unfreeze, METH_NOARGS, gc_unfreeze__doc__},
@@ -349,7 +445,9 @@ PyDoc_STRVAR(gc_get_freeze_count__doc__,
 "get_freeze_count($module, /)\n"
 "--\n"
 "\n"
-"Return the number of objects in the permanent generation.");
+"Return the number of objects in the permanent generation.\n"
+"\n"
+"Immortal objects are counted as well.");
 
 #define GC_GET_FREEZE_COUNT_METHODDEF    \
     {"get_freeze_count", (PyCFunction)gc_get_freeze_count, METH_NOARGS, gc_get_freeze_count__doc__},
@@ -372,4 +470,4 @@ gc_get_freeze_count(PyObject *module, PyObject *Py_UNUSED(ignored))
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=61e15f3a549f3ab5 input=a9049054013a1b77]*/
+/*[clinic end generated code: output=1ac4d80c7c4aa2ab input=a9049054013a1b77]*/
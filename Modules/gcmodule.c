@@ -31,6 +31,7 @@
 #include "pycore_pyerrors.h"
 #include "pycore_pystate.h"     // _PyThreadState_GET()
 #include "pydtrace.h"
+#include <stddef.h>               // offsetof()
 
 typedef struct _gc_runtime_state GCState;
 
@@ -127,6 +128,11 @@ gc_decref(PyGC_Head *g)
 
 #define GEN_HEAD(gcstate, n) (&(gcstate)->generations[n].head)
 
+/* Bounds of the number of objects examined by an increment of the
+   incremental collection of the oldest generation */
+#define GC_MIN_INCREMENT        1000
+#define GC_MAX_INCREMENT        (PY_SSIZE_T_MAX / 2)
+
 
 static GCState *
 get_gc_state(void)
@@ -135,6 +141,23 @@ get_gc_state(void)
     return &interp->gc;
 }
 
+/* Add the time elapsed since 't' to the given phase and return the
+   current time. */
+static inline _PyTime_t
+record_phase(_PyTime_t *phase_times, enum _PyGC_Phase phase, _PyTime_t t)
+{
+    _PyTime_t now = _PyTime_GetPerfCounter();
+    phase_times[phase] += now - t;
+    return now;
+}
+
+
+/* Used to check that PyGC_Head is aligned enough for the _gc_prev flags,
+   see _PyGC_HEAD_ALIGNED. */
+struct gc_head_alignment {
+    char c;
+    PyGC_Head head;
+};
 
 void
 _PyGC_InitState(GCState *gcstate)
@@ -142,6 +165,9 @@ _PyGC_InitState(GCState *gcstate)
     gcstate->enabled = 1; /* automatic collection enabled? */
 
 #define _GEN_HEAD(n) GEN_HEAD(gcstate, n)
+    Py_BUILD_ASSERT(offsetof(struct gc_head_alignment, head)
+                    % (1 << _PyGC_PREV_SHIFT) == 0);
+
     struct gc_generation generations[NUM_GENERATIONS] = {
         /* PyGC_Head,                                    threshold,    count */
         {{(uintptr_t)_GEN_HEAD(0), (uintptr_t)_GEN_HEAD(0)},   700,        0},
@@ -157,6 +183,14 @@ _PyGC_InitState(GCState *gcstate)
            (uintptr_t)&gcstate->permanent_generation.head}, 0, 0
     };
     gcstate->permanent_generation = permanent_generation;
+    gcstate->immortal._gc_next = (uintptr_t)&gcstate->immortal;
+    gcstate->immortal._gc_prev = (uintptr_t)&gcstate->immortal;
+    gcstate->incremental_visited._gc_next =
+        (uintptr_t)&gcstate->incremental_visited;
+    gcstate->incremental_visited._gc_prev =
+        (uintptr_t)&gcstate->incremental_visited;
+    gcstate->max_pause = 0;
+    gcstate->increment_size = GC_MIN_INCREMENT;
 }
 
 
@@ -1041,6 +1075,7 @@ clear_freelists(PyInterpreterState *interp)
     _PyFrame_ClearFreeList(interp);
     _PyTuple_ClearFreeList(interp);
     _PyFloat_ClearFreeList(interp);
+    _PyLong_ClearFreeList(interp);
     _PyList_ClearFreeList(interp);
     _PyDict_ClearFreeList(interp);
     _PyAsyncGen_ClearFreeLists(interp);
@@ -1063,7 +1098,8 @@ show_stats_each_generations(GCState *gcstate)
     PySys_FormatStderr(
         "gc: objects in each generation:%s\n"
         "gc: objects in permanent generation: %zd\n",
-        buf, gc_list_size(&gcstate->permanent_generation.head));
+        buf, gc_list_size(&gcstate->permanent_generation.head)
+             + gc_list_size(&gcstate->immortal));
 }
 
 /* Deduce which objects among "base" are unreachable from outside the list
@@ -1092,17 +1128,30 @@ IMPORTANT: This function leaves 'unreachable' with the NEXT_MASK_UNREACHABLE
 flag set but it does not clear it to skip unnecessary iteration. Before the
 flag is cleared (for example, by using 'clear_unreachable_mask' function or
 by a call to 'move_legacy_finalizers'), the 'unreachable' list is not a normal
-list and we can not use most gc_list_* functions for it. */
+list and we can not use most gc_list_* functions for it.
+
+If 'phase_times' is not NULL, the time spent in each phase is added to it. */
 static inline void
-deduce_unreachable(PyGC_Head *base, PyGC_Head *unreachable) {
+deduce_unreachable(PyGC_Head *base, PyGC_Head *unreachable,
+                   _PyTime_t *phase_times) {
+    _PyTime_t t = 0;
     validate_list(base, collecting_clear_unreachable_clear);
     /* Using ob_refcnt and gc_refs, calculate which objects in the
      * container set are reachable from outside the set (i.e., have a
      * refcount greater than 0 when all the references within the
      * set are taken into account).
      */
+    if (phase_times != NULL) {
+        t = _PyTime_GetPerfCounter();
+    }
     update_refs(base);  // gc_prev is used for gc_refs
+    if (phase_times != NULL) {
+        t = record_phase(phase_times, GC_PHASE_UPDATE_REFS, t);
+    }
     subtract_refs(base);
+    if (phase_times != NULL) {
+        t = record_phase(phase_times, GC_PHASE_SUBTRACT_REFS, t);
+    }
 
     /* Leave everything reachable from outside base in base, and move
      * everything else (in base) to unreachable.
@@ -1141,6 +1190,9 @@ deduce_unreachable(PyGC_Head *base, PyGC_Head *unreachable) {
      */
     gc_list_init(unreachable);
     move_unreachable(base, unreachable);  // gc_prev is pointer again
+    if (phase_times != NULL) {
+        (void)record_phase(phase_times, GC_PHASE_MOVE_UNREACHABLE, t);
+    }
     validate_list(base, collecting_clear_unreachable_clear);
     validate_list(unreachable, collecting_set_unreachable_set);
 }
@@ -1170,89 +1222,55 @@ handle_resurrected_objects(PyGC_Head *unreachable, PyGC_Head* still_unreachable,
     // have the PREV_MARK_COLLECTING set, but the objects are going to be
     // removed so we can skip the expense of clearing the flag.
     PyGC_Head* resurrected = unreachable;
-    deduce_unreachable(resurrected, still_unreachable);
+    deduce_unreachable(resurrected, still_unreachable, NULL);
     clear_unreachable_mask(still_unreachable);
 
     // Move the resurrected objects to the old generation for future collection.
     gc_list_merge(resurrected, old_generation);
 }
 
-/* This is the main function.  Read this to understand how the
- * collection process works. */
-static Py_ssize_t
-gc_collect_main(PyThreadState *tstate, int generation,
-                Py_ssize_t *n_collected, Py_ssize_t *n_uncollectable,
-                int nofail)
+/* Find the unreachable objects in 'young' and dispose of them.  The
+ * reachable objects are moved to 'old', unless both are the same list.
+ * Objects resurrected by finalizers and uncollectable objects end up in
+ * 'old' as well.  If 'survivors' is not NULL, it is set to the number of
+ * reachable objects found in 'young'.  If 'untrack_all' is true, dicts which
+ * can no longer be part of a cycle are untracked too, which is only done
+ * when each object is examined once in a while, to avoid quadratic dict
+ * build-up (see issue #14775).  The time spent in each phase is stored in
+ * 'phase_times'.
+ */
+static void
+gc_collect_region(PyThreadState *tstate, PyGC_Head *young, PyGC_Head *old,
+                  int untrack_all, Py_ssize_t *survivors,
+                  Py_ssize_t *n_collected, Py_ssize_t *n_uncollectable,
+                  _PyTime_t *phase_times)
 {
-    int i;
     Py_ssize_t m = 0; /* # objects collected */
     Py_ssize_t n = 0; /* # unreachable objects that couldn't be collected */
-    PyGC_Head *young; /* the generation we are examining */
-    PyGC_Head *old; /* next older generation */
     PyGC_Head unreachable; /* non-problematic unreachable trash */
     PyGC_Head finalizers;  /* objects with, & reachable from, __del__ */
     PyGC_Head *gc;
-    _PyTime_t t1 = 0;   /* initialize to prevent a compiler warning */
     GCState *gcstate = &tstate->interp->gc;
+    _PyTime_t t;
 
-    // gc_collect_main() must not be called before _PyGC_Init
-    // or after _PyGC_Fini()
-    assert(gcstate->garbage != NULL);
-    assert(!_PyErr_Occurred(tstate));
-
-#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
-    if (tstate->interp->config._isolated_interpreter) {
-        // bpo-40533: The garbage collector must not be run on parallel on
-        // Python objects shared by multiple interpreters.
-        return 0;
+    for (int i = 0; i < NUM_GC_PHASES; i++) {
+        phase_times[i] = 0;
     }
-#endif
-
-    if (gcstate->debug & DEBUG_STATS) {
-        PySys_WriteStderr("gc: collecting generation %d...\n", generation);
-        show_stats_each_generations(gcstate);
-        t1 = _PyTime_GetMonotonicClock();
-    }
-
-    if (PyDTrace_GC_START_ENABLED())
-        PyDTrace_GC_START(generation);
-
-    /* update collection and allocation counters */
-    if (generation+1 < NUM_GENERATIONS)
-        gcstate->generations[generation+1].count += 1;
-    for (i = 0; i <= generation; i++)
-        gcstate->generations[i].count = 0;
-
-    /* merge younger generations with one we are currently collecting */
-    for (i = 0; i < generation; i++) {
-        gc_list_merge(GEN_HEAD(gcstate, i), GEN_HEAD(gcstate, generation));
-    }
-
-    /* handy references */
-    young = GEN_HEAD(gcstate, generation);
-    if (generation < NUM_GENERATIONS-1)
-        old = GEN_HEAD(gcstate, generation+1);
-    else
-        old = young;
     validate_list(old, collecting_clear_unreachable_clear);
 
-    deduce_unreachable(young, &unreachable);
+    deduce_unreachable(young, &unreachable, phase_times);
 
     untrack_tuples(young);
+    if (untrack_all) {
+        untrack_dicts(young);
+    }
+    if (survivors != NULL) {
+        *survivors = gc_list_size(young);
+    }
     /* Move reachable objects to next generation. */
     if (young != old) {
-        if (generation == NUM_GENERATIONS - 2) {
-            gcstate->long_lived_pending += gc_list_size(young);
-        }
         gc_list_merge(young, old);
     }
-    else {
-        /* We only un-track dicts in full collections, to avoid quadratic
-           dict build-up. See issue #14775. */
-        untrack_dicts(young);
-        gcstate->long_lived_pending = 0;
-        gcstate->long_lived_total = gc_list_size(young);
-    }
 
     /* All objects in unreachable are trash, but objects reachable from
      * legacy finalizers (e.g. tp_del) can't safely be deleted.
@@ -1278,6 +1296,7 @@ gc_collect_main(PyThreadState *tstate, int generation,
     }
 
     /* Clear weakrefs and invoke callbacks as necessary. */
+    t = _PyTime_GetPerfCounter();
     m += handle_weakrefs(&unreachable, old);
 
     validate_list(old, collecting_clear_unreachable_clear);
@@ -1291,6 +1310,7 @@ gc_collect_main(PyThreadState *tstate, int generation,
      * objects that are still unreachable */
     PyGC_Head final_unreachable;
     handle_resurrected_objects(&unreachable, &final_unreachable, old);
+    t = record_phase(phase_times, GC_PHASE_FINALIZE, t);
 
     /* Call tp_clear on objects in the final_unreachable set.  This will cause
     * the reference cycles to be broken.  It may also cause some objects
@@ -1306,12 +1326,6 @@ gc_collect_main(PyThreadState *tstate, int generation,
         if (gcstate->debug & DEBUG_UNCOLLECTABLE)
             debug_cycle("uncollectable", FROM_GC(gc));
     }
-    if (gcstate->debug & DEBUG_STATS) {
-        double d = _PyTime_AsSecondsDouble(_PyTime_GetMonotonicClock() - t1);
-        PySys_WriteStderr(
-            "gc: done, %zd unreachable, %zd uncollectable, %.4fs elapsed\n",
-            n+m, n, d);
-    }
 
     /* Append instances in the uncollectable set to a Python
      * reachable list of garbage.  The programmer has to deal with
@@ -1319,6 +1333,130 @@ gc_collect_main(PyThreadState *tstate, int generation,
      */
     handle_legacy_finalizers(tstate, gcstate, &finalizers, old);
     validate_list(old, collecting_clear_unreachable_clear);
+    (void)record_phase(phase_times, GC_PHASE_DELETE_GARBAGE, t);
+
+    *n_collected = m;
+    *n_uncollectable = n;
+}
+
+/* Move the objects examined so far by the incremental collection back to
+ * the oldest generation, completing the current round.  Return the number
+ * of objects moved. */
+static Py_ssize_t
+gc_end_incremental_round(GCState *gcstate)
+{
+    PyGC_Head *visited = &gcstate->incremental_visited;
+    PyGC_Head *gc;
+    Py_ssize_t n = 0;
+    for (gc = GC_NEXT(visited); gc != visited; gc = GC_NEXT(gc)) {
+        gc->_gc_prev &= ~_PyGC_PREV_MASK_VISITED;
+        n++;
+    }
+    gc_list_merge(visited, GEN_HEAD(gcstate, NUM_GENERATIONS-1));
+    return n;
+}
+
+/* Account for a collection of the given generation which paused the
+ * program for 'pause' in the running stats, and remember its timings for
+ * the callbacks. */
+static void
+record_pause(GCState *gcstate, int generation, _PyTime_t pause,
+             const _PyTime_t *phase_times)
+{
+    struct gc_generation_stats *stats = &gcstate->generation_stats[generation];
+    _PyTime_t us = _PyTime_AsMicroseconds(pause, _PyTime_ROUND_FLOOR);
+    int bucket = 0;
+    while (us > 0 && bucket < NUM_GC_PAUSE_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    stats->pause_histogram[bucket]++;
+    stats->pause_total += pause;
+    if (pause > stats->pause_max) {
+        stats->pause_max = pause;
+    }
+    gcstate->last_pause = pause;
+    for (int i = 0; i < NUM_GC_PHASES; i++) {
+        stats->phase_times[i] += phase_times[i];
+        gcstate->last_phase_times[i] = phase_times[i];
+    }
+}
+
+/* This is the main function.  Read this to understand how the
+ * collection process works. */
+static Py_ssize_t
+gc_collect_main(PyThreadState *tstate, int generation,
+                Py_ssize_t *n_collected, Py_ssize_t *n_uncollectable,
+                int nofail)
+{
+    int i;
+    Py_ssize_t m = 0; /* # objects collected */
+    Py_ssize_t n = 0; /* # unreachable objects that couldn't be collected */
+    Py_ssize_t survivors = 0; /* # reachable objects */
+    PyGC_Head *young; /* the generation we are examining */
+    PyGC_Head *old; /* next older generation */
+    _PyTime_t t1;
+    _PyTime_t phase_times[NUM_GC_PHASES];
+    GCState *gcstate = &tstate->interp->gc;
+
+    // gc_collect_main() must not be called before _PyGC_Init
+    // or after _PyGC_Fini()
+    assert(gcstate->garbage != NULL);
+    assert(!_PyErr_Occurred(tstate));
+
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    if (tstate->interp->config._isolated_interpreter) {
+        // bpo-40533: The garbage collector must not be run on parallel on
+        // Python objects shared by multiple interpreters.
+        return 0;
+    }
+#endif
+
+    t1 = _PyTime_GetPerfCounter();
+    if (gcstate->debug & DEBUG_STATS) {
+        PySys_WriteStderr("gc: collecting generation %d...\n", generation);
+        show_stats_each_generations(gcstate);
+    }
+
+    if (PyDTrace_GC_START_ENABLED())
+        PyDTrace_GC_START(generation);
+
+    /* update collection and allocation counters */
+    if (generation+1 < NUM_GENERATIONS)
+        gcstate->generations[generation+1].count += 1;
+    for (i = 0; i <= generation; i++)
+        gcstate->generations[i].count = 0;
+
+    /* merge younger generations with one we are currently collecting */
+    for (i = 0; i < generation; i++) {
+        gc_list_merge(GEN_HEAD(gcstate, i), GEN_HEAD(gcstate, generation));
+    }
+    /* a full collection examines every object at once, which ends any
+       incremental round in progress */
+    if (generation == NUM_GENERATIONS-1) {
+        (void)gc_end_incremental_round(gcstate);
+    }
+
+    /* handy references */
+    young = GEN_HEAD(gcstate, generation);
+    if (generation < NUM_GENERATIONS-1)
+        old = GEN_HEAD(gcstate, generation+1);
+    else
+        old = young;
+
+    gc_collect_region(tstate, young, old,
+                      young == old,
+                      generation >= NUM_GENERATIONS - 2 ? &survivors : NULL,
+                      &m, &n, phase_times);
+    if (young != old) {
+        if (generation == NUM_GENERATIONS - 2) {
+            gcstate->long_lived_pending += survivors;
+        }
+    }
+    else {
+        gcstate->long_lived_pending = 0;
+        gcstate->long_lived_total = survivors;
+    }
 
     /* Clear free list only during the collection of the highest
      * generation */
@@ -1326,6 +1464,14 @@ gc_collect_main(PyThreadState *tstate, int generation,
         clear_freelists(tstate->interp);
     }
 
+    _PyTime_t elapsed = _PyTime_GetPerfCounter() - t1;
+    if (gcstate->debug & DEBUG_STATS) {
+        double d = _PyTime_AsSecondsDouble(elapsed);
+        PySys_WriteStderr(
+            "gc: done, %zd unreachable, %zd uncollectable, %.4fs elapsed\n",
+            n+m, n, d);
+    }
+
     if (_PyErr_Occurred(tstate)) {
         if (nofail) {
             _PyErr_Clear(tstate);
@@ -1347,6 +1493,7 @@ gc_collect_main(PyThreadState *tstate, int generation,
     stats->collections++;
     stats->collected += m;
     stats->uncollectable += n;
+    record_pause(gcstate, generation, elapsed, phase_times);
 
     if (PyDTrace_GC_DONE_ENABLED()) {
         PyDTrace_GC_DONE(n + m);
@@ -1356,6 +1503,216 @@ gc_collect_main(PyThreadState *tstate, int generation,
     return n + m;
 }
 
+/* Add the object to the increment being built, unless it is not tracked,
+ * already part of it, already examined in the current round, or frozen. */
+static int
+visit_add_to_increment(PyObject *op, PyGC_Head *increment)
+{
+    if (_PyObject_IS_GC(op) && _PyObject_GC_IS_TRACKED(op)) {
+        PyGC_Head *gc = AS_GC(op);
+        if ((gc->_gc_prev & (PREV_MASK_COLLECTING | _PyGC_PREV_MASK_VISITED)) == 0) {
+            gc_list_move(gc, increment);
+            gc->_gc_prev |= PREV_MASK_COLLECTING;
+        }
+    }
+    return 0;
+}
+
+/* Move the oldest objects of the oldest generation into 'increment', along
+ * with the objects they reference, until 'budget' objects were traversed or
+ * the oldest generation is exhausted.
+ *
+ * An unreachable cycle is only found if all of its objects are examined
+ * together, so the objects referenced from the increment are added to it,
+ * whichever generation they are in.  When the budget runs out, the objects
+ * added but not traversed yet are moved back to the front of the oldest
+ * generation, where the next increment starts.  The objects examined in
+ * the current round are not added again: a cycle split between increments
+ * is seen as referenced from outside and survives until a later round,
+ * where its objects follow each other in the oldest generation.  Return
+ * the number of objects in the increment.
+ */
+static Py_ssize_t
+gc_build_increment(GCState *gcstate, PyGC_Head *increment, Py_ssize_t budget)
+{
+    PyGC_Head *pending = GEN_HEAD(gcstate, NUM_GENERATIONS-1);
+    /* the objects after 'scanned' in 'increment' still have to be
+       traversed */
+    PyGC_Head *scanned = increment;
+    Py_ssize_t size = 0;
+
+    while (size < budget) {
+        if (GC_NEXT(scanned) == increment) {
+            if (gc_list_is_empty(pending)) {
+                break;
+            }
+            PyGC_Head *gc = GC_NEXT(pending);
+            gc_list_move(gc, increment);
+            gc->_gc_prev |= PREV_MASK_COLLECTING;
+        }
+        scanned = GC_NEXT(scanned);
+        traverseproc traverse = Py_TYPE(FROM_GC(scanned))->tp_traverse;
+        (void) traverse(FROM_GC(scanned),
+                        (visitproc)visit_add_to_increment,
+                        increment);
+        size++;
+    }
+    /* the mark was only needed to build the increment */
+    gc_list_clear_collecting(increment);
+
+    if (GC_NEXT(scanned) != increment) {
+        /* Split off the objects which were not traversed and put them in
+           front of the oldest generation. */
+        PyGC_Head rest;
+        PyGC_Head *first = GC_NEXT(scanned);
+        PyGC_Head *last = GC_PREV(increment);
+        gc_list_init(&rest);
+        _PyGCHead_SET_NEXT(scanned, increment);
+        _PyGCHead_SET_PREV(increment, scanned);
+        _PyGCHead_SET_NEXT(&rest, first);
+        _PyGCHead_SET_PREV(first, &rest);
+        _PyGCHead_SET_NEXT(last, &rest);
+        _PyGCHead_SET_PREV(&rest, last);
+        gc_list_merge(pending, &rest);
+        gc_list_merge(&rest, pending);
+    }
+    return size;
+}
+
+/* Collect the next increment of the oldest generation.  Objects found to be
+ * reachable are set aside in gcstate->incremental_visited until all objects
+ * of the oldest generation have been examined, which completes a round.
+ * The size of the next increment is adjusted after each one to meet the
+ * gcstate->max_pause target.
+ */
+static Py_ssize_t
+gc_collect_increment(PyThreadState *tstate,
+                     Py_ssize_t *n_collected, Py_ssize_t *n_uncollectable)
+{
+    Py_ssize_t m = 0; /* # objects collected */
+    Py_ssize_t n = 0; /* # unreachable objects that couldn't be collected */
+    Py_ssize_t size;  /* # objects examined */
+    PyGC_Head increment;
+    PyGC_Head survivors;
+    PyGC_Head *gc;
+    GCState *gcstate = &tstate->interp->gc;
+    PyGC_Head *pending = GEN_HEAD(gcstate, NUM_GENERATIONS-1);
+    _PyTime_t t1;
+    _PyTime_t phase_times[NUM_GC_PHASES];
+
+    assert(gcstate->garbage != NULL);
+    assert(!_PyErr_Occurred(tstate));
+
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    if (tstate->interp->config._isolated_interpreter) {
+        // bpo-40533: The garbage collector must not be run on parallel on
+        // Python objects shared by multiple interpreters.
+        return 0;
+    }
+#endif
+
+    if (gcstate->debug & DEBUG_STATS) {
+        PySys_WriteStderr("gc: collecting generation %d incrementally...\n",
+                          NUM_GENERATIONS-1);
+        show_stats_each_generations(gcstate);
+    }
+
+    if (PyDTrace_GC_START_ENABLED())
+        PyDTrace_GC_START(NUM_GENERATIONS-1);
+
+    t1 = _PyTime_GetPerfCounter();
+    gcstate->generations[NUM_GENERATIONS-1].count = 0;
+
+    gc_list_init(&increment);
+    gc_list_init(&survivors);
+    size = gc_build_increment(gcstate, &increment, gcstate->increment_size);
+    gc_collect_region(tstate, &increment, &survivors, 1, NULL, &m, &n,
+                      phase_times);
+    for (gc = GC_NEXT(&survivors); gc != &survivors; gc = GC_NEXT(gc)) {
+        gc->_gc_prev |= _PyGC_PREV_MASK_VISITED;
+    }
+    gc_list_merge(&survivors, &gcstate->incremental_visited);
+
+    if (gc_list_is_empty(pending)) {
+        gcstate->long_lived_pending = 0;
+        gcstate->long_lived_total = gc_end_incremental_round(gcstate);
+        clear_freelists(tstate->interp);
+    }
+
+    _PyTime_t elapsed = _PyTime_GetPerfCounter() - t1;
+    if (elapsed > 0) {
+        /* Aim at the pause target, assuming that the time taken is
+           proportional to the number of objects examined, and smooth the
+           result over the last increments. */
+        double target = (double)size * gcstate->max_pause * 1000 / elapsed;
+        target = (gcstate->increment_size + target) / 2;
+        if (target < GC_MIN_INCREMENT) {
+            target = GC_MIN_INCREMENT;
+        }
+        else if (target > GC_MAX_INCREMENT) {
+            target = GC_MAX_INCREMENT;
+        }
+        gcstate->increment_size = (Py_ssize_t)target;
+    }
+
+    if (gcstate->debug & DEBUG_STATS) {
+        PySys_WriteStderr(
+            "gc: done, %zd examined, %zd unreachable, %zd uncollectable, "
+            "%.4fs elapsed\n",
+            size, n+m, n, _PyTime_AsSecondsDouble(elapsed));
+    }
+
+    if (_PyErr_Occurred(tstate)) {
+        _PyErr_WriteUnraisableMsg("in garbage collection", NULL);
+    }
+
+    *n_collected = m;
+    *n_uncollectable = n;
+
+    struct gc_generation_stats *stats =
+        &gcstate->generation_stats[NUM_GENERATIONS-1];
+    stats->collections++;
+    stats->collected += m;
+    stats->uncollectable += n;
+    record_pause(gcstate, NUM_GENERATIONS-1, elapsed, phase_times);
+
+    if (PyDTrace_GC_DONE_ENABLED()) {
+        PyDTrace_GC_DONE(n + m);
+    }
+
+    assert(!_PyErr_Occurred(tstate));
+    return n + m;
+}
+
+static const char *gc_phase_names[NUM_GC_PHASES] = {
+    "update_refs",
+    "subtract_refs",
+    "move_unreachable",
+    "finalize",
+    "delete_garbage",
+};
+
+/* Return a dict mapping the phase names to their duration in seconds. */
+static PyObject *
+phase_times_as_dict(const _PyTime_t *phase_times)
+{
+    PyObject *dict = PyDict_New();
+    if (dict == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < NUM_GC_PHASES; i++) {
+        PyObject *v = PyFloat_FromDouble(
+            _PyTime_AsSecondsDouble(phase_times[i]));
+        if (v == NULL || PyDict_SetItemString(dict, gc_phase_names[i], v)) {
+            Py_XDECREF(v);
+            Py_DECREF(dict);
+            return NULL;
+        }
+        Py_DECREF(v);
+    }
+    return dict;
+}
+
 /* Invoke progress callbacks to notify clients that garbage collection
  * is starting or stopping
  */
@@ -1376,10 +1733,26 @@ invoke_gc_callback(PyThreadState *tstate, const char *phase,
     assert(PyList_CheckExact(gcstate->callbacks));
     PyObject *info = NULL;
     if (PyList_GET_SIZE(gcstate->callbacks) != 0) {
-        info = Py_BuildValue("{sisnsn}",
-            "generation", generation,
-            "collected", collected,
-            "uncollectable", uncollectable);
+        if (strcmp(phase, "stop") == 0) {
+            PyObject *phase_times =
+                phase_times_as_dict(gcstate->last_phase_times);
+            if (phase_times == NULL) {
+                PyErr_WriteUnraisable(NULL);
+                return;
+            }
+            info = Py_BuildValue("{sisnsnsdsN}",
+                "generation", generation,
+                "collected", collected,
+                "uncollectable", uncollectable,
+                "pause", _PyTime_AsSecondsDouble(gcstate->last_pause),
+                "phase_times", phase_times);
+        }
+        else {
+            info = Py_BuildValue("{sisnsn}",
+                "generation", generation,
+                "collected", collected,
+                "uncollectable", uncollectable);
+        }
         if (info == NULL) {
             PyErr_WriteUnraisable(NULL);
             return;
@@ -1416,6 +1789,22 @@ gc_collect_with_callback(PyThreadState *tstate, int generation)
     return result;
 }
 
+/* Collect an increment of the oldest generation and invoke progress
+ * callbacks.
+ */
+static Py_ssize_t
+gc_collect_increment_with_callback(PyThreadState *tstate)
+{
+    assert(!_PyErr_Occurred(tstate));
+    Py_ssize_t result, collected, uncollectable;
+    invoke_gc_callback(tstate, "start", NUM_GENERATIONS-1, 0, 0);
+    result = gc_collect_increment(tstate, &collected, &uncollectable);
+    invoke_gc_callback(tstate, "stop", NUM_GENERATIONS-1,
+                       collected, uncollectable);
+    assert(!_PyErr_Occurred(tstate));
+    return result;
+}
+
 static Py_ssize_t
 gc_collect_generations(PyThreadState *tstate)
 {
@@ -1425,7 +1814,14 @@ gc_collect_generations(PyThreadState *tstate)
      * generations younger than it will be collected. */
     Py_ssize_t n = 0;
     for (int i = NUM_GENERATIONS-1; i >= 0; i--) {
-        if (gcstate->generations[i].count > gcstate->generations[i].threshold) {
+        int threshold = gcstate->generations[i].threshold;
+        if (i == NUM_GENERATIONS - 1 && gcstate->max_pause > 0
+            && !gc_list_is_empty(&gcstate->incremental_visited)) {
+            /* A round of incremental collection in progress goes on
+               after each collection of the next younger generation. */
+            threshold = 0;
+        }
+        if (gcstate->generations[i].count > threshold) {
             /* Avoid quadratic performance degradation in number
                of tracked objects (see also issue #4074):
 
@@ -1461,10 +1857,18 @@ gc_collect_generations(PyThreadState *tstate)
                This heuristic was suggested by Martin von Löwis on python-dev in
                June 2008. His original analysis and proposal can be found at:
                http://mail.python.org/pipermail/python-dev/2008-June/080579.html
+
+               In incremental mode, the heuristic only decides when a new
+               round of increments starts.
             */
             if (i == NUM_GENERATIONS - 1
+                && gc_list_is_empty(&gcstate->incremental_visited)
                 && gcstate->long_lived_pending < gcstate->long_lived_total / 4)
                 continue;
+            if (i == NUM_GENERATIONS - 1 && gcstate->max_pause > 0) {
+                n = gc_collect_increment_with_callback(tstate);
+                break;
+            }
             n = gc_collect_with_callback(tstate, i);
             break;
         }
@@ -1634,6 +2038,49 @@ gc_get_threshold_impl(PyObject *module)
                          gcstate->generations[2].threshold);
 }
 
+/*[clinic input]
+gc.set_max_pause
+
+    microseconds: Py_ssize_t
+    /
+
+Set the pause target of the collection of the oldest generation.
+
+If non-zero, automatic collections of the oldest generation are split into
+increments, each aiming at pausing the program for at most that many
+microseconds.  Zero disables incremental collection.
+[clinic start generated code]*/
+
+static PyObject *
+gc_set_max_pause_impl(PyObject *module, Py_ssize_t microseconds)
+/*[clinic end generated code: output=d8e0f7db470643e8 input=86fe6bf9588c0380]*/
+{
+    GCState *gcstate = get_gc_state();
+    if (microseconds < 0) {
+        PyErr_SetString(PyExc_ValueError, "pause target must be >= 0");
+        return NULL;
+    }
+    if (microseconds == 0) {
+        (void)gc_end_incremental_round(gcstate);
+    }
+    gcstate->max_pause = microseconds;
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+gc.get_max_pause -> Py_ssize_t
+
+Return the pause target of the collection of the oldest generation.
+[clinic start generated code]*/
+
+static Py_ssize_t
+gc_get_max_pause_impl(PyObject *module)
+/*[clinic end generated code: output=8bf1309b0fb5efcf input=b60e769a1c8f9558]*/
+{
+    GCState *gcstate = get_gc_state();
+    return gcstate->max_pause;
+}
+
 /*[clinic input]
 gc.get_count
 
@@ -1703,6 +2150,10 @@ gc_get_referrers(PyObject *self, PyObject *args)
             return NULL;
         }
     }
+    if (!(gc_referrers_for(args, &gcstate->incremental_visited, result))) {
+        Py_DECREF(result);
+        return NULL;
+    }
     return result;
 }
 
@@ -1794,6 +2245,10 @@ gc_get_objects_impl(PyObject *module, Py_ssize_t generation)
         if (append_objects(result, GEN_HEAD(gcstate, generation))) {
             goto error;
         }
+        if (generation == NUM_GENERATIONS-1
+            && append_objects(result, &gcstate->incremental_visited)) {
+            goto error;
+        }
 
         return result;
     }
@@ -1804,6 +2259,9 @@ gc_get_objects_impl(PyObject *module, Py_ssize_t generation)
             goto error;
         }
     }
+    if (append_objects(result, &gcstate->incremental_visited)) {
+        goto error;
+    }
     return result;
 
 error:
@@ -1836,12 +2294,34 @@ gc_get_stats_impl(PyObject *module)
         return NULL;
 
     for (i = 0; i < NUM_GENERATIONS; i++) {
-        PyObject *dict;
+        PyObject *dict, *histogram, *phase_times;
         st = &stats[i];
-        dict = Py_BuildValue("{snsnsn}",
+        histogram = PyTuple_New(NUM_GC_PAUSE_BUCKETS);
+        if (histogram == NULL)
+            goto error;
+        for (int j = 0; j < NUM_GC_PAUSE_BUCKETS; j++) {
+            PyObject *v = PyLong_FromSsize_t(st->pause_histogram[j]);
+            if (v == NULL) {
+                Py_DECREF(histogram);
+                goto error;
+            }
+            PyTuple_SET_ITEM(histogram, j, v);
+        }
+        phase_times = phase_times_as_dict(st->phase_times);
+        if (phase_times == NULL) {
+            Py_DECREF(histogram);
+            goto error;
+        }
+        dict = Py_BuildValue("{snsnsnsdsdsNsN}",
                              "collections", st->collections,
                              "collected", st->collected,
-                             "uncollectable", st->uncollectable
+                             "uncollectable", st->uncollectable,
+                             "pause_total",
+                             _PyTime_AsSecondsDouble(st->pause_total),
+                             "pause_max",
+                             _PyTime_AsSecondsDouble(st->pause_max),
+                             "pause_histogram", histogram,
+                             "phase_times", phase_times
                             );
         if (dict == NULL)
             goto error;
@@ -1903,25 +2383,134 @@ gc_is_finalized(PyObject *module, PyObject *obj)
     Py_RETURN_FALSE;
 }
 
+#ifdef _Py_IMMORTAL_REFCNT
+/* Containers reachable from the frozen objects which are not tracked, and
+ * thus not frozen, but still need to be made immortal.  An explicit stack
+ * rather than recursion, since these can be nested arbitrarily deep. */
+typedef struct {
+    PyObject **items;
+    Py_ssize_t size;
+    Py_ssize_t allocated;
+} immortalize_stack;
+
+/* Make the object immortal, see _Py_IMMORTAL_REFCNT.  Untracked containers
+ * are pushed to the stack, to make the objects they refer to immortal as
+ * well. */
+static int
+visit_immortalize(PyObject *op, immortalize_stack *stack)
+{
+    if (_Py_IsImmortal(op)) {
+        return 0;
+    }
+#ifdef Py_REF_DEBUG
+    /* Py_DECREF() doesn't account for the references to immortal objects */
+    _Py_RefTotal -= Py_REFCNT(op);
+#endif
+    Py_SET_REFCNT(op, _Py_IMMORTAL_REFCNT);
+    if (_PyObject_IS_GC(op) && !_PyObject_GC_IS_TRACKED(op)) {
+        if (stack->size == stack->allocated) {
+            Py_ssize_t allocated = stack->allocated * 2 + 64;
+            PyObject **items = PyMem_Resize(stack->items, PyObject *,
+                                            allocated);
+            if (items == NULL) {
+                return -1;
+            }
+            stack->items = items;
+            stack->allocated = allocated;
+        }
+        stack->items[stack->size++] = op;
+    }
+    return 0;
+}
+
+/* Make the frozen objects and the objects they refer to immortal, then move
+ * the immortal objects to their own list.  On memory error, the objects
+ * which were made immortal already are moved all the same. */
+static int
+immortalize_frozen(GCState *gcstate)
+{
+    PyGC_Head *permanent = &gcstate->permanent_generation.head;
+    PyGC_Head *gc, *next;
+    immortalize_stack stack = {NULL, 0, 0};
+    int err = 0;
+
+    for (gc = GC_NEXT(permanent); gc != permanent && !err; gc = GC_NEXT(gc)) {
+        PyObject *op = FROM_GC(gc);
+        (void) visit_immortalize(op, &stack);
+        err = Py_TYPE(op)->tp_traverse(op, (visitproc)visit_immortalize,
+                                       &stack);
+        while (stack.size > 0 && !err) {
+            op = stack.items[--stack.size];
+            err = Py_TYPE(op)->tp_traverse(op, (visitproc)visit_immortalize,
+                                           &stack);
+        }
+    }
+    PyMem_Free(stack.items);
+
+    for (gc = GC_NEXT(permanent); gc != permanent; gc = next) {
+        next = GC_NEXT(gc);
+        if (_Py_IsImmortal(FROM_GC(gc))) {
+            gc_list_move(gc, &gcstate->immortal);
+        }
+    }
+    if (err) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    return 0;
+}
+#endif  /* _Py_IMMORTAL_REFCNT */
+
 /*[clinic input]
 gc.freeze
 
+    *
+    immortalize: bool = False
+
 Freeze all current tracked objects and ignore them for future collections.
 
 This can be used before a POSIX fork() call to make the gc copy-on-write friendly.
 Note: collection before a POSIX fork() call may free pages for future allocation
 which can cause copy-on-write.
+
+If immortalize is true, the frozen objects and the objects they refer to are
+also made immortal: their reference count is no longer updated, and they are
+never deallocated, even after unfreeze().  Immortal objects are not supported
+on 32-bit platforms.
 [clinic start generated code]*/
 
 static PyObject *
-gc_freeze_impl(PyObject *module)
-/*[clinic end generated code: output=502159d9cdc4c139 input=b602b16ac5febbe5]*/
+gc_freeze_impl(PyObject *module, int immortalize)
+/*[clinic end generated code: output=db32b5465626796f input=d4a55660fdd1dab3]*/
 {
     GCState *gcstate = get_gc_state();
+    PyGC_Head *permanent = &gcstate->permanent_generation.head;
+    PyGC_Head *gc;
+    /* the objects examined in the current round are marked already */
+    gc_list_merge(&gcstate->incremental_visited, permanent);
     for (int i = 0; i < NUM_GENERATIONS; ++i) {
-        gc_list_merge(GEN_HEAD(gcstate, i), &gcstate->permanent_generation.head);
+        /* Mark the frozen objects, so that the incremental collection
+           doesn't take them back when they are reachable from other
+           objects. */
+        PyGC_Head *head = GEN_HEAD(gcstate, i);
+        for (gc = GC_NEXT(head); gc != head; gc = GC_NEXT(gc)) {
+            gc->_gc_prev |= _PyGC_PREV_MASK_VISITED;
+        }
+        gc_list_merge(head, permanent);
         gcstate->generations[i].count = 0;
     }
+    if (immortalize) {
+#ifdef _Py_IMMORTAL_REFCNT
+        if (immortalize_frozen(gcstate) < 0) {
+            return NULL;
+        }
+#else
+        /* the objects are frozen all the same */
+        PyErr_SetString(PyExc_NotImplementedError,
+                        "immortal objects are not supported on this platform");
+        return NULL;
+#endif
+    }
     Py_RETURN_NONE;
 }
 
@@ -1931,15 +2520,20 @@ gc.unfreeze
 Unfreeze all objects in the permanent generation.
 
 Put all objects in the permanent generation back into oldest generation.
+Immortal objects stay frozen, since they could never be collected.
 [clinic start generated code]*/
 
 static PyObject *
 gc_unfreeze_impl(PyObject *module)
-/*[clinic end generated code: output=1c15f2043b25e169 input=2dd52b170f4cef6c]*/
+/*[clinic end generated code: output=1c15f2043b25e169 input=6c4aecf9ee20fbfa]*/
 {
     GCState *gcstate = get_gc_state();
-    gc_list_merge(&gcstate->permanent_generation.head,
-                  GEN_HEAD(gcstate, NUM_GENERATIONS-1));
+    PyGC_Head *permanent = &gcstate->permanent_generation.head;
+    PyGC_Head *gc;
+    for (gc = GC_NEXT(permanent); gc != permanent; gc = GC_NEXT(gc)) {
+        gc->_gc_prev &= ~_PyGC_PREV_MASK_VISITED;
+    }
+    gc_list_merge(permanent, GEN_HEAD(gcstate, NUM_GENERATIONS-1));
     Py_RETURN_NONE;
 }
 
@@ -1947,14 +2541,17 @@ gc_unfreeze_impl(PyObject *module)
 gc.get_freeze_count -> Py_ssize_t
 
 Return the number of objects in the permanent generation.
+
+Immortal objects are counted as well.
 [clinic start generated code]*/
 
 static Py_ssize_t
 gc_get_freeze_count_impl(PyObject *module)
-/*[clinic end generated code: output=61cbd9f43aa032e1 input=45ffbc65cfe2a6ed]*/
+/*[clinic end generated code: output=61cbd9f43aa032e1 input=7ec6dbf4bafced8e]*/
 {
     GCState *gcstate = get_gc_state();
-    return gc_list_size(&gcstate->permanent_generation.head);
+    return (gc_list_size(&gcstate->permanent_generation.head)
+            + gc_list_size(&gcstate->immortal));
 }
 
 
@@ -1971,6 +2568,8 @@ PyDoc_STRVAR(gc__doc__,
 "get_debug() -- Get debugging flags.\n"
 "set_threshold() -- Set the collection thresholds.\n"
 "get_threshold() -- Return the current the collection thresholds.\n"
+"set_max_pause() -- Set the pause target of the oldest generation collection.\n"
+"get_max_pause() -- Return the pause target of the oldest generation collection.\n"
 "get_objects() -- Return a list of all objects tracked by the collector.\n"
 "is_tracked() -- Returns true if a given object is tracked.\n"
 "is_finalized() -- Returns true if a given object has been already finalized.\n"
@@ -1989,6 +2588,8 @@ static PyMethodDef GcMethods[] = {
     GC_GET_COUNT_METHODDEF
     {"set_threshold",  gc_set_threshold, METH_VARARGS, gc_set_thresh__doc__},
     GC_GET_THRESHOLD_METHODDEF
+    GC_SET_MAX_PAUSE_METHODDEF
+    GC_GET_MAX_PAUSE_METHODDEF
     GC_COLLECT_METHODDEF
     GC_GET_OBJECTS_METHODDEF
     GC_GET_STATS_METHODDEF
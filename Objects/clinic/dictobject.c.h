@@ -174,6 +174,41 @@ dict_popitem(PyDictObject *self, PyObject *Py_UNUSED(ignored))
     return dict_popitem_impl(self);
 }
 
+PyDoc_STRVAR(frozendict_fromkeys__doc__,
+"fromkeys($type, iterable, value=None, /)\n"
+"--\n"
+"\n"
+"Create a new frozendict with keys from iterable and values set to value.");
+
+#define FROZENDICT_FROMKEYS_METHODDEF    \
+    {"fromkeys", (PyCFunction)(void(*)(void))frozendict_fromkeys, METH_FASTCALL|METH_CLASS, frozendict_fromkeys__doc__},
+
+static PyObject *
+frozendict_fromkeys_impl(PyTypeObject *type, PyObject *iterable,
+                         PyObject *value);
+
+static PyObject *
+frozendict_fromkeys(PyTypeObject *type, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *iterable;
+    PyObject *value = Py_None;
+
+    if (!_PyArg_CheckPositional("fromkeys", nargs, 1, 2)) {
+        goto exit;
+    }
+    iterable = args[0];
+    if (nargs < 2) {
+        goto skip_optional;
+    }
+    value = args[1];
+skip_optional:
+    return_value = frozendict_fromkeys_impl(type, iterable, value);
+
+exit:
+    return return_value;
+}
+
 PyDoc_STRVAR(dict___reversed____doc__,
 "__reversed__($self, /)\n"
 "--\n"
@@ -191,4 +226,4 @@ dict___reversed__(PyDictObject *self, PyObject *Py_UNUSED(ignored))
 {
     return dict___reversed___impl(self);
 }
-/*[clinic end generated code: output=7b77c16e43d6735a input=a9049054013a1b77]*/
+/*[clinic end generated code: output=ae7aacdf772367ae input=a9049054013a1b77]*/
@@ -143,7 +143,7 @@ list_pop(PyListObject *self, PyObject *const *args, Py_ssize_t nargs)
 }
 
 PyDoc_STRVAR(list_sort__doc__,
-"sort($self, /, *, key=None, reverse=False)\n"
+"sort($self, /, *, key=None, reverse=False, parallel=False)\n"
 "--\n"
 "\n"
 "Sort the list in ascending order and return None.\n"
@@ -154,24 +154,29 @@ PyDoc_STRVAR(list_sort__doc__,
 "If a key function is given, apply it once to each list item and sort them,\n"
 "ascending or descending, according to their function values.\n"
 "\n"
-"The reverse flag can be set to sort in descending order.");
+"The reverse flag can be set to sort in descending order.\n"
+"\n"
+"If the parallel flag is set, large lists whose sort keys are all ints, floats\n"
+"or Latin-1 strings are sorted using several threads.");
 
 #define LIST_SORT_METHODDEF    \
     {"sort", (PyCFunction)(void(*)(void))list_sort, METH_FASTCALL|METH_KEYWORDS, list_sort__doc__},
 
 static PyObject *
-list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse);
+list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse,
+               int parallel);
 
 static PyObject *
 list_sort(PyListObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
 {
     PyObject *return_value = NULL;
-    static const char * const _keywords[] = {"key", "reverse", NULL};
+    static const char * const _keywords[] = {"key", "reverse", "parallel", NULL};
     static _PyArg_Parser _parser = {NULL, _keywords, "sort", 0};
-    PyObject *argsbuf[2];
+    PyObject *argsbuf[3];
     Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 0;
     PyObject *keyfunc = Py_None;
     int reverse = 0;
+    int parallel = 0;
 
     args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 0, 0, 0, argsbuf);
     if (!args) {
@@ -186,12 +191,21 @@ list_sort(PyListObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject
             goto skip_optional_kwonly;
         }
     }
-    reverse = _PyLong_AsInt(args[1]);
-    if (reverse == -1 && PyErr_Occurred()) {
+    if (args[1]) {
+        reverse = _PyLong_AsInt(args[1]);
+        if (reverse == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        if (!--noptargs) {
+            goto skip_optional_kwonly;
+        }
+    }
+    parallel = _PyLong_AsInt(args[2]);
+    if (parallel == -1 && PyErr_Occurred()) {
         goto exit;
     }
 skip_optional_kwonly:
-    return_value = list_sort_impl(self, keyfunc, reverse);
+    return_value = list_sort_impl(self, keyfunc, reverse, parallel);
 
 exit:
     return return_value;
@@ -352,4 +366,4 @@ list___reversed__(PyListObject *self, PyObject *Py_UNUSED(ignored))
 {
     return list___reversed___impl(self);
 }
-/*[clinic end generated code: output=0063aad535edf62d input=a9049054013a1b77]*/
+/*[clinic end generated code: output=569511282ef796bd input=a9049054013a1b77]*/
@@ -271,6 +271,7 @@ PyCode_NewWithPosOnlyArgs(int argcount, int posonlyargcount, int kwonlyargcount,
     co->co_opcache = NULL;
     co->co_opcache_flag = 0;
     co->co_opcache_size = 0;
+    co->co_opcache_stats = NULL;
     return co;
 }
 
@@ -300,16 +301,30 @@ _PyCode_InitOpcache(PyCodeObject *co)
     _Py_CODEUNIT *opcodes = (_Py_CODEUNIT*)PyBytes_AS_STRING(co->co_code);
     Py_ssize_t opts = 0;
 
-    for (Py_ssize_t i = 0; i < co_size;) {
-        unsigned char opcode = _Py_OPCODE(opcodes[i]);
-        i++;  // 'i' is now aligned to (next_instr - first_instr)
-
-        // TODO: LOAD_METHOD
-        if (opcode == LOAD_GLOBAL || opcode == LOAD_ATTR) {
-            opts++;
-            co->co_opcache_map[i] = (unsigned char)opts;
-            if (opts > 254) {
-                break;
+    // At most 255 sites get a cache.  LOAD_GLOBAL and LOAD_ATTR gain the
+    // most from it, so they are given their entries in a first pass and the
+    // other cached opcodes only get the entries left over.
+    for (int pass = 0; pass < 2 && opts < 255; pass++) {
+        for (Py_ssize_t i = 0; i < co_size;) {
+            unsigned char opcode = _Py_OPCODE(opcodes[i]);
+            i++;  // 'i' is now aligned to (next_instr - first_instr)
+
+            int cached;
+            if (opcode == LOAD_GLOBAL || opcode == LOAD_ATTR) {
+                cached = (pass == 0);
+            }
+            else {
+                cached = (pass == 1 &&
+                          (opcode == STORE_ATTR || opcode == LOAD_METHOD ||
+                           opcode == BINARY_ADD || opcode == INPLACE_ADD ||
+                           opcode == COMPARE_OP || opcode == CALL_FUNCTION));
+            }
+            if (cached) {
+                opts++;
+                co->co_opcache_map[i] = (unsigned char)opts;
+                if (opts > 254) {
+                    break;
+                }
             }
         }
     }
@@ -644,6 +659,9 @@ code_dealloc(PyCodeObject *co)
     if (co->co_opcache_map != NULL) {
         PyMem_Free(co->co_opcache_map);
     }
+    if (co->co_opcache_stats != NULL) {
+        PyMem_Free(co->co_opcache_stats);
+    }
     co->co_opcache_flag = 0;
     co->co_opcache_size = 0;
 
@@ -701,6 +719,9 @@ code_sizeof(PyCodeObject *co, PyObject *Py_UNUSED(args))
         // co_opcache
         res += co->co_opcache_size * sizeof(_PyOpcache);
     }
+    if (co->co_opcache_stats != NULL) {
+        res += sizeof(_PyOpcacheStats);
+    }
     return PyLong_FromSsize_t(res);
 }
 
@@ -60,7 +60,8 @@ The DictObject can be in one of two forms.
     ma_values != NULL, dk_refcnt >= 1
     Values are stored in the ma_values array.
     Only string (unicode) keys are allowed.
-    All dicts sharing same key must have same insertion order.
+    Each dict records its own insertion order (see SPLIT_ORDER()), so dicts
+    sharing the same keys may hold different subsets of them, in any order.
 
 There are four kinds of slots in the table (slot is index, and
 DK_ENTRIES(keys)[index] if index >= 0):
@@ -82,7 +83,8 @@ DK_ENTRIES(keys)[index] if index >= 0):
    they were once active.
 
 4. Pending. index >= 0, key != NULL, and value == NULL  (split only)
-   Not yet inserted in split-table.
+   Not yet inserted in split-table, or deleted from it.  Pending can
+   transition to Active upon key insertion.
 */
 
 /*
@@ -96,9 +98,12 @@ dk_nentries to achieve amortized O(1).  Since there are DKIX_DUMMY remains in
 dk_indices, we can't increment dk_usable even though dk_nentries is
 decremented.
 
-In split table, inserting into pending entry is allowed only for dk_entries[ix]
-where ix == mp->ma_used. Inserting into other index and deleting item cause
-converting the dict to the combined table.
+In split table, the entries are shared with other dicts and their order says
+nothing about this dict.  The values array is followed by an array of bytes
+holding the indices of the active entries in insertion order; insertion
+appends to it and deletion removes from it, so neither has to convert the dict
+to the combined table.  The byte-sized indices limit split tables to
+SPLIT_KEYS_MAXSIZE slots.
 */
 
 /* PyDict_MINSIZE is the starting size for any new dict.
@@ -110,6 +115,14 @@ converting the dict to the combined table.
  */
 #define PyDict_MINSIZE 8
 
+/* PyDict_TINYSIZE is the size used instead when a dict is known to hold at
+ * most 2 entries at creation: literals, keyword arguments and copies of small
+ * dicts.  Such dicts dominate many heaps and are rarely grown afterwards; the
+ * smaller table saves 72 bytes per dict on 64-bit builds.  Inserting a third
+ * entry resizes it to PyDict_MINSIZE as usual.
+ */
+#define PyDict_TINYSIZE 4
+
 #include "Python.h"
 #include "pycore_bitutils.h" // _Py_bit_length
 #include "pycore_gc.h"       // _PyObject_GC_IS_TRACKED()
@@ -121,8 +134,9 @@ converting the dict to the combined table.
 
 /*[clinic input]
 class dict "PyDictObject *" "&PyDict_Type"
+class frozendict "PyFrozenDictObject *" "&PyFrozenDict_Type"
 [clinic start generated code]*/
-/*[clinic end generated code: output=da39a3ee5e6b4b0d input=f157a5a0ce9589d6]*/
+/*[clinic end generated code: output=da39a3ee5e6b4b0d input=5dfa93bac68e7c54]*/
 
 
 /*
@@ -236,6 +250,8 @@ lookdict_unicode_nodummy(PyDictObject *mp, PyObject *key,
                          Py_hash_t hash, PyObject **value_addr);
 static Py_ssize_t lookdict_split(PyDictObject *mp, PyObject *key,
                                  Py_hash_t hash, PyObject **value_addr);
+static Py_ssize_t lookdict_perfect(PyDictObject *mp, PyObject *key,
+                                   Py_hash_t hash, PyObject **value_addr);
 
 static int dictresize(PyDictObject *mp, Py_ssize_t newsize);
 
@@ -271,6 +287,9 @@ _PyDict_ClearFreeList(PyInterpreterState *interp)
     while (state->keys_numfree) {
         PyObject_Free(state->keys_free_list[--state->keys_numfree]);
     }
+    while (state->tiny_keys_numfree) {
+        PyObject_Free(state->tiny_keys_free_list[--state->tiny_keys_numfree]);
+    }
 }
 
 
@@ -282,6 +301,7 @@ _PyDict_Fini(PyInterpreterState *interp)
     struct _Py_dict_state *state = &interp->dict_state;
     state->numfree = -1;
     state->keys_numfree = -1;
+    state->tiny_keys_numfree = -1;
 #endif
 }
 
@@ -412,16 +432,22 @@ dictkeys_set_index(PyDictKeysObject *keys, Py_ssize_t i, Py_ssize_t ix)
  */
 #define USABLE_FRACTION(n) (((n) << 1)/3)
 
+/* The values array of a split table has one slot per usable entry of the
+   shared keys, followed by the order array described above. */
+#define SPLIT_KEYS_MAXSIZE 256
+#define SPLIT_ORDER(mp) \
+    ((uint8_t *)((mp)->ma_values + USABLE_FRACTION(DK_SIZE((mp)->ma_keys))))
+
 /* Find the smallest dk_size >= minsize. */
 static inline Py_ssize_t
 calculate_keysize(Py_ssize_t minsize)
 {
 #if SIZEOF_LONG == SIZEOF_SIZE_T
-    minsize = (minsize | PyDict_MINSIZE) - 1;
+    minsize = Py_MAX(minsize, PyDict_MINSIZE) - 1;
     return 1LL << _Py_bit_length(minsize | (PyDict_MINSIZE-1));
 #elif defined(_MSC_VER)
     // On 64bit Windows, sizeof(long) == 4.
-    minsize = (minsize | PyDict_MINSIZE) - 1;
+    minsize = Py_MAX(minsize, PyDict_MINSIZE) - 1;
     unsigned long msb;
     _BitScanReverse64(&msb, (uint64_t)minsize);
     return 1LL << (msb + 1);
@@ -443,6 +469,9 @@ calculate_keysize(Py_ssize_t minsize)
 static inline Py_ssize_t
 estimate_keysize(Py_ssize_t n)
 {
+    if (n <= USABLE_FRACTION(PyDict_TINYSIZE)) {
+        return PyDict_TINYSIZE;
+    }
     return calculate_keysize((n*3 + 1) / 2);
 }
 
@@ -498,7 +527,7 @@ _PyDict_CheckConsistency(PyObject *op, int check_content)
     do { if (!(expr)) { _PyObject_ASSERT_FAILED_MSG(op, Py_STRINGIFY(expr)); } } while (0)
 
     assert(op != NULL);
-    CHECK(PyDict_Check(op));
+    CHECK(PyAnyDict_Check(op));
     PyDictObject *mp = (PyDictObject *)op;
 
     PyDictKeysObject *keys = mp->ma_keys;
@@ -551,9 +580,16 @@ _PyDict_CheckConsistency(PyObject *op, int check_content)
 
         if (splitted) {
             /* splitted table */
+            uint8_t *order = SPLIT_ORDER(mp);
+            Py_ssize_t nvalues = 0;
             for (i=0; i < mp->ma_used; i++) {
-                CHECK(mp->ma_values[i] != NULL);
+                CHECK(order[i] < keys->dk_nentries);
+                CHECK(mp->ma_values[order[i]] != NULL);
+            }
+            for (i=0; i < keys->dk_nentries; i++) {
+                nvalues += (mp->ma_values[i] != NULL);
             }
+            CHECK(nvalues == mp->ma_used);
         }
     }
     return 1;
@@ -568,7 +604,7 @@ new_keys_object(Py_ssize_t size)
     PyDictKeysObject *dk;
     Py_ssize_t es, usable;
 
-    assert(size >= PyDict_MINSIZE);
+    assert(size >= PyDict_TINYSIZE);
     assert(IS_POWER_OF_2(size));
 
     usable = USABLE_FRACTION(size);
@@ -595,6 +631,9 @@ new_keys_object(Py_ssize_t size)
     if (size == PyDict_MINSIZE && state->keys_numfree > 0) {
         dk = state->keys_free_list[--state->keys_numfree];
     }
+    else if (size == PyDict_TINYSIZE && state->tiny_keys_numfree > 0) {
+        dk = state->tiny_keys_free_list[--state->tiny_keys_numfree];
+    }
     else
     {
         dk = PyObject_Malloc(sizeof(PyDictKeysObject)
@@ -636,12 +675,43 @@ free_keys_object(PyDictKeysObject *keys)
         state->keys_free_list[state->keys_numfree++] = keys;
         return;
     }
+    if (keys->dk_size == PyDict_TINYSIZE &&
+        state->tiny_keys_numfree < PyDict_MAXFREELIST)
+    {
+        state->tiny_keys_free_list[state->tiny_keys_numfree++] = keys;
+        return;
+    }
     PyObject_Free(keys);
 }
 
-#define new_values(size) PyMem_NEW(PyObject *, size)
+static PyObject **
+new_values(Py_ssize_t size)
+{
+    assert(size <= USABLE_FRACTION(SPLIT_KEYS_MAXSIZE));
+    return (PyObject **)PyMem_Malloc(size * (sizeof(PyObject *) + 1));
+}
+
 #define free_values(values) PyMem_Free(values)
 
+/* Remove the active entry ix of split table mp from its insertion order and
+   mark it pending again.  The shared key itself stays in place. */
+static void
+split_values_remove(PyDictObject *mp, Py_ssize_t ix)
+{
+    uint8_t *order = SPLIT_ORDER(mp);
+    Py_ssize_t i = mp->ma_used - 1;
+
+    assert(mp->ma_values[ix] != NULL);
+    while (order[i] != ix) {
+        assert(i > 0);
+        i--;
+    }
+    memmove(&order[i], &order[i + 1], mp->ma_used - i - 1);
+    mp->ma_values[ix] = NULL;
+    mp->ma_used--;
+    mp->ma_version_tag = DICT_NEXT_VERSION();
+}
+
 /* Consumes a reference to the keys object */
 static PyObject *
 new_dict(PyDictKeysObject *keys, PyObject **values)
@@ -700,7 +770,7 @@ new_dict_with_shared_keys(PyDictKeysObject *keys)
 static PyDictKeysObject *
 clone_combined_dict_keys(PyDictObject *orig)
 {
-    assert(PyDict_Check(orig));
+    assert(PyAnyDict_Check(orig));
     assert(Py_TYPE(orig)->tp_iter == (getiterfunc)dict_iter);
     assert(orig->ma_values == NULL);
     assert(orig->ma_keys->dk_refcnt == 1);
@@ -973,14 +1043,105 @@ lookdict_split(PyDictObject *mp, PyObject *key,
     Py_UNREACHABLE();
 }
 
+/* frozendict objects extend the dict layout with a cached hash and, when
+   one could be found, the displacements of a perfect hash of the keys. */
+typedef struct {
+    PyDictObject fd_dict;
+    Py_hash_t fd_hash;          /* -1 until computed */
+    size_t fd_bucket_mask;      /* number of displacements - 1 */
+    uint16_t *fd_disp;          /* NULL if the table uses regular probing */
+} PyFrozenDictObject;
+
+/* Perfect hashing of frozendict tables ("hash and displace").
+
+The keys are distributed over buckets by PERFECT_BUCKET().  When the
+frozendict is built, each bucket is assigned the smallest displacement d
+for which PERFECT_SLOT(hash, d) of all its keys lands on free, distinct
+slots of the index table; buckets are placed largest first.  A lookup then
+computes the one slot that can hold the key and compares at most one entry,
+whether or not the key is present.
+
+The hash is remixed because the low bits of int and str hashes are not
+random enough for the buckets and slots to be independent.  If no layout is
+found within PERFECT_MAXDISP displacements for some bucket (for instance
+because two keys have the same hash), the table keeps regular probing.
+*/
+#define PERFECT_MAXDISP 0xffff
+#define PERFECT_BUCKET(hash, bmask) \
+    (perfect_mix((size_t)(hash)) & (bmask))
+#define PERFECT_SLOT(hash, disp, mask) \
+    (perfect_mix((size_t)(hash) + ((size_t)(disp) + 1) * 0x9e3779b9U) & (mask))
+
+static inline size_t
+perfect_mix(size_t h)
+{
+#if SIZEOF_SIZE_T > 4
+    h ^= h >> 33;
+    h *= (size_t)0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+#else
+    h ^= h >> 16;
+    h *= (size_t)0x85ebca6bU;
+    h ^= h >> 13;
+#endif
+    return h;
+}
+
+/* Lookup function of frozendict tables with a perfect hash layout. */
+static Py_ssize_t _Py_HOT_FUNCTION
+lookdict_perfect(PyDictObject *mp, PyObject *key,
+                 Py_hash_t hash, PyObject **value_addr)
+{
+    PyFrozenDictObject *fd = (PyFrozenDictObject *)mp;
+    PyDictKeysObject *dk = mp->ma_keys;
+    assert(PyFrozenDict_Check(mp) && fd->fd_disp != NULL);
+    assert(mp->ma_values == NULL);
+
+    size_t b = PERFECT_BUCKET(hash, fd->fd_bucket_mask);
+    size_t i = PERFECT_SLOT(hash, fd->fd_disp[b], DK_MASK(dk));
+    Py_ssize_t ix = dictkeys_get_index(dk, i);
+    assert(ix != DKIX_DUMMY);
+    if (ix >= 0) {
+        PyDictKeyEntry *ep = &DK_ENTRIES(dk)[ix];
+        PyObject *startkey = ep->me_key;
+        assert(startkey != NULL);
+        if (startkey == key) {
+            *value_addr = ep->me_value;
+            return ix;
+        }
+        if (ep->me_hash == hash) {
+            int cmp;
+            if (PyUnicode_CheckExact(startkey) && PyUnicode_CheckExact(key)) {
+                cmp = unicode_eq(startkey, key);
+            }
+            else {
+                Py_INCREF(startkey);
+                cmp = PyObject_RichCompareBool(startkey, key, Py_EQ);
+                Py_DECREF(startkey);
+                if (cmp < 0) {
+                    *value_addr = NULL;
+                    return DKIX_ERROR;
+                }
+            }
+            if (cmp > 0) {
+                *value_addr = ep->me_value;
+                return ix;
+            }
+        }
+    }
+    *value_addr = NULL;
+    return DKIX_EMPTY;
+}
+
 int
 _PyDict_HasOnlyStringKeys(PyObject *dict)
 {
     Py_ssize_t pos = 0;
     PyObject *key, *value;
-    assert(PyDict_Check(dict));
+    assert(PyAnyDict_Check(dict));
     /* Shortcut */
-    if (((PyDictObject *)dict)->ma_keys->dk_lookup != lookdict)
+    dict_lookup_func lookup = ((PyDictObject *)dict)->ma_keys->dk_lookup;
+    if (lookup != lookdict && lookup != lookdict_perfect)
         return 1;
     while (PyDict_Next(dict, &pos, &key, &value))
         if (!PyUnicode_Check(key))
@@ -1084,17 +1245,6 @@ insertdict(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObject *value)
 
     MAINTAIN_TRACKING(mp, key, value);
 
-    /* When insertion order is different from shared key, we can't share
-     * the key anymore.  Convert this instance to combine table.
-     */
-    if (_PyDict_HasSplitTable(mp) &&
-        ((ix >= 0 && old_value == NULL && mp->ma_used != ix) ||
-         (ix == DKIX_EMPTY && mp->ma_used != mp->ma_keys->dk_nentries))) {
-        if (insertion_resize(mp) < 0)
-            goto Fail;
-        ix = DKIX_EMPTY;
-    }
-
     if (ix == DKIX_EMPTY) {
         /* Insert into new slot. */
         assert(old_value == NULL);
@@ -1114,6 +1264,7 @@ insertdict(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObject *value)
         if (mp->ma_values) {
             assert (mp->ma_values[mp->ma_keys->dk_nentries] == NULL);
             mp->ma_values[mp->ma_keys->dk_nentries] = value;
+            SPLIT_ORDER(mp)[mp->ma_used] = (uint8_t)mp->ma_keys->dk_nentries;
         }
         else {
             ep->me_value = value;
@@ -1132,7 +1283,7 @@ insertdict(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObject *value)
             mp->ma_values[ix] = value;
             if (old_value == NULL) {
                 /* pending state */
-                assert(ix == mp->ma_used);
+                SPLIT_ORDER(mp)[mp->ma_used] = (uint8_t)ix;
                 mp->ma_used++;
             }
         }
@@ -1188,6 +1339,52 @@ insert_to_emptydict(PyDictObject *mp, PyObject *key, Py_hash_t hash,
     return 0;
 }
 
+/* Make room for n more items in mp, so that inserting them doesn't resize
+   the table.  A split table is left alone, since adding keys to it combines
+   it anyway.  Like _PyDict_NewPresized(), don't trust very large counts:
+   they may come from a length hint. */
+static int
+dict_reserve(PyDictObject *mp, Py_ssize_t n)
+{
+    const Py_ssize_t max_presize = 128 * 1024;
+
+    if (mp->ma_values != NULL && mp->ma_values != empty_values) {
+        return 0;
+    }
+    n = Py_MIN(n, USABLE_FRACTION(max_presize));
+    if (n <= 0 || mp->ma_keys->dk_usable >= n) {
+        return 0;
+    }
+    return dictresize(mp, estimate_keysize(mp->ma_used + n));
+}
+
+/* Append an item whose key is known not to be in the combined table of mp,
+   which must have room for it: no lookup and no resize check is needed.
+   The caller updates ma_version_tag once all the items are in. */
+static void
+insert_unique(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObject *value)
+{
+    PyDictKeysObject *keys = mp->ma_keys;
+
+    assert(mp->ma_values == NULL);
+    assert(keys->dk_usable > 0);
+    Py_INCREF(key);
+    Py_INCREF(value);
+    MAINTAIN_TRACKING(mp, key, value);
+    if (!PyUnicode_CheckExact(key) && keys->dk_lookup != lookdict) {
+        keys->dk_lookup = lookdict;
+    }
+    Py_ssize_t hashpos = find_empty_slot(keys, hash);
+    PyDictKeyEntry *ep = &DK_ENTRIES(keys)[keys->dk_nentries];
+    dictkeys_set_index(keys, hashpos, keys->dk_nentries);
+    ep->me_key = key;
+    ep->me_hash = hash;
+    ep->me_value = value;
+    mp->ma_used++;
+    keys->dk_usable--;
+    keys->dk_nentries++;
+}
+
 /*
 Internal routine used by dictresize() to build a hashtable of entries.
 */
@@ -1229,7 +1426,7 @@ dictresize(PyDictObject *mp, Py_ssize_t newsize)
         return -1;
     }
     assert(IS_POWER_OF_2(newsize));
-    assert(newsize >= PyDict_MINSIZE);
+    assert(newsize >= PyDict_TINYSIZE);
 
     oldkeys = mp->ma_keys;
 
@@ -1256,16 +1453,19 @@ dictresize(PyDictObject *mp, Py_ssize_t newsize)
     if (oldvalues != NULL) {
         /* Convert split table into new combined table.
          * We must incref keys; we can transfer values.
-         * Note that values of split table is always dense.
+         * Entries are copied in this dict's insertion order.
          */
+        uint8_t *order = (uint8_t *)(oldvalues +
+                                     USABLE_FRACTION(DK_SIZE(oldkeys)));
         for (Py_ssize_t i = 0; i < numentries; i++) {
-            assert(oldvalues[i] != NULL);
-            PyDictKeyEntry *ep = &oldentries[i];
+            Py_ssize_t ix = order[i];
+            assert(oldvalues[ix] != NULL);
+            PyDictKeyEntry *ep = &oldentries[ix];
             PyObject *key = ep->me_key;
             Py_INCREF(key);
             newentries[i].me_key = key;
             newentries[i].me_hash = ep->me_hash;
-            newentries[i].me_value = oldvalues[i];
+            newentries[i].me_value = oldvalues[ix];
         }
 
         dictkeys_decref(oldkeys);
@@ -1302,6 +1502,11 @@ dictresize(PyDictObject *mp, Py_ssize_t newsize)
         {
             state->keys_free_list[state->keys_numfree++] = oldkeys;
         }
+        else if (oldkeys->dk_size == PyDict_TINYSIZE &&
+                 state->tiny_keys_numfree < PyDict_MAXFREELIST)
+        {
+            state->tiny_keys_free_list[state->tiny_keys_numfree++] = oldkeys;
+        }
         else {
             PyObject_Free(oldkeys);
         }
@@ -1328,7 +1533,8 @@ make_keys_shared(PyObject *op)
         PyDictKeyEntry *ep0;
         PyObject **values;
         assert(mp->ma_keys->dk_refcnt == 1);
-        if (mp->ma_keys->dk_lookup == lookdict) {
+        if (mp->ma_keys->dk_lookup == lookdict ||
+            DK_SIZE(mp->ma_keys) > SPLIT_KEYS_MAXSIZE) {
             return NULL;
         }
         else if (mp->ma_keys->dk_lookup == lookdict_unicode) {
@@ -1352,6 +1558,9 @@ make_keys_shared(PyObject *op)
         }
         mp->ma_keys->dk_lookup = lookdict_split;
         mp->ma_values = values;
+        for (i = 0; i < mp->ma_used; i++) {
+            SPLIT_ORDER(mp)[i] = (uint8_t)i;
+        }
     }
     dictkeys_incref(mp->ma_keys);
     return mp->ma_keys;
@@ -1365,7 +1574,11 @@ _PyDict_NewPresized(Py_ssize_t minused)
     PyDictKeysObject *new_keys;
 
     if (minused <= USABLE_FRACTION(PyDict_MINSIZE)) {
-        return PyDict_New();
+        /* Let the first insertion allocate the PyDict_MINSIZE table, usually
+           from the free list, unless a tiny one is enough. */
+        if (minused <= 0 || minused > USABLE_FRACTION(PyDict_TINYSIZE)) {
+            return PyDict_New();
+        }
     }
     /* There are no strict guarantee that returned dict can contain minused
      * items without resize.  So we create medium size dict instead of very
@@ -1384,6 +1597,50 @@ _PyDict_NewPresized(Py_ssize_t minused)
     return new_dict(new_keys, NULL);
 }
 
+/* Build a dict from length keys and values, read every keys_offset and
+   values_offset items of the two arrays.  The table is sized once for all
+   the items; later duplicate keys replace earlier ones. */
+PyObject *
+_PyDict_FromItems(PyObject *const *keys, Py_ssize_t keys_offset,
+                  PyObject *const *values, Py_ssize_t values_offset,
+                  Py_ssize_t length)
+{
+    PyObject *dict = _PyDict_NewPresized(length);
+    if (dict == NULL) {
+        return NULL;
+    }
+    PyDictObject *mp = (PyDictObject *)dict;
+
+    for (Py_ssize_t i = 0; i < length; i++) {
+        PyObject *key = *keys;
+        PyObject *value = *values;
+        Py_hash_t hash;
+        int err;
+
+        if (!PyUnicode_CheckExact(key) ||
+            (hash = ((PyASCIIObject *) key)->hash) == -1) {
+            hash = PyObject_Hash(key);
+            if (hash == -1) {
+                Py_DECREF(dict);
+                return NULL;
+            }
+        }
+        if (mp->ma_keys == Py_EMPTY_KEYS) {
+            err = insert_to_emptydict(mp, key, hash, value);
+        }
+        else {
+            err = insertdict(mp, key, hash, value);
+        }
+        if (err < 0) {
+            Py_DECREF(dict);
+            return NULL;
+        }
+        keys += keys_offset;
+        values += values_offset;
+    }
+    return dict;
+}
+
 /* Note that, for historical reasons, PyDict_GetItem() suppresses all errors
  * that may occur (originally dicts supported only string keys, and exceptions
  * weren't possible).  So, while the original intent was that a NULL return
@@ -1397,7 +1654,7 @@ _PyDict_NewPresized(Py_ssize_t minused)
 PyObject *
 PyDict_GetItem(PyObject *op, PyObject *key)
 {
-    if (!PyDict_Check(op)) {
+    if (!PyAnyDict_Check(op)) {
         return NULL;
     }
     PyDictObject *mp = (PyDictObject *)op;
@@ -1475,6 +1732,48 @@ _PyDict_GetItemHint(PyDictObject *mp, PyObject *key,
     return (mp->ma_keys->dk_lookup)(mp, key, hash, value);
 }
 
+/* Replace the value of an existing str key using a hint previously returned
+   by _PyDict_GetItemHint().  Return the hint if the value was stored, or -1
+   if the hint is stale; the caller must then fall back to the generic path.
+   Never raises an exception. */
+Py_ssize_t
+_PyDict_SetItemHint(PyDictObject *mp, PyObject *key,
+                    Py_ssize_t hint, PyObject *value)
+{
+    assert(PyDict_CheckExact((PyObject*)mp));
+    assert(PyUnicode_CheckExact(key));
+    assert(value != NULL);
+
+    if (hint < 0 || hint >= mp->ma_keys->dk_nentries) {
+        return -1;
+    }
+    PyDictKeyEntry *ep = DK_ENTRIES(mp->ma_keys) + (size_t)hint;
+    if (ep->me_key != key) {
+        return -1;
+    }
+
+    PyObject **slot;
+    if (_PyDict_HasSplitTable(mp)) {
+        slot = &mp->ma_values[(size_t)hint];
+    }
+    else {
+        slot = &ep->me_value;
+    }
+    PyObject *old_value = *slot;
+    if (old_value == NULL) {
+        /* Deleted or pending entry of a split table: let insertdict()
+           maintain the shared key ordering. */
+        return -1;
+    }
+
+    Py_INCREF(value);
+    MAINTAIN_TRACKING(mp, key, value);
+    *slot = value;
+    mp->ma_version_tag = DICT_NEXT_VERSION();
+    Py_DECREF(old_value); /* which **CAN** re-enter (see issue #22653) */
+    return hint;
+}
+
 /* Same as PyDict_GetItemWithError() but with hash supplied by caller.
    This returns NULL *with* an exception set if an exception occurred.
    It returns NULL *without* an exception set if the key wasn't present.
@@ -1486,7 +1785,7 @@ _PyDict_GetItem_KnownHash(PyObject *op, PyObject *key, Py_hash_t hash)
     PyDictObject *mp = (PyDictObject *)op;
     PyObject *value;
 
-    if (!PyDict_Check(op)) {
+    if (!PyAnyDict_Check(op)) {
         PyErr_BadInternalCall();
         return NULL;
     }
@@ -1510,7 +1809,7 @@ PyDict_GetItemWithError(PyObject *op, PyObject *key)
     PyDictObject*mp = (PyDictObject *)op;
     PyObject *value;
 
-    if (!PyDict_Check(op)) {
+    if (!PyAnyDict_Check(op)) {
         PyErr_BadInternalCall();
         return NULL;
     }
@@ -1707,13 +2006,11 @@ _PyDict_DelItem_KnownHash(PyObject *op, PyObject *key, Py_hash_t hash)
         return -1;
     }
 
-    // Split table doesn't allow deletion.  Combine it.
     if (_PyDict_HasSplitTable(mp)) {
-        if (dictresize(mp, DK_SIZE(mp->ma_keys))) {
-            return -1;
-        }
-        ix = (mp->ma_keys->dk_lookup)(mp, key, hash, &old_value);
-        assert(ix >= 0);
+        split_values_remove(mp, ix);
+        Py_DECREF(old_value);
+        ASSERT_CONSISTENT(mp);
+        return 0;
     }
 
     return delitem_common(mp, hash, ix, old_value);
@@ -1750,19 +2047,19 @@ _PyDict_DelItemIf(PyObject *op, PyObject *key,
         return -1;
     }
 
-    // Split table doesn't allow deletion.  Combine it.
-    if (_PyDict_HasSplitTable(mp)) {
-        if (dictresize(mp, DK_SIZE(mp->ma_keys))) {
-            return -1;
-        }
-        ix = (mp->ma_keys->dk_lookup)(mp, key, hash, &old_value);
-        assert(ix >= 0);
-    }
-
     res = predicate(old_value);
     if (res == -1)
         return -1;
 
+    if (_PyDict_HasSplitTable(mp)) {
+        if (res > 0) {
+            split_values_remove(mp, ix);
+            Py_DECREF(old_value);
+            ASSERT_CONSISTENT(mp);
+        }
+        return 0;
+    }
+
     hashpos = lookdict_index(mp->ma_keys, hash, ix);
     assert(hashpos >= 0);
 
@@ -1773,17 +2070,13 @@ _PyDict_DelItemIf(PyObject *op, PyObject *key,
 }
 
 
-void
-PyDict_Clear(PyObject *op)
+static void
+clear_dict(PyDictObject *mp)
 {
-    PyDictObject *mp;
     PyDictKeysObject *oldkeys;
     PyObject **oldvalues;
     Py_ssize_t i, n;
 
-    if (!PyDict_Check(op))
-        return;
-    mp = ((PyDictObject *)op);
     oldkeys = mp->ma_keys;
     oldvalues = mp->ma_values;
     if (oldvalues == empty_values)
@@ -1809,6 +2102,14 @@ PyDict_Clear(PyObject *op)
     ASSERT_CONSISTENT(mp);
 }
 
+void
+PyDict_Clear(PyObject *op)
+{
+    if (!PyDict_Check(op))
+        return;
+    clear_dict((PyDictObject *)op);
+}
+
 /* Internal version of PyDict_Next that returns a hash value in addition
  * to the key and value.
  * Return 1 on success, return 0 when the reached the end of the dictionary
@@ -1823,16 +2124,16 @@ _PyDict_Next(PyObject *op, Py_ssize_t *ppos, PyObject **pkey,
     PyDictKeyEntry *entry_ptr;
     PyObject *value;
 
-    if (!PyDict_Check(op))
+    if (!PyAnyDict_Check(op))
         return 0;
     mp = (PyDictObject *)op;
     i = *ppos;
     if (mp->ma_values) {
         if (i < 0 || i >= mp->ma_used)
             return 0;
-        /* values of split table is always dense */
-        entry_ptr = &DK_ENTRIES(mp->ma_keys)[i];
-        value = mp->ma_values[i];
+        Py_ssize_t ix = SPLIT_ORDER(mp)[i];
+        entry_ptr = &DK_ENTRIES(mp->ma_keys)[ix];
+        value = mp->ma_values[ix];
         assert(value != NULL);
     }
     else {
@@ -1914,13 +2215,10 @@ _PyDict_Pop_KnownHash(PyObject *dict, PyObject *key, Py_hash_t hash, PyObject *d
         return NULL;
     }
 
-    // Split table doesn't allow deletion.  Combine it.
     if (_PyDict_HasSplitTable(mp)) {
-        if (dictresize(mp, DK_SIZE(mp->ma_keys))) {
-            return NULL;
-        }
-        ix = (mp->ma_keys->dk_lookup)(mp, key, hash, &old_value);
-        assert(ix >= 0);
+        split_values_remove(mp, ix);
+        ASSERT_CONSISTENT(mp);
+        return old_value;
     }
 
     hashpos = lookdict_index(mp->ma_keys, hash, ix);
@@ -2052,16 +2350,15 @@ _PyDict_FromKeys(PyObject *cls, PyObject *iterable, PyObject *value)
 
 /* Methods */
 
+/* Release the contents of mp and free it.  The caller untracks mp and
+   wraps this in its own trashcan, keyed on its own tp_dealloc. */
 static void
-dict_dealloc(PyDictObject *mp)
+dict_dealloc_contents(PyDictObject *mp)
 {
     PyObject **values = mp->ma_values;
     PyDictKeysObject *keys = mp->ma_keys;
     Py_ssize_t i, n;
 
-    /* bpo-31095: UnTrack is needed before calling any callbacks */
-    PyObject_GC_UnTrack(mp);
-    Py_TRASHCAN_BEGIN(mp, dict_dealloc)
     if (values != NULL) {
         if (values != empty_values) {
             for (i = 0, n = mp->ma_keys->dk_nentries; i < n; i++) {
@@ -2086,6 +2383,15 @@ dict_dealloc(PyDictObject *mp)
     else {
         Py_TYPE(mp)->tp_free((PyObject *)mp);
     }
+}
+
+static void
+dict_dealloc(PyDictObject *mp)
+{
+    /* bpo-31095: UnTrack is needed before calling any callbacks */
+    PyObject_GC_UnTrack(mp);
+    Py_TRASHCAN_BEGIN(mp, dict_dealloc)
+    dict_dealloc_contents(mp);
     Py_TRASHCAN_END
 }
 
@@ -2254,13 +2560,16 @@ dict_keys(PyDictObject *mp)
     }
     ep = DK_ENTRIES(mp->ma_keys);
     if (mp->ma_values) {
-        value_ptr = mp->ma_values;
-        offset = sizeof(PyObject *);
-    }
-    else {
-        value_ptr = &ep[0].me_value;
-        offset = sizeof(PyDictKeyEntry);
+        uint8_t *order = SPLIT_ORDER(mp);
+        for (j = 0; j < n; j++) {
+            PyObject *key = ep[order[j]].me_key;
+            Py_INCREF(key);
+            PyList_SET_ITEM(v, j, key);
+        }
+        return v;
     }
+    value_ptr = &ep[0].me_value;
+    offset = sizeof(PyDictKeyEntry);
     for (i = 0, j = 0; j < n; i++) {
         if (*value_ptr != NULL) {
             PyObject *key = ep[i].me_key;
@@ -2297,13 +2606,16 @@ dict_values(PyDictObject *mp)
     }
     ep = DK_ENTRIES(mp->ma_keys);
     if (mp->ma_values) {
-        value_ptr = mp->ma_values;
-        offset = sizeof(PyObject *);
-    }
-    else {
-        value_ptr = &ep[0].me_value;
-        offset = sizeof(PyDictKeyEntry);
+        uint8_t *order = SPLIT_ORDER(mp);
+        for (j = 0; j < n; j++) {
+            PyObject *value = mp->ma_values[order[j]];
+            Py_INCREF(value);
+            PyList_SET_ITEM(v, j, value);
+        }
+        return v;
     }
+    value_ptr = &ep[0].me_value;
+    offset = sizeof(PyDictKeyEntry);
     for (i = 0, j = 0; j < n; i++) {
         PyObject *value = *value_ptr;
         value_ptr = (PyObject **)(((char *)value_ptr) + offset);
@@ -2354,13 +2666,20 @@ dict_items(PyDictObject *mp)
     /* Nothing we do below makes any function calls. */
     ep = DK_ENTRIES(mp->ma_keys);
     if (mp->ma_values) {
-        value_ptr = mp->ma_values;
-        offset = sizeof(PyObject *);
-    }
-    else {
-        value_ptr = &ep[0].me_value;
-        offset = sizeof(PyDictKeyEntry);
+        uint8_t *order = SPLIT_ORDER(mp);
+        for (j = 0; j < n; j++) {
+            PyObject *value = mp->ma_values[order[j]];
+            key = ep[order[j]].me_key;
+            item = PyList_GET_ITEM(v, j);
+            Py_INCREF(key);
+            PyTuple_SET_ITEM(item, 0, key);
+            Py_INCREF(value);
+            PyTuple_SET_ITEM(item, 1, value);
+        }
+        return v;
     }
+    value_ptr = &ep[0].me_value;
+    offset = sizeof(PyDictKeyEntry);
     for (i = 0, j = 0; j < n; i++) {
         PyObject *value = *value_ptr;
         value_ptr = (PyObject **)(((char *)value_ptr) + offset);
@@ -2474,6 +2793,13 @@ PyDict_MergeFromSeq2(PyObject *d, PyObject *seq2, int override)
     if (it == NULL)
         return -1;
 
+    /* Size the table once for all the expected items */
+    i = PyObject_LengthHint(seq2, 0);
+    if (i < 0 || dict_reserve((PyDictObject *)d, i) < 0) {
+        Py_DECREF(it);
+        return -1;
+    }
+
     for (i = 0; ; ++i) {
         PyObject *key, *value;
         Py_ssize_t n;
@@ -2562,7 +2888,7 @@ dict_merge(PyObject *a, PyObject *b, int override)
         return -1;
     }
     mp = (PyDictObject*)a;
-    if (PyDict_Check(b) && (Py_TYPE(b)->tp_iter == (getiterfunc)dict_iter)) {
+    if (PyAnyDict_Check(b) && (Py_TYPE(b)->tp_iter == (getiterfunc)dict_iter)) {
         other = (PyDictObject*)b;
         if (other == mp || other->ma_used == 0)
             /* a.update(a) or a.update({}); nothing to do */
@@ -2577,8 +2903,11 @@ dict_merge(PyObject *a, PyObject *b, int override)
 
             // If other is clean, combined, and just allocated, just clone it.
             if (other->ma_values == NULL &&
+                    okeys->dk_lookup != lookdict_perfect &&
                     other->ma_used == okeys->dk_nentries &&
-                    (okeys->dk_size == PyDict_MINSIZE ||
+                    (okeys->dk_size == PyDict_TINYSIZE ||
+                     (okeys->dk_size == PyDict_MINSIZE &&
+                      other->ma_used > USABLE_FRACTION(PyDict_TINYSIZE)) ||
                      USABLE_FRACTION(okeys->dk_size/2) < other->ma_used)) {
                 PyDictKeysObject *keys = clone_combined_dict_keys(other);
                 if (keys == NULL) {
@@ -2605,27 +2934,64 @@ dict_merge(PyObject *a, PyObject *b, int override)
 
                 return 0;
             }
+
+            /* The keys of other are distinct and none is in the target:
+               size the table once and append the items without lookups.
+               No Python code runs meanwhile, so other can't change. */
+            if ((mp->ma_values != NULL ||
+                 mp->ma_keys->dk_usable < other->ma_used) &&
+                dictresize(mp, estimate_keysize(other->ma_used)) < 0) {
+                return -1;
+            }
+            ep0 = DK_ENTRIES(okeys);
+            n = other->ma_values ? other->ma_used : okeys->dk_nentries;
+            for (i = 0; i < n; i++) {
+                PyObject *value;
+                if (other->ma_values) {
+                    Py_ssize_t ix = SPLIT_ORDER(other)[i];
+                    entry = &ep0[ix];
+                    value = other->ma_values[ix];
+                }
+                else {
+                    entry = &ep0[i];
+                    value = entry->me_value;
+                }
+                if (value != NULL) {
+                    insert_unique(mp, entry->me_key, entry->me_hash, value);
+                }
+            }
+            mp->ma_version_tag = DICT_NEXT_VERSION();
+            ASSERT_CONSISTENT(mp);
+            return 0;
         }
         /* Do one big resize at the start, rather than
          * incrementally resizing as we insert new items.  Expect
          * that there will be no (or few) overlapping keys.
          */
-        if (USABLE_FRACTION(mp->ma_keys->dk_size) < other->ma_used) {
+        if (USABLE_FRACTION(mp->ma_keys->dk_size) < other->ma_used ||
+            (mp->ma_values == NULL && mp->ma_keys->dk_usable < other->ma_used)) {
             if (dictresize(mp, estimate_keysize(mp->ma_used + other->ma_used))) {
                return -1;
             }
         }
-        ep0 = DK_ENTRIES(other->ma_keys);
-        for (i = 0, n = other->ma_keys->dk_nentries; i < n; i++) {
+        PyDictKeysObject *okeys = other->ma_keys;
+        ep0 = DK_ENTRIES(okeys);
+        /* A split table is walked in its own insertion order. */
+        n = other->ma_values ? other->ma_used : okeys->dk_nentries;
+        for (i = 0; i < n; i++) {
             PyObject *key, *value;
             Py_hash_t hash;
-            entry = &ep0[i];
+            if (other->ma_values) {
+                Py_ssize_t ix = SPLIT_ORDER(other)[i];
+                entry = &ep0[ix];
+                value = other->ma_values[ix];
+            }
+            else {
+                entry = &ep0[i];
+                value = entry->me_value;
+            }
             key = entry->me_key;
             hash = entry->me_hash;
-            if (other->ma_values)
-                value = other->ma_values[i];
-            else
-                value = entry->me_value;
 
             if (value != NULL) {
                 int err = 0;
@@ -2653,7 +3019,9 @@ dict_merge(PyObject *a, PyObject *b, int override)
                 if (err != 0)
                     return -1;
 
-                if (n != other->ma_keys->dk_nentries) {
+                if (okeys != other->ma_keys ||
+                    n != (other->ma_values ? other->ma_used
+                                           : okeys->dk_nentries)) {
                     PyErr_SetString(PyExc_RuntimeError,
                                     "dict mutated during update");
                     return -1;
@@ -2676,6 +3044,11 @@ dict_merge(PyObject *a, PyObject *b, int override)
              */
             return -1;
 
+        if (PyList_CheckExact(keys) &&
+            dict_reserve(mp, PyList_GET_SIZE(keys)) < 0) {
+            Py_DECREF(keys);
+            return -1;
+        }
         iter = PyObject_GetIter(keys);
         Py_DECREF(keys);
         if (iter == NULL)
@@ -2752,7 +3125,7 @@ PyDict_Copy(PyObject *o)
     PyDictObject *mp;
     Py_ssize_t i, n;
 
-    if (o == NULL || !PyDict_Check(o)) {
+    if (o == NULL || !PyAnyDict_Check(o)) {
         PyErr_BadInternalCall();
         return NULL;
     }
@@ -2785,6 +3158,7 @@ PyDict_Copy(PyObject *o)
             Py_XINCREF(value);
             split_copy->ma_values[i] = value;
         }
+        memcpy(SPLIT_ORDER(split_copy), SPLIT_ORDER(mp), mp->ma_used);
         if (_PyObject_GC_IS_TRACKED(mp))
             _PyObject_GC_TRACK(split_copy);
         return (PyObject *)split_copy;
@@ -2792,18 +3166,24 @@ PyDict_Copy(PyObject *o)
 
     if (Py_TYPE(mp)->tp_iter == (getiterfunc)dict_iter &&
             mp->ma_values == NULL &&
-            (mp->ma_used >= (mp->ma_keys->dk_nentries * 2) / 3))
+            mp->ma_keys->dk_lookup != lookdict_perfect &&
+            (mp->ma_used >= (mp->ma_keys->dk_nentries * 2) / 3) &&
+            (mp->ma_used > USABLE_FRACTION(PyDict_TINYSIZE) ||
+             mp->ma_keys->dk_size == PyDict_TINYSIZE))
     {
         /* Use fast-copy if:
 
            (1) type(mp) doesn't override tp_iter; and
 
-           (2) 'mp' is not a split-dict; and
+           (2) 'mp' is not a split-dict nor a frozendict with a perfect
+               hash layout; and
 
            (3) if 'mp' is non-compact ('del' operation does not resize dicts),
                do fast-copy only if it has at most 1/3 non-used keys.
 
-           The last condition (3) is important to guard against a pathological
+           (4) 'mp' doesn't fit in a smaller PyDict_TINYSIZE table.
+
+           The condition (3) is important to guard against a pathological
            case when a large dict is almost emptied with multiple del/pop
            operations and copied after that.  In cases like this, we defer to
            PyDict_Merge, which produces a compacted copy.
@@ -2841,7 +3221,7 @@ PyDict_Copy(PyObject *o)
 Py_ssize_t
 PyDict_Size(PyObject *mp)
 {
-    if (mp == NULL || !PyDict_Check(mp)) {
+    if (mp == NULL || !PyAnyDict_Check(mp)) {
         PyErr_BadInternalCall();
         return -1;
     }
@@ -2851,7 +3231,7 @@ PyDict_Size(PyObject *mp)
 PyObject *
 PyDict_Keys(PyObject *mp)
 {
-    if (mp == NULL || !PyDict_Check(mp)) {
+    if (mp == NULL || !PyAnyDict_Check(mp)) {
         PyErr_BadInternalCall();
         return NULL;
     }
@@ -2861,7 +3241,7 @@ PyDict_Keys(PyObject *mp)
 PyObject *
 PyDict_Values(PyObject *mp)
 {
-    if (mp == NULL || !PyDict_Check(mp)) {
+    if (mp == NULL || !PyAnyDict_Check(mp)) {
         PyErr_BadInternalCall();
         return NULL;
     }
@@ -2871,7 +3251,7 @@ PyDict_Values(PyObject *mp)
 PyObject *
 PyDict_Items(PyObject *mp)
 {
-    if (mp == NULL || !PyDict_Check(mp)) {
+    if (mp == NULL || !PyAnyDict_Check(mp)) {
         PyErr_BadInternalCall();
         return NULL;
     }
@@ -2934,7 +3314,7 @@ dict_richcompare(PyObject *v, PyObject *w, int op)
     int cmp;
     PyObject *res;
 
-    if (!PyDict_Check(v) || !PyDict_Check(w)) {
+    if (!PyAnyDict_Check(v) || !PyAnyDict_Check(w)) {
         res = Py_NotImplemented;
     }
     else if (op == Py_EQ || op == Py_NE) {
@@ -3051,15 +3431,6 @@ PyDict_SetDefault(PyObject *d, PyObject *key, PyObject *defaultobj)
     if (ix == DKIX_ERROR)
         return NULL;
 
-    if (_PyDict_HasSplitTable(mp) &&
-        ((ix >= 0 && value == NULL && mp->ma_used != ix) ||
-         (ix == DKIX_EMPTY && mp->ma_used != mp->ma_keys->dk_nentries))) {
-        if (insertion_resize(mp) < 0) {
-            return NULL;
-        }
-        ix = DKIX_EMPTY;
-    }
-
     if (ix == DKIX_EMPTY) {
         PyDictKeyEntry *ep, *ep0;
         value = defaultobj;
@@ -3083,6 +3454,7 @@ PyDict_SetDefault(PyObject *d, PyObject *key, PyObject *defaultobj)
         if (_PyDict_HasSplitTable(mp)) {
             assert(mp->ma_values[mp->ma_keys->dk_nentries] == NULL);
             mp->ma_values[mp->ma_keys->dk_nentries] = value;
+            SPLIT_ORDER(mp)[mp->ma_used] = (uint8_t)mp->ma_keys->dk_nentries;
         }
         else {
             ep->me_value = value;
@@ -3096,10 +3468,10 @@ PyDict_SetDefault(PyObject *d, PyObject *key, PyObject *defaultobj)
     else if (value == NULL) {
         value = defaultobj;
         assert(_PyDict_HasSplitTable(mp));
-        assert(ix == mp->ma_used);
         Py_INCREF(value);
         MAINTAIN_TRACKING(mp, key, value);
         mp->ma_values[ix] = value;
+        SPLIT_ORDER(mp)[mp->ma_used] = (uint8_t)ix;
         mp->ma_used++;
         mp->ma_version_tag = DICT_NEXT_VERSION();
     }
@@ -3193,17 +3565,22 @@ dict_popitem_impl(PyDictObject *self)
         PyErr_SetString(PyExc_KeyError, "popitem(): dictionary is empty");
         return NULL;
     }
-    /* Convert split table to combined table */
-    if (self->ma_keys->dk_lookup == lookdict_split) {
-        if (dictresize(self, DK_SIZE(self->ma_keys))) {
-            Py_DECREF(res);
-            return NULL;
-        }
+    ep0 = DK_ENTRIES(self->ma_keys);
+    if (self->ma_values) {
+        /* Pop the last inserted value; the shared key stays in place */
+        i = SPLIT_ORDER(self)[self->ma_used - 1];
+        Py_INCREF(ep0[i].me_key);
+        PyTuple_SET_ITEM(res, 0, ep0[i].me_key);
+        PyTuple_SET_ITEM(res, 1, self->ma_values[i]);
+        self->ma_values[i] = NULL;
+        self->ma_used--;
+        self->ma_version_tag = DICT_NEXT_VERSION();
+        ASSERT_CONSISTENT(self);
+        return res;
     }
     ENSURE_ALLOWS_DELETIONS(self);
 
     /* Pop last item */
-    ep0 = DK_ENTRIES(self->ma_keys);
     i = self->ma_keys->dk_nentries - 1;
     while (i >= 0 && ep0[i].me_value == NULL) {
         i--;
@@ -3236,7 +3613,7 @@ dict_traverse(PyObject *op, visitproc visit, void *arg)
     PyDictKeyEntry *entries = DK_ENTRIES(keys);
     Py_ssize_t i, n = keys->dk_nentries;
 
-    if (keys->dk_lookup == lookdict) {
+    if (keys->dk_lookup == lookdict || keys->dk_lookup == lookdict_perfect) {
         for (i = 0; i < n; i++) {
             if (entries[i].me_value != NULL) {
                 Py_VISIT(entries[i].me_value);
@@ -3278,7 +3655,7 @@ _PyDict_SizeOf(PyDictObject *mp)
 
     res = _PyObject_SIZE(Py_TYPE(mp));
     if (mp->ma_values)
-        res += usable * sizeof(PyObject*);
+        res += usable * (sizeof(PyObject*) + 1);
     /* If the dictionary is split, the keys portion is accounted-for
        in the type object. */
     if (mp->ma_keys->dk_refcnt == 1)
@@ -3305,7 +3682,7 @@ dict_sizeof(PyDictObject *mp, PyObject *Py_UNUSED(ignored))
 static PyObject *
 dict_or(PyObject *self, PyObject *other)
 {
-    if (!PyDict_Check(self) || !PyDict_Check(other)) {
+    if (!PyAnyDict_Check(self) || !PyAnyDict_Check(other)) {
         Py_RETURN_NOTIMPLEMENTED;
     }
     PyObject *new = PyDict_Copy(self);
@@ -3504,7 +3881,15 @@ dict_vectorcall(PyObject *type, PyObject * const*args,
         args++;
     }
     if (kwnames != NULL) {
-        for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(kwnames); i++) {
+        PyDictObject *mp = (PyDictObject *)self;
+        Py_ssize_t nkw = PyTuple_GET_SIZE(kwnames);
+        if (mp->ma_used == 0 && USABLE_FRACTION(DK_SIZE(mp->ma_keys)) < nkw) {
+            if (dictresize(mp, estimate_keysize(nkw))) {
+                Py_DECREF(self);
+                return NULL;
+            }
+        }
+        for (Py_ssize_t i = 0; i < nkw; i++) {
             if (PyDict_SetItem(self, PyTuple_GET_ITEM(kwnames, i), args[i]) < 0) {
                 Py_DECREF(self);
                 return NULL;
@@ -3576,6 +3961,459 @@ PyTypeObject PyDict_Type = {
     .tp_vectorcall = dict_vectorcall,
 };
 
+/* frozendict implementation */
+
+/* A bucket holding more keys than this is almost certainly made of keys
+   with equal hashes; don't bother searching for a perfect layout. */
+#define PERFECT_MAXBUCKET 32
+
+/* Find the displacement of a bucket and set the indices of its entries.
+   Return 1 on success, 0 if there is no displacement that fits. */
+static int
+perfect_place_bucket(PyDictKeysObject *dk, const Py_ssize_t *members,
+                     Py_ssize_t size, uint16_t *pdisp)
+{
+    PyDictKeyEntry *ep0 = DK_ENTRIES(dk);
+    size_t mask = DK_MASK(dk);
+    Py_ssize_t j, k;
+
+    for (k = 1; k < size; k++) {
+        for (j = 0; j < k; j++) {
+            if (ep0[members[j]].me_hash == ep0[members[k]].me_hash) {
+                return 0;
+            }
+        }
+    }
+    for (size_t d = 0; d <= PERFECT_MAXDISP; d++) {
+        for (k = 0; k < size; k++) {
+            size_t i = PERFECT_SLOT(ep0[members[k]].me_hash, d, mask);
+            if (dictkeys_get_index(dk, i) != DKIX_EMPTY) {
+                break;
+            }
+            dictkeys_set_index(dk, i, members[k]);
+        }
+        if (k == size) {
+            *pdisp = (uint16_t)d;
+            return 1;
+        }
+        /* Undo the partial placement */
+        while (--k >= 0) {
+            size_t i = PERFECT_SLOT(ep0[members[k]].me_hash, d, mask);
+            dictkeys_set_index(dk, i, DKIX_EMPTY);
+        }
+    }
+    return 0;
+}
+
+/* Compact the table of a new frozendict and give it a perfect hash layout
+   if one can be found.  Return -1 on memory error. */
+static int
+frozendict_build_layout(PyFrozenDictObject *fd)
+{
+    PyDictObject *mp = &fd->fd_dict;
+    Py_ssize_t n = mp->ma_used;
+    Py_ssize_t ix, sz, maxsz;
+    size_t b;
+
+    assert(fd->fd_disp == NULL);
+    if (n == 0) {
+        return 0;
+    }
+    if (mp->ma_values != NULL || mp->ma_keys->dk_nentries != n ||
+        DK_SIZE(mp->ma_keys) != estimate_keysize(n)) {
+        if (dictresize(mp, estimate_keysize(n)) < 0) {
+            return -1;
+        }
+    }
+
+    PyDictKeysObject *dk = mp->ma_keys;
+    PyDictKeyEntry *ep0 = DK_ENTRIES(dk);
+    size_t nbuckets = (size_t)DK_SIZE(dk) / 2;
+    size_t bmask = nbuckets - 1;
+
+    uint16_t *disp = PyMem_New(uint16_t, nbuckets);
+    /* The entries of bucket b are members[start[b]:start[b+1]] */
+    Py_ssize_t *start = PyMem_New(Py_ssize_t, nbuckets + 1);
+    Py_ssize_t *members = PyMem_New(Py_ssize_t, n);
+    if (disp == NULL || start == NULL || members == NULL) {
+        PyMem_Free(disp);
+        PyMem_Free(start);
+        PyMem_Free(members);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    memset(start, 0, (nbuckets + 1) * sizeof(Py_ssize_t));
+    for (ix = 0; ix < n; ix++) {
+        start[PERFECT_BUCKET(ep0[ix].me_hash, bmask) + 1]++;
+    }
+    maxsz = 0;
+    for (b = 0; b < nbuckets; b++) {
+        maxsz = Py_MAX(maxsz, start[b + 1]);
+        start[b + 1] += start[b];
+    }
+    if (maxsz > PERFECT_MAXBUCKET) {
+        goto fail;
+    }
+    for (ix = 0; ix < n; ix++) {
+        members[start[PERFECT_BUCKET(ep0[ix].me_hash, bmask)]++] = ix;
+    }
+    for (b = nbuckets; b > 0; b--) {
+        start[b] = start[b - 1];
+    }
+    start[0] = 0;
+
+    memset(dk->dk_indices, 0xff, DK_SIZE(dk) * DK_IXSIZE(dk));
+    for (b = 0; b < nbuckets; b++) {
+        disp[b] = 0;
+    }
+    /* Place the largest buckets first, while the table is still empty */
+    for (sz = maxsz; sz > 0; sz--) {
+        for (b = 0; b < nbuckets; b++) {
+            if (start[b + 1] - start[b] == sz &&
+                !perfect_place_bucket(dk, members + start[b], sz, &disp[b])) {
+                memset(dk->dk_indices, 0xff, DK_SIZE(dk) * DK_IXSIZE(dk));
+                build_indices(dk, ep0, n);
+                goto fail;
+            }
+        }
+    }
+    PyMem_Free(start);
+    PyMem_Free(members);
+    dk->dk_lookup = lookdict_perfect;
+    fd->fd_bucket_mask = bmask;
+    fd->fd_disp = disp;
+    return 0;
+
+fail:
+    /* Keep the regular layout */
+    PyMem_Free(disp);
+    PyMem_Free(start);
+    PyMem_Free(members);
+    return 0;
+}
+
+/* Create a frozendict of the given type holding the items of the exact dict
+   tmp.  The reference to tmp is stolen and its items are moved, not
+   copied. */
+static PyObject *
+frozendict_from_dict(PyTypeObject *type, PyObject *tmp)
+{
+    PyDictObject *src = (PyDictObject *)tmp;
+    PyFrozenDictObject *fd;
+
+    assert(PyDict_CheckExact(tmp));
+    fd = (PyFrozenDictObject *)type->tp_alloc(type, 0);
+    if (fd == NULL) {
+        Py_DECREF(tmp);
+        return NULL;
+    }
+    fd->fd_dict.ma_keys = src->ma_keys;
+    fd->fd_dict.ma_values = src->ma_values;
+    fd->fd_dict.ma_used = src->ma_used;
+    fd->fd_dict.ma_version_tag = DICT_NEXT_VERSION();
+    fd->fd_hash = -1;
+    fd->fd_bucket_mask = 0;
+    fd->fd_disp = NULL;
+    dictkeys_incref(Py_EMPTY_KEYS);
+    src->ma_keys = Py_EMPTY_KEYS;
+    src->ma_values = empty_values;
+    src->ma_used = 0;
+    Py_DECREF(tmp);
+
+    if (frozendict_build_layout(fd) < 0) {
+        Py_DECREF(fd);
+        return NULL;
+    }
+    ASSERT_CONSISTENT(&fd->fd_dict);
+    return (PyObject *)fd;
+}
+
+PyObject *
+PyFrozenDict_New(PyObject *iterable)
+{
+    PyObject *tmp = PyDict_New();
+    if (tmp == NULL) {
+        return NULL;
+    }
+    if (iterable != NULL && dict_update_arg(tmp, iterable) < 0) {
+        Py_DECREF(tmp);
+        return NULL;
+    }
+    return frozendict_from_dict(&PyFrozenDict_Type, tmp);
+}
+
+static PyObject *
+frozendict_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    PyObject *tmp;
+
+    /* frozendict(fd) returns fd itself */
+    if (type == &PyFrozenDict_Type && PyTuple_GET_SIZE(args) == 1 &&
+        (kwds == NULL || PyDict_GET_SIZE(kwds) == 0) &&
+        PyFrozenDict_CheckExact(PyTuple_GET_ITEM(args, 0))) {
+        tmp = PyTuple_GET_ITEM(args, 0);
+        Py_INCREF(tmp);
+        return tmp;
+    }
+    tmp = PyDict_New();
+    if (tmp == NULL) {
+        return NULL;
+    }
+    if (dict_update_common(tmp, args, kwds, "frozendict") < 0) {
+        Py_DECREF(tmp);
+        return NULL;
+    }
+    return frozendict_from_dict(type, tmp);
+}
+
+static void
+frozendict_dealloc(PyFrozenDictObject *fd)
+{
+    PyObject_GC_UnTrack(fd);
+    Py_TRASHCAN_BEGIN(fd, frozendict_dealloc)
+    PyMem_Free(fd->fd_disp);
+    fd->fd_disp = NULL;
+    dict_dealloc_contents(&fd->fd_dict);
+    Py_TRASHCAN_END
+}
+
+static int
+frozendict_tp_clear(PyFrozenDictObject *fd)
+{
+    /* Detach the keys before their displacements go away */
+    clear_dict(&fd->fd_dict);
+    PyMem_Free(fd->fd_disp);
+    fd->fd_disp = NULL;
+    return 0;
+}
+
+static PyObject *
+frozendict_repr(PyFrozenDictObject *fd)
+{
+    const char *name = _PyType_Name(Py_TYPE(fd));
+    PyObject *items, *result;
+
+    if (fd->fd_dict.ma_used == 0) {
+        return PyUnicode_FromFormat("%s()", name);
+    }
+    items = dict_repr(&fd->fd_dict);
+    if (items == NULL) {
+        return NULL;
+    }
+    result = PyUnicode_FromFormat("%s(%U)", name, items);
+    Py_DECREF(items);
+    return result;
+}
+
+/* Like frozenset, combine the hashes of the items in an order-independent
+   way, shuffling the bits of each item hash first so that items with
+   nearby hashes don't cancel out. */
+static Py_hash_t
+frozendict_hash(PyFrozenDictObject *fd)
+{
+    Py_uhash_t hash = 0, h;
+    Py_ssize_t pos = 0;
+    PyObject *key, *value;
+    Py_hash_t khash, vhash;
+
+    if (fd->fd_hash != -1) {
+        return fd->fd_hash;
+    }
+    while (_PyDict_Next((PyObject *)fd, &pos, &key, &value, &khash)) {
+        vhash = PyObject_Hash(value);
+        if (vhash == -1) {
+            return -1;
+        }
+        h = ((Py_uhash_t)khash * _PyHASH_MULTIPLIER) ^ (Py_uhash_t)vhash;
+        hash ^= ((h ^ 89869747UL) ^ (h << 16)) * 3644798167UL;
+    }
+    hash ^= ((Py_uhash_t)fd->fd_dict.ma_used + 1) * 1927868237UL;
+    hash = hash * 69069U + 907133923UL;
+    if (hash == (Py_uhash_t)-1) {
+        hash = 590923713UL;
+    }
+    fd->fd_hash = (Py_hash_t)hash;
+    return (Py_hash_t)hash;
+}
+
+static PyObject *
+frozendict_or(PyObject *self, PyObject *other)
+{
+    PyObject *tmp;
+
+    if (!PyFrozenDict_Check(self) || !PyAnyDict_Check(other)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    tmp = dict_or(self, other);
+    if (tmp == NULL) {
+        return NULL;
+    }
+    return frozendict_from_dict(&PyFrozenDict_Type, tmp);
+}
+
+/*[clinic input]
+@classmethod
+frozendict.fromkeys
+    iterable: object
+    value: object=None
+    /
+
+Create a new frozendict with keys from iterable and values set to value.
+[clinic start generated code]*/
+
+static PyObject *
+frozendict_fromkeys_impl(PyTypeObject *type, PyObject *iterable,
+                         PyObject *value)
+/*[clinic end generated code: output=2729d20c12ef0c12 input=9b1cd7494cbf18ea]*/
+{
+    PyObject *tmp = _PyDict_FromKeys((PyObject *)&PyDict_Type, iterable, value);
+    if (tmp == NULL) {
+        return NULL;
+    }
+    return frozendict_from_dict(type, tmp);
+}
+
+static PyObject *
+frozendict_copy(PyFrozenDictObject *fd, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *tmp;
+
+    if (PyFrozenDict_CheckExact(fd)) {
+        Py_INCREF(fd);
+        return (PyObject *)fd;
+    }
+    tmp = PyDict_Copy((PyObject *)fd);
+    if (tmp == NULL) {
+        return NULL;
+    }
+    return frozendict_from_dict(&PyFrozenDict_Type, tmp);
+}
+
+static PyObject *
+frozendict_reduce(PyFrozenDictObject *fd, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *items, *state;
+    _Py_IDENTIFIER(__dict__);
+
+    items = PyDict_Copy((PyObject *)fd);
+    if (items == NULL) {
+        return NULL;
+    }
+    if (_PyObject_LookupAttrId((PyObject *)fd, &PyId___dict__, &state) < 0) {
+        Py_DECREF(items);
+        return NULL;
+    }
+    if (state == NULL) {
+        state = Py_None;
+        Py_INCREF(state);
+    }
+    return Py_BuildValue("(O(N)N)", Py_TYPE(fd), items, state);
+}
+
+static PyObject *
+frozendict_sizeof(PyFrozenDictObject *fd, PyObject *Py_UNUSED(ignored))
+{
+    Py_ssize_t res = _PyDict_SizeOf(&fd->fd_dict);
+    if (fd->fd_disp != NULL) {
+        res += (fd->fd_bucket_mask + 1) * sizeof(uint16_t);
+    }
+    return PyLong_FromSsize_t(res);
+}
+
+PyDoc_STRVAR(frozendict_copy__doc__,
+"D.copy() -> a frozendict with the same items as D");
+
+PyDoc_STRVAR(frozendict_reduce__doc__, "Return state information for pickling.");
+
+static PyMethodDef frozendict_methods[] = {
+    DICT___CONTAINS___METHODDEF
+    {"__getitem__", (PyCFunction)(void(*)(void))dict_subscript,        METH_O | METH_COEXIST,
+     getitem__doc__},
+    {"__sizeof__",      (PyCFunction)frozendict_sizeof, METH_NOARGS,
+     sizeof__doc__},
+    DICT_GET_METHODDEF
+    {"keys",            dictkeys_new,                   METH_NOARGS,
+    keys__doc__},
+    {"items",           dictitems_new,                  METH_NOARGS,
+    items__doc__},
+    {"values",          dictvalues_new,                 METH_NOARGS,
+    values__doc__},
+    FROZENDICT_FROMKEYS_METHODDEF
+    {"copy",            (PyCFunction)frozendict_copy,   METH_NOARGS,
+     frozendict_copy__doc__},
+    DICT___REVERSED___METHODDEF
+    {"__reduce__",      (PyCFunction)frozendict_reduce, METH_NOARGS,
+     frozendict_reduce__doc__},
+    {"__class_getitem__", (PyCFunction)Py_GenericAlias, METH_O|METH_CLASS, PyDoc_STR("See PEP 585")},
+    {NULL,              NULL}   /* sentinel */
+};
+
+static PyMappingMethods frozendict_as_mapping = {
+    (lenfunc)dict_length, /*mp_length*/
+    (binaryfunc)dict_subscript, /*mp_subscript*/
+    0, /*mp_ass_subscript*/
+};
+
+static PyNumberMethods frozendict_as_number = {
+    .nb_or = frozendict_or,
+};
+
+PyDoc_STRVAR(frozendict_doc,
+"frozendict() -> new empty frozendict\n"
+"frozendict(mapping) -> new frozendict initialized from a mapping object's\n"
+"    (key, value) pairs\n"
+"frozendict(iterable) -> new frozendict initialized from the (key, value)\n"
+"    pairs of iterable\n"
+"frozendict(**kwargs) -> new frozendict initialized with the name=value pairs\n"
+"    in the keyword argument list.  For example:  frozendict(one=1, two=2)\n"
+"\n"
+"An immutable, hashable mapping.");
+
+PyTypeObject PyFrozenDict_Type = {
+    PyVarObject_HEAD_INIT(&PyType_Type, 0)
+    "frozendict",
+    sizeof(PyFrozenDictObject),
+    0,
+    (destructor)frozendict_dealloc,             /* tp_dealloc */
+    0,                                          /* tp_vectorcall_offset */
+    0,                                          /* tp_getattr */
+    0,                                          /* tp_setattr */
+    0,                                          /* tp_as_async */
+    (reprfunc)frozendict_repr,                  /* tp_repr */
+    &frozendict_as_number,                      /* tp_as_number */
+    &dict_as_sequence,                          /* tp_as_sequence */
+    &frozendict_as_mapping,                     /* tp_as_mapping */
+    (hashfunc)frozendict_hash,                  /* tp_hash */
+    0,                                          /* tp_call */
+    0,                                          /* tp_str */
+    PyObject_GenericGetAttr,                    /* tp_getattro */
+    0,                                          /* tp_setattro */
+    0,                                          /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC |
+        Py_TPFLAGS_BASETYPE |
+        _Py_TPFLAGS_MATCH_SELF | Py_TPFLAGS_MAPPING,  /* tp_flags */
+    frozendict_doc,                             /* tp_doc */
+    dict_traverse,                              /* tp_traverse */
+    (inquiry)frozendict_tp_clear,               /* tp_clear */
+    dict_richcompare,                           /* tp_richcompare */
+    0,                                          /* tp_weaklistoffset */
+    (getiterfunc)dict_iter,                     /* tp_iter */
+    0,                                          /* tp_iternext */
+    frozendict_methods,                         /* tp_methods */
+    0,                                          /* tp_members */
+    0,                                          /* tp_getset */
+    0,                                          /* tp_base */
+    0,                                          /* tp_dict */
+    0,                                          /* tp_descr_get */
+    0,                                          /* tp_descr_set */
+    0,                                          /* tp_dictoffset */
+    0,                                          /* tp_init */
+    PyType_GenericAlloc,                        /* tp_alloc */
+    frozendict_new,                             /* tp_new */
+    PyObject_GC_Del,                            /* tp_free */
+};
+
 /* For backward compatibility with old dictionary interface */
 
 PyObject *
@@ -3742,7 +4580,7 @@ dictiter_iternextkey(dictiterobject *di)
 
     if (d == NULL)
         return NULL;
-    assert (PyDict_Check(d));
+    assert (PyAnyDict_Check(d));
 
     if (di->di_used != d->ma_used) {
         PyErr_SetString(PyExc_RuntimeError,
@@ -3757,8 +4595,9 @@ dictiter_iternextkey(dictiterobject *di)
     if (d->ma_values) {
         if (i >= d->ma_used)
             goto fail;
-        key = DK_ENTRIES(k)[i].me_key;
-        assert(d->ma_values[i] != NULL);
+        Py_ssize_t ix = SPLIT_ORDER(d)[i];
+        key = DK_ENTRIES(k)[ix].me_key;
+        assert(d->ma_values[ix] != NULL);
     }
     else {
         Py_ssize_t n = k->dk_nentries;
@@ -3830,7 +4669,7 @@ dictiter_iternextvalue(dictiterobject *di)
 
     if (d == NULL)
         return NULL;
-    assert (PyDict_Check(d));
+    assert (PyAnyDict_Check(d));
 
     if (di->di_used != d->ma_used) {
         PyErr_SetString(PyExc_RuntimeError,
@@ -3844,7 +4683,7 @@ dictiter_iternextvalue(dictiterobject *di)
     if (d->ma_values) {
         if (i >= d->ma_used)
             goto fail;
-        value = d->ma_values[i];
+        value = d->ma_values[SPLIT_ORDER(d)[i]];
         assert(value != NULL);
     }
     else {
@@ -3917,7 +4756,7 @@ dictiter_iternextitem(dictiterobject *di)
 
     if (d == NULL)
         return NULL;
-    assert (PyDict_Check(d));
+    assert (PyAnyDict_Check(d));
 
     if (di->di_used != d->ma_used) {
         PyErr_SetString(PyExc_RuntimeError,
@@ -3931,8 +4770,9 @@ dictiter_iternextitem(dictiterobject *di)
     if (d->ma_values) {
         if (i >= d->ma_used)
             goto fail;
-        key = DK_ENTRIES(d->ma_keys)[i].me_key;
-        value = d->ma_values[i];
+        Py_ssize_t ix = SPLIT_ORDER(d)[i];
+        key = DK_ENTRIES(d->ma_keys)[ix].me_key;
+        value = d->ma_values[ix];
         assert(value != NULL);
     }
     else {
@@ -4031,7 +4871,7 @@ dictreviter_iternext(dictiterobject *di)
     if (d == NULL) {
         return NULL;
     }
-    assert (PyDict_Check(d));
+    assert (PyAnyDict_Check(d));
 
     if (di->di_used != d->ma_used) {
         PyErr_SetString(PyExc_RuntimeError,
@@ -4048,8 +4888,9 @@ dictreviter_iternext(dictiterobject *di)
         goto fail;
     }
     if (d->ma_values) {
-        key = DK_ENTRIES(k)[i].me_key;
-        value = d->ma_values[i];
+        Py_ssize_t ix = SPLIT_ORDER(d)[i];
+        key = DK_ENTRIES(k)[ix].me_key;
+        value = d->ma_values[ix];
         assert (value != NULL);
     }
     else {
@@ -4135,7 +4976,7 @@ static PyObject *
 dict___reversed___impl(PyDictObject *self)
 /*[clinic end generated code: output=e674483336d1ed51 input=23210ef3477d8c4d]*/
 {
-    assert (PyDict_Check(self));
+    assert (PyAnyDict_Check(self));
     return dictiter_new(self, &PyDictRevIterKey_Type);
 }
 
@@ -4218,7 +5059,7 @@ _PyDictView_New(PyObject *dict, PyTypeObject *type)
         PyErr_BadInternalCall();
         return NULL;
     }
-    if (!PyDict_Check(dict)) {
+    if (!PyAnyDict_Check(dict)) {
         /* XXX Get rid of this restriction later */
         PyErr_Format(PyExc_TypeError,
                      "%s() requires a dict argument, not '%s'",
@@ -5030,13 +5871,8 @@ _PyObjectDict_SetItem(PyTypeObject *tp, PyObject **dictptr,
             *dictptr = dict;
         }
         if (value == NULL) {
+            // Deleting from a split table keeps sharing the keys.
             res = PyDict_DelItem(dict, key);
-            // Since key sharing dict doesn't allow deletion, PyDict_DelItem()
-            // always converts dict to combined form.
-            if ((cached = CACHED_KEYS(tp)) != NULL) {
-                CACHED_KEYS(tp) = NULL;
-                dictkeys_decref(cached);
-            }
         }
         else {
             int was_shared = (cached == ((PyDictObject *)dict)->ma_keys);
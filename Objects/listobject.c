@@ -3,8 +3,11 @@
 #include "Python.h"
 #include "pycore_abstract.h"      // _PyIndex_Check()
 #include "pycore_interp.h"        // PyInterpreterState.list
+#include "pycore_list.h"          // _PyList_SetSortThreads()
 #include "pycore_object.h"        // _PyObject_GC_TRACK()
+#include "pycore_pystate.h"       // _PyThreadState_GET()
 #include "pycore_tuple.h"         // _PyTuple_FromArray()
+#include "pythread.h"             // PyThread_start_new_thread()
 
 #ifdef STDC_HEADERS
 #include <stddef.h>
@@ -12,6 +15,10 @@
 #include <sys/types.h>          /* For size_t */
 #endif
 
+#ifdef MS_WINDOWS
+#  include <windows.h>            // GetActiveProcessorCount()
+#endif
+
 /*[clinic input]
 class list "PyListObject *" "&PyList_Type"
 [clinic start generated code]*/
@@ -2056,6 +2063,19 @@ unsafe_object_compare(PyObject *v, PyObject *w, MergeState *ms)
     return res;
 }
 
+#ifndef NDEBUG
+/* True if the calling thread holds the GIL.  The compare functions below
+ * only cross-check their result when it does, since parallel sorts run
+ * them in threads without a thread state. */
+static int
+sort_holds_gil(void)
+{
+    PyThreadState *tstate = _PyThreadState_GET();
+    return (tstate != NULL
+            && tstate->thread_id == PyThread_get_thread_ident());
+}
+#endif
+
 /* Latin string compare: safe for any two latin (one byte per char) strings. */
 static int
 unsafe_latin_compare(PyObject *v, PyObject *w, MergeState *ms)
@@ -2076,7 +2096,9 @@ unsafe_latin_compare(PyObject *v, PyObject *w, MergeState *ms)
            res < 0 :
            PyUnicode_GET_LENGTH(v) < PyUnicode_GET_LENGTH(w));
 
-    assert(res == PyObject_RichCompareBool(v, w, Py_LT));;
+    /* The check needs the GIL, which parallel sorts run without. */
+    assert(!sort_holds_gil() ||
+           res == PyObject_RichCompareBool(v, w, Py_LT));
     return res;
 }
 
@@ -2104,7 +2126,8 @@ unsafe_long_compare(PyObject *v, PyObject *w, MergeState *ms)
         w0 = -w0;
 
     res = v0 < w0;
-    assert(res == PyObject_RichCompareBool(v, w, Py_LT));
+    assert(!sort_holds_gil() ||
+           res == PyObject_RichCompareBool(v, w, Py_LT));
     return res;
 }
 
@@ -2119,7 +2142,8 @@ unsafe_float_compare(PyObject *v, PyObject *w, MergeState *ms)
     assert(Py_IS_TYPE(w, &PyFloat_Type));
 
     res = PyFloat_AS_DOUBLE(v) < PyFloat_AS_DOUBLE(w);
-    assert(res == PyObject_RichCompareBool(v, w, Py_LT));
+    assert(!sort_holds_gil() ||
+           res == PyObject_RichCompareBool(v, w, Py_LT));
     return res;
 }
 
@@ -2165,6 +2189,431 @@ unsafe_tuple_compare(PyObject *v, PyObject *w, MergeState *ms)
         return PyObject_RichCompareBool(vt->ob_item[i], wt->ob_item[i], Py_LT);
 }
 
+/* Sort the n elements of lo: march over the slice once, left to right,
+ * finding natural runs, extending short natural runs to minrun elements,
+ * and merging them.  On success, ms->pending[0] holds the sorted slice.
+ * Returns 0 on success, -1 on error.
+ */
+static int
+merge_sort_slice(MergeState *ms, sortslice lo, Py_ssize_t nremaining)
+{
+    Py_ssize_t minrun;
+
+    assert(nremaining > 0);
+    minrun = merge_compute_minrun(nremaining);
+    do {
+        int descending;
+        Py_ssize_t n;
+
+        /* Identify next run. */
+        n = count_run(ms, lo.keys, lo.keys + nremaining, &descending);
+        if (n < 0)
+            return -1;
+        if (descending)
+            reverse_sortslice(&lo, n);
+        /* If short, extend to min(minrun, nremaining). */
+        if (n < minrun) {
+            const Py_ssize_t force = nremaining <= minrun ?
+                              nremaining : minrun;
+            if (binarysort(ms, lo, lo.keys + force, lo.keys + n) < 0)
+                return -1;
+            n = force;
+        }
+        /* Push run onto pending-runs stack, and maybe merge. */
+        assert(ms->n < MAX_MERGE_PENDING);
+        ms->pending[ms->n].base = lo;
+        ms->pending[ms->n].len = n;
+        ++ms->n;
+        if (merge_collapse(ms) < 0)
+            return -1;
+        /* Advance to find next run. */
+        sortslice_advance(&lo, n);
+        nremaining -= n;
+    } while (nremaining);
+
+    if (merge_force_collapse(ms) < 0)
+        return -1;
+    assert(ms->n == 1);
+    return 0;
+}
+
+/* Parallel sorting.  When the pre-sort check picked one of the compare
+ * functions above that only read immutable ints, floats or Latin-1
+ * strings, comparing never calls back into Python, so the sort can run
+ * without the GIL.  The slice is cut into one chunk per thread; the chunks
+ * are sorted by worker threads, and adjacent sorted chunks are then merged
+ * pairwise, again in parallel, until one run is left.  Since chunks are
+ * only ever merged with their neighbours, in order, the sort stays stable.
+ */
+
+/* Don't bother with threads for chunks smaller than this. */
+#define PARALLEL_SORT_MIN_CHUNK (1 << 15)
+#define PARALLEL_SORT_MAX_THREADS _PyList_SORT_MAX_THREADS
+
+/* Number of threads forced by _PyList_SetSortThreads(), or 0 to use one
+   per CPU. */
+static int sort_threads_override = 0;
+
+typedef struct {
+    MergeState ms;
+    sortslice base;
+    Py_ssize_t na;      /* length of the first run, or of the whole slice */
+    Py_ssize_t nb;      /* length of the second run; 0 for a sort task */
+    PyThread_type_lock done;    /* NULL if run by the calling thread */
+    int result;
+} SortTask;
+
+static int
+sort_thread_count(void)
+{
+    long ncpu = 0;
+    if (sort_threads_override > 0)
+        return sort_threads_override;
+#ifdef MS_WINDOWS
+    ncpu = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+#elif defined(HAVE_SYSCONF) && defined(_SC_NPROCESSORS_ONLN)
+    ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (ncpu < 1)
+        return 1;
+    return (int)Py_MIN(ncpu, PARALLEL_SORT_MAX_THREADS);
+}
+
+/* Force the number of threads used by parallel sorts, so that the tests
+ * exercise them whatever the number of CPUs; 0 restores the default.
+ * Returns the previous setting.
+ */
+int
+_PyList_SetSortThreads(int nthreads)
+{
+    int old = sort_threads_override;
+    assert(0 <= nthreads && nthreads <= PARALLEL_SORT_MAX_THREADS);
+    sort_threads_override = nthreads;
+    return old;
+}
+
+/* Run a task; this is called without the GIL. */
+static void
+sort_task_run(void *arg)
+{
+    SortTask *task = (SortTask *)arg;
+    MergeState *ms = &task->ms;
+
+    if (task->nb == 0) {
+        task->result = merge_sort_slice(ms, task->base, task->na);
+    }
+    else {
+        sortslice b = task->base;
+        sortslice_advance(&b, task->na);
+        ms->pending[0].base = task->base;
+        ms->pending[0].len = task->na;
+        ms->pending[1].base = b;
+        ms->pending[1].len = task->nb;
+        ms->n = 2;
+        task->result = merge_at(ms, 0);
+    }
+    if (task->done != NULL)
+        PyThread_release_lock(task->done);
+}
+
+/* Run ntasks tasks, all but the first one in new threads, and wait for
+ * them to finish.  Tasks whose thread can't be started are run by the
+ * calling thread.  Returns 0 on success, -1 if a task failed.
+ */
+static int
+sort_tasks_run(SortTask *tasks, int ntasks)
+{
+    int i, result = 0;
+
+    for (i = 1; i < ntasks; i++) {
+        tasks[i].done = PyThread_allocate_lock();
+        if (tasks[i].done == NULL)
+            continue;
+        PyThread_acquire_lock(tasks[i].done, WAIT_LOCK);
+        if (PyThread_start_new_thread(sort_task_run, &tasks[i])
+            == PYTHREAD_INVALID_THREAD_ID) {
+            PyThread_release_lock(tasks[i].done);
+            PyThread_free_lock(tasks[i].done);
+            tasks[i].done = NULL;
+        }
+    }
+    tasks[0].done = NULL;
+    sort_task_run(&tasks[0]);
+    for (i = 0; i < ntasks; i++) {
+        if (tasks[i].done != NULL) {
+            PyThread_acquire_lock(tasks[i].done, WAIT_LOCK);
+            PyThread_release_lock(tasks[i].done);
+            PyThread_free_lock(tasks[i].done);
+        }
+        else if (i > 0) {
+            sort_task_run(&tasks[i]);
+        }
+        if (tasks[i].result < 0)
+            result = -1;
+    }
+    return result;
+}
+
+/* Set up a task working on lo[start:start+na+nb].  Its merges use the
+ * same part of the n-element temp array, so tasks never allocate memory.
+ */
+static void
+sort_task_init(SortTask *task, MergeState *ms, sortslice lo,
+               PyObject **temp, Py_ssize_t n,
+               Py_ssize_t start, Py_ssize_t na, Py_ssize_t nb)
+{
+    merge_init(&task->ms, 0, lo.values != NULL);
+    task->ms.key_compare = ms->key_compare;
+    task->ms.a.keys = temp + start;
+    if (lo.values != NULL)
+        task->ms.a.values = temp + n + start;
+    task->ms.alloced = na + nb;
+    task->base = lo;
+    sortslice_advance(&task->base, start);
+    task->na = na;
+    task->nb = nb;
+}
+
+/* Sort the n elements of lo using several threads, if ms's compare
+ * function allows it and the slice is large enough.  Returns 1 if the
+ * slice was sorted, 0 if it should be sorted serially instead, and -1 on
+ * error.
+ */
+static int
+parallel_sort_slice(MergeState *ms, sortslice lo, Py_ssize_t n)
+{
+    Py_ssize_t bounds[PARALLEL_SORT_MAX_THREADS + 1];
+    SortTask *tasks;
+    PyObject **temp;
+    int nruns, ntasks, i, result;
+    const int multiplier = lo.values != NULL ? 2 : 1;
+
+    if (ms->key_compare != unsafe_long_compare &&
+        ms->key_compare != unsafe_latin_compare &&
+        ms->key_compare != unsafe_float_compare)
+        return 0;
+    nruns = sort_thread_count();
+    if (nruns > n / PARALLEL_SORT_MIN_CHUNK)
+        nruns = (int)(n / PARALLEL_SORT_MIN_CHUNK);
+    if (nruns < 2)
+        return 0;
+
+    if ((size_t)n > PY_SSIZE_T_MAX / sizeof(PyObject *) / multiplier)
+        return 0;
+    temp = (PyObject **)PyMem_Malloc(multiplier * n * sizeof(PyObject *));
+    tasks = PyMem_New(SortTask, nruns);
+    if (temp == NULL || tasks == NULL) {
+        PyMem_Free(temp);
+        PyMem_Free(tasks);
+        return 0;
+    }
+    /* bounds[i] is where the i-th run starts. */
+    for (i = 0; i <= nruns; i++)
+        bounds[i] = n / nruns * i + Py_MIN(i, n % nruns);
+
+    Py_BEGIN_ALLOW_THREADS
+    for (i = 0; i < nruns; i++)
+        sort_task_init(&tasks[i], ms, lo, temp, n,
+                       bounds[i], bounds[i+1] - bounds[i], 0);
+    result = sort_tasks_run(tasks, nruns);
+
+    /* Merge pairs of adjacent runs until only one is left; with an odd
+       number of runs, the last one waits for the next round. */
+    while (result == 0 && nruns > 1) {
+        ntasks = nruns / 2;
+        for (i = 0; i < ntasks; i++)
+            sort_task_init(&tasks[i], ms, lo, temp, n, bounds[2*i],
+                           bounds[2*i+1] - bounds[2*i],
+                           bounds[2*i+2] - bounds[2*i+1]);
+        result = sort_tasks_run(tasks, ntasks);
+        for (i = 1; i <= ntasks; i++)
+            bounds[i] = bounds[2*i];
+        if (nruns & 1)
+            bounds[ntasks + 1] = bounds[nruns];
+        nruns = (nruns + 1) / 2;
+    }
+    Py_END_ALLOW_THREADS
+
+    PyMem_Free(temp);
+    PyMem_Free(tasks);
+    if (result < 0) {
+        /* Only merge_getmem() can fail, and the temp array is always large
+           enough. */
+        PyErr_NoMemory();
+        return -1;
+    }
+    return 1;
+}
+
+/* Radix sorting.  When all keys are small ints or floats, each key maps to
+ * a 64-bit unsigned integer with the same order, and a stable LSD radix
+ * sort on those, one byte at a time, beats any comparison sort on large
+ * lists.  Timsort still wins on data that is already mostly ordered, so
+ * such lists are left to it, as are lists of floats containing a NaN
+ * (which has no place in the order).
+ */
+
+/* Lists shorter than this are left to timsort. */
+#define RADIX_SORT_MIN 256
+/* Number of pairs of neighbours sampled to estimate the run length. */
+#define RADIX_SORT_SAMPLES 256
+
+typedef struct {
+    uint64_t key;
+    Py_ssize_t index;
+} RadixItem;
+
+/* Return the radix key of a small int. */
+static inline uint64_t
+radix_long_key(PyObject *v)
+{
+    Py_ssize_t size = Py_SIZE(v);
+    int64_t x = size == 0 ? 0 : (int64_t)((PyLongObject *)v)->ob_digit[0];
+
+    assert(Py_ABS(size) <= 1);
+    if (size < 0)
+        x = -x;
+    return (uint64_t)x ^ ((uint64_t)1 << 63);
+}
+
+/* Set *key to the radix key of a float; return 0 if it is a NaN. */
+static inline int
+radix_float_key(PyObject *v, uint64_t *key)
+{
+    double d = PyFloat_AS_DOUBLE(v);
+    uint64_t u;
+
+    if (Py_IS_NAN(d))
+        return 0;
+    if (d == 0.0)
+        d = 0.0;                /* -0.0 and 0.0 compare equal */
+    memcpy(&u, &d, sizeof(u));
+    /* Negative floats order backwards: flip all their bits; flip just the
+       sign bit of the others. */
+    if (u >> 63)
+        u = ~u;
+    else
+        u |= (uint64_t)1 << 63;
+    *key = u;
+    return 1;
+}
+
+/* Set *key to the radix key of lo.keys[i]; return 0 for a NaN. */
+static inline int
+radix_key(sortslice lo, Py_ssize_t i, int is_float, uint64_t *key)
+{
+    if (is_float)
+        return radix_float_key(lo.keys[i], key);
+    *key = radix_long_key(lo.keys[i]);
+    return 1;
+}
+
+/* Sort the n elements of lo with a radix sort, if ms's compare function
+ * allows it and it is likely to pay off.  Returns 1 if the slice was
+ * sorted, 0 if it should be sorted by timsort instead.
+ */
+static int
+radix_sort_slice(MergeState *ms, sortslice lo, Py_ssize_t n)
+{
+    RadixItem *items, *src, *dst, *tmp;
+    Py_ssize_t (*counts)[256];
+    Py_ssize_t i, step, samples = 0, descents = 0;
+    uint64_t key, key2, min = UINT64_MAX, max = 0;
+    PyObject **order;
+    int byte, nbytes;
+    const int is_float = ms->key_compare == unsafe_float_compare;
+
+    if (n < RADIX_SORT_MIN)
+        return 0;
+    if (!is_float && ms->key_compare != unsafe_long_compare)
+        return 0;
+
+    /* Sample pairs of neighbours across the slice to see how ordered it
+       already is: an average run length of 16 or more suggests enough
+       structure for timsort to do better. */
+    step = n / RADIX_SORT_SAMPLES;
+    for (i = 0; i + 1 < n; i += step) {
+        if (!radix_key(lo, i, is_float, &key) ||
+            !radix_key(lo, i + 1, is_float, &key2))
+            return 0;
+        descents += key2 < key;
+        samples++;
+    }
+    if (descents < samples / 16)
+        return 0;
+
+    /* The scratch space is 2*n items on top of the list.  If it cannot be
+       allocated, let timsort, which needs much less memory, sort the slice:
+       PyMem_Malloc() does not set an exception, so none must be raised. */
+    if ((size_t)n > PY_SSIZE_T_MAX / sizeof(RadixItem) / 2)
+        return 0;
+    items = PyMem_New(RadixItem, 2 * n);
+    counts = PyMem_Malloc(sizeof(Py_ssize_t[8][256]));
+    if (items == NULL || counts == NULL)
+        goto fallback;
+    src = items;
+    dst = items + n;
+
+    for (i = 0; i < n; i++) {
+        if (!radix_key(lo, i, is_float, &key))
+            goto fallback;
+        min = Py_MIN(min, key);
+        max = Py_MAX(max, key);
+        src[i].key = key;
+        src[i].index = i;
+    }
+
+    /* Only sort on the bytes that vary between min and max. */
+    max -= min;
+    for (nbytes = 0; nbytes < 8 && (max >> (8 * nbytes)) != 0; nbytes++)
+        ;
+    memset(counts, 0, sizeof(Py_ssize_t[8][256]));
+    for (i = 0; i < n; i++) {
+        key = src[i].key -= min;
+        for (byte = 0; byte < nbytes; byte++)
+            counts[byte][(key >> (8 * byte)) & 0xff]++;
+    }
+    for (byte = 0; byte < nbytes; byte++) {
+        Py_ssize_t *count = counts[byte];
+        Py_ssize_t sum = 0;
+        int shift = 8 * byte;
+        int b;
+
+        /* Skip the pass if all keys have the same byte. */
+        if (count[(src[0].key >> shift) & 0xff] == n)
+            continue;
+        for (b = 0; b < 256; b++) {
+            Py_ssize_t c = count[b];
+            count[b] = sum;
+            sum += c;
+        }
+        for (i = 0; i < n; i++)
+            dst[count[(src[i].key >> shift) & 0xff]++] = src[i];
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    /* Apply the permutation, using the spare half as scratch space. */
+    order = (PyObject **)dst;
+    for (i = 0; i < n; i++)
+        order[i] = lo.keys[src[i].index];
+    memcpy(lo.keys, order, n * sizeof(PyObject *));
+    if (lo.values != NULL) {
+        for (i = 0; i < n; i++)
+            order[i] = lo.values[src[i].index];
+        memcpy(lo.values, order, n * sizeof(PyObject *));
+    }
+    PyMem_Free(items);
+    PyMem_Free(counts);
+    return 1;
+
+fallback:
+    PyMem_Free(items);
+    PyMem_Free(counts);
+    return 0;
+}
+
 /* An adaptive, stable, natural mergesort.  See listsort.txt.
  * Returns Py_None on success, NULL on error.  Even in case of error, the
  * list will be some permutation of its input state (nothing is lost or
@@ -2176,6 +2625,7 @@ list.sort
     *
     key as keyfunc: object = None
     reverse: bool(accept={int}) = False
+    parallel: bool(accept={int}) = False
 
 Sort the list in ascending order and return None.
 
@@ -2186,15 +2636,18 @@ If a key function is given, apply it once to each list item and sort them,
 ascending or descending, according to their function values.
 
 The reverse flag can be set to sort in descending order.
+
+If the parallel flag is set, large lists whose sort keys are all ints, floats
+or Latin-1 strings are sorted using several threads.
 [clinic start generated code]*/
 
 static PyObject *
-list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse)
-/*[clinic end generated code: output=57b9f9c5e23fbe42 input=cb56cd179a713060]*/
+list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse,
+               int parallel)
+/*[clinic end generated code: output=9d46a93c53c0d19d input=d1b01eb9a98bcd3d]*/
 {
     MergeState ms;
     Py_ssize_t nremaining;
-    Py_ssize_t minrun;
     sortslice lo;
     Py_ssize_t saved_ob_size, saved_allocated;
     PyObject **saved_ob_item;
@@ -2364,48 +2817,23 @@ list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse)
         reverse_slice(&saved_ob_item[0], &saved_ob_item[saved_ob_size]);
     }
 
-    /* March over the array once, left to right, finding natural runs,
-     * and extending short natural runs to minrun elements.
-     */
-    minrun = merge_compute_minrun(nremaining);
-    do {
-        int descending;
-        Py_ssize_t n;
+    if (radix_sort_slice(&ms, lo, nremaining))
+        goto succeed;
 
-        /* Identify next run. */
-        n = count_run(&ms, lo.keys, lo.keys + nremaining, &descending);
-        if (n < 0)
+    if (parallel) {
+        int res = parallel_sort_slice(&ms, lo, nremaining);
+        if (res < 0)
             goto fail;
-        if (descending)
-            reverse_sortslice(&lo, n);
-        /* If short, extend to min(minrun, nremaining). */
-        if (n < minrun) {
-            const Py_ssize_t force = nremaining <= minrun ?
-                              nremaining : minrun;
-            if (binarysort(&ms, lo, lo.keys + force, lo.keys + n) < 0)
-                goto fail;
-            n = force;
-        }
-        /* Push run onto pending-runs stack, and maybe merge. */
-        assert(ms.n < MAX_MERGE_PENDING);
-        ms.pending[ms.n].base = lo;
-        ms.pending[ms.n].len = n;
-        ++ms.n;
-        if (merge_collapse(&ms) < 0)
-            goto fail;
-        /* Advance to find next run. */
-        sortslice_advance(&lo, n);
-        nremaining -= n;
-    } while (nremaining);
+        if (res > 0)
+            goto succeed;
+    }
 
-    if (merge_force_collapse(&ms) < 0)
+    if (merge_sort_slice(&ms, lo, nremaining) < 0)
         goto fail;
-    assert(ms.n == 1);
     assert(keys == NULL
            ? ms.pending[0].base.keys == saved_ob_item
            : ms.pending[0].base.keys == &keys[0]);
     assert(ms.pending[0].len == saved_ob_size);
-    lo = ms.pending[0].base;
 
 succeed:
     result = Py_None;
@@ -2457,7 +2885,7 @@ PyList_Sort(PyObject *v)
         PyErr_BadInternalCall();
         return -1;
     }
-    v = list_sort_impl((PyListObject *)v, NULL, 0);
+    v = list_sort_impl((PyListObject *)v, NULL, 0, 0);
     if (v == NULL)
         return -1;
     Py_DECREF(v);
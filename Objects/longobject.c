@@ -23,6 +23,19 @@ class int "PyObject *" "&PyLong_Type"
 #define NSMALLNEGINTS           _PY_NSMALLNEGINTS
 #define NSMALLPOSINTS           _PY_NSMALLPOSINTS
 
+#ifndef PyLong_MAXFREELIST
+#  define PyLong_MAXFREELIST    100
+#endif
+
+/* Ints of size 0 or 1 are allocated with room for two digits, which costs
+   no memory with pymalloc on 64-bit platforms, and ob_digit[1] is set to
+   this value, which no digit can take.  Only those ints go to the free
+   list: an int normalized down from a larger block keeps a zero or a real
+   digit there, so that its block is freed instead of being kept alive. */
+#define SMALL_ALLOC_MARK        ((digit)-1)
+#define SMALL_ALLOC_SIZE        (offsetof(PyLongObject, ob_digit) + \
+                                 2 * sizeof(digit))
+
 _Py_IDENTIFIER(little);
 _Py_IDENTIFIER(big);
 
@@ -35,6 +48,13 @@ _Py_IDENTIFIER(big);
 #define IS_SMALL_INT(ival) (-NSMALLNEGINTS <= (ival) && (ival) < NSMALLPOSINTS)
 #define IS_SMALL_UINT(ival) ((ival) < NSMALLPOSINTS)
 
+static struct _Py_long_state *
+get_long_state(void)
+{
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    return &interp->long_state;
+}
+
 static PyObject *
 get_small_int(sdigit ival)
 {
@@ -81,6 +101,12 @@ _PyLong_Negate(PyLongObject **x_p)
 #define KARATSUBA_CUTOFF 70
 #define KARATSUBA_SQUARE_CUTOFF (2 * KARATSUBA_CUTOFF)
 
+/* Above TOOM3_CUTOFF digits, balanced operands are multiplied with Toom-3
+ * instead of Karatsuba.
+ */
+#define TOOM3_CUTOFF 300
+#define TOOM3_SQUARE_CUTOFF (2 * TOOM3_CUTOFF)
+
 /* For exponentiation, use the binary left-to-right algorithm
  * unless the exponent contains more than FIVEARY_CUTOFF digits.
  * In that case, do 5 bits at a time.  The potential drawback is that
@@ -88,6 +114,33 @@ _PyLong_Negate(PyLongObject **x_p)
  */
 #define FIVEARY_CUTOFF 8
 
+/* Conversions between ints and decimal (or other non-binary base) strings
+ * are quadratic.  For ints of more than INT_TO_STR_DC_CUTOFF digits, and
+ * strings of more than STR_TO_INT_DC_CUTOFF chunks of input digits (a chunk
+ * being as many as fit in an internal digit), the number is instead split
+ * recursively at powers B**(chunk << j), where B is the base raised to the
+ * chunk width and chunk is INT_TO_STR_DC_CHUNK or STR_TO_INT_DC_CHUNK (a
+ * power of two), and the parts are converted independently.
+ */
+#define INT_TO_STR_DC_CUTOFF 2000
+#define INT_TO_STR_DC_CHUNK 512
+#define STR_TO_INT_DC_CUTOFF 1000
+#define STR_TO_INT_DC_CHUNK 128
+
+/* A division by a power of more than BARRETT_CUTOFF digits uses its
+ * reciprocal, if it is reused or has more than 2*RECIPROCAL_CUTOFF digits.
+ * Reciprocals of numbers of at most RECIPROCAL_CUTOFF digits are computed by
+ * long division, larger ones by Newton iteration.
+ */
+#define BARRETT_CUTOFF 400
+#define RECIPROCAL_CUTOFF 1000
+
+/* Division by an int of more than DIVISION_CUTOFF digits, with a quotient of
+ * more than DIVISION_CUTOFF digits, uses the divisor's reciprocal too.
+ * DIVISION_CUTOFF must be at least RECIPROCAL_CUTOFF.
+ */
+#define DIVISION_CUTOFF 2500
+
 #define SIGCHECK(PyTryBlock)                    \
     do {                                        \
         if (PyErr_CheckSignals()) PyTryBlock    \
@@ -126,13 +179,40 @@ _PyLong_New(Py_ssize_t size)
        sizeof(PyVarObject) instead of the offsetof, but this risks being
        incorrect in the presence of padding between the PyVarObject header
        and the digits. */
-    if (size > (Py_ssize_t)MAX_LONG_DIGITS) {
-        PyErr_SetString(PyExc_OverflowError,
-                        "too many digits in integer");
-        return NULL;
+    if (size <= 1) {
+        /* Single-digit ints are the most common by far: reuse one from the
+           free list if possible. */
+        struct _Py_long_state *state = get_long_state();
+        result = state->free_list;
+        if (result != NULL) {
+#ifdef Py_DEBUG
+            // _PyLong_New() must not be called after _PyLong_Fini()
+            assert(state->numfree != -1);
+#endif
+            state->free_list = (PyLongObject *) Py_TYPE(result);
+            state->numfree--;
+            assert(result->ob_digit[1] == SMALL_ALLOC_MARK);
+        }
+        else {
+            result = PyObject_Malloc(SMALL_ALLOC_SIZE);
+            if (result != NULL) {
+                result->ob_digit[1] = SMALL_ALLOC_MARK;
+            }
+        }
+    }
+    else {
+        if (size > (Py_ssize_t)MAX_LONG_DIGITS) {
+            PyErr_SetString(PyExc_OverflowError,
+                            "too many digits in integer");
+            return NULL;
+        }
+        result = PyObject_Malloc(offsetof(PyLongObject, ob_digit) +
+                                 size*sizeof(digit));
+        if (result != NULL) {
+            /* Never mistaken for a small allocation, even if it shrinks */
+            result->ob_digit[1] = 0;
+        }
     }
-    result = PyObject_Malloc(offsetof(PyLongObject, ob_digit) +
-                             size*sizeof(digit));
     if (!result) {
         PyErr_NoMemory();
         return NULL;
@@ -141,6 +221,27 @@ _PyLong_New(Py_ssize_t size)
     return result;
 }
 
+static void
+long_dealloc(PyObject *self)
+{
+    if (PyLong_CheckExact(self) && Py_ABS(Py_SIZE(self)) <= 1
+        && ((PyLongObject *)self)->ob_digit[1] == SMALL_ALLOC_MARK)
+    {
+        struct _Py_long_state *state = get_long_state();
+#ifdef Py_DEBUG
+        // long_dealloc() must not be called after _PyLong_Fini()
+        assert(state->numfree != -1);
+#endif
+        if (state->numfree < PyLong_MAXFREELIST) {
+            state->numfree++;
+            Py_SET_TYPE(self, (PyTypeObject *)state->free_list);
+            state->free_list = (PyLongObject *)self;
+            return;
+        }
+    }
+    Py_TYPE(self)->tp_free(self);
+}
+
 PyObject *
 _PyLong_Copy(PyLongObject *src)
 {
@@ -1069,6 +1170,48 @@ PyLong_FromLongLong(long long ival)
     return (PyObject *)v;
 }
 
+/* Create a new int object from a C stwodigits.  With 60-bit digits this
+   is wider than long long. */
+
+static PyObject *
+_PyLong_FromSTwoDigits(stwodigits ival)
+{
+    PyLongObject *v;
+    twodigits abs_ival;
+    twodigits t;  /* unsigned so >> doesn't propagate sign bit */
+    int ndigits = 0;
+    int negative = 0;
+
+    if (IS_SMALL_INT(ival)) {
+        return get_small_int((sdigit)ival);
+    }
+
+    if (ival < 0) {
+        abs_ival = (twodigits)(-1-ival) + 1;
+        negative = 1;
+    }
+    else {
+        abs_ival = (twodigits)ival;
+    }
+
+    t = abs_ival;
+    while (t) {
+        ++ndigits;
+        t >>= PyLong_SHIFT;
+    }
+    v = _PyLong_New(ndigits);
+    if (v != NULL) {
+        digit *p = v->ob_digit;
+        Py_SET_SIZE(v, negative ? -ndigits : ndigits);
+        t = abs_ival;
+        while (t) {
+            *p++ = (digit)(t & PyLong_MASK);
+            t >>= PyLong_SHIFT;
+        }
+    }
+    return (PyObject *)v;
+}
+
 /* Create a new int object from a C Py_ssize_t. */
 
 PyObject *
@@ -1574,6 +1717,345 @@ divrem1(PyLongObject *a, digit n, digit *prem)
     return long_normalize(z);
 }
 
+/* forward */
+static PyObject *long_add(PyLongObject *, PyLongObject *);
+static PyObject *long_sub(PyLongObject *, PyLongObject *);
+static PyObject *long_mul(PyLongObject *, PyLongObject *);
+static PyObject *long_abs(PyLongObject *);
+static Py_ssize_t long_compare(PyLongObject *, PyLongObject *);
+static int long_divrem(PyLongObject *, PyLongObject *,
+                       PyLongObject **, PyLongObject **);
+
+/* Replace *x by *x + y if sign > 0, else by *x - y.  On error, *x is set
+   to NULL and -1 is returned. */
+
+static int
+long_iadd(PyLongObject **x, PyLongObject *y, int sign)
+{
+    PyObject *z = sign > 0 ? long_add(*x, y) : long_sub(*x, y);
+    Py_SETREF(*x, (PyLongObject *)z);
+    return z == NULL ? -1 : 0;
+}
+
+/* Return floor(2**(2*nbits) / d), where d > 0 has exactly nbits bits.
+
+   Small divisors use long division.  For larger ones, the reciprocal of the
+   top half of d, shifted into place, is correct to about nbits/2 bits; one
+   Newton step r += r*(2**(2*nbits) - d*r) >> (2*nbits) doubles that, and the
+   last few units are then fixed up.  The cost is a small multiple of that of
+   multiplying two nbits-bit numbers. */
+
+static PyLongObject *
+long_reciprocal(PyLongObject *d, Py_ssize_t nbits)
+{
+    PyLongObject *one = (PyLongObject *)_PyLong_GetOne();
+    PyLongObject *p, *r = NULL, *e = NULL, *t = NULL;
+    Py_ssize_t h;
+
+    assert(Py_SIZE(d) > 0);
+    p = (PyLongObject *)_PyLong_Lshift((PyObject *)one, 2 * (size_t)nbits);
+    if (p == NULL)
+        return NULL;
+    if (Py_SIZE(d) <= RECIPROCAL_CUTOFF) {
+        if (long_divrem(p, d, &r, &e) < 0)
+            r = NULL;
+        else
+            Py_DECREF(e);
+        Py_DECREF(p);
+        return r;
+    }
+
+    h = nbits / 2 + 2;
+    t = (PyLongObject *)_PyLong_Rshift((PyObject *)d, nbits - h);
+    if (t == NULL)
+        goto error;
+    e = long_reciprocal(t, h);
+    Py_CLEAR(t);
+    if (e == NULL)
+        goto error;
+    r = (PyLongObject *)_PyLong_Lshift((PyObject *)e, nbits - h);
+    Py_CLEAR(e);
+    if (r == NULL)
+        goto error;
+
+    /* Newton step */
+    t = (PyLongObject *)long_mul(d, r);
+    if (t == NULL)
+        goto error;
+    e = (PyLongObject *)long_sub(p, t);
+    Py_CLEAR(t);
+    if (e == NULL)
+        goto error;
+    t = (PyLongObject *)long_mul(r, e);
+    Py_CLEAR(e);
+    if (t == NULL)
+        goto error;
+    e = (PyLongObject *)_PyLong_Rshift((PyObject *)t, 2 * (size_t)nbits);
+    Py_CLEAR(t);
+    if (e == NULL || long_iadd(&r, e, 1) < 0)
+        goto error;
+    Py_CLEAR(e);
+
+    /* Correct r so that 0 <= 2**(2*nbits) - d*r < d. */
+    t = (PyLongObject *)long_mul(d, r);
+    if (t == NULL)
+        goto error;
+    e = (PyLongObject *)long_sub(p, t);
+    Py_CLEAR(t);
+    if (e == NULL)
+        goto error;
+    while (Py_SIZE(e) < 0) {
+        if (long_iadd(&e, d, 1) < 0 || long_iadd(&r, one, -1) < 0)
+            goto error;
+    }
+    while (long_compare(e, d) >= 0) {
+        if (long_iadd(&e, d, -1) < 0 || long_iadd(&r, one, 1) < 0)
+            goto error;
+    }
+    Py_DECREF(e);
+    Py_DECREF(p);
+    return r;
+
+  error:
+    Py_XDECREF(t);
+    Py_XDECREF(e);
+    Py_XDECREF(r);
+    Py_DECREF(p);
+    return NULL;
+}
+
+/* Divide 0 <= a < 2**(2*nbits) by d, where d has exactly nbits bits and
+   r == long_reciprocal(d, nbits), storing the quotient and remainder in
+   *pdiv and *prem.  This is Barrett reduction: the quotient estimate
+   floor((a >> (nbits-1)) * r / 2**(nbits+1)) is at most two less than the
+   true quotient, and costs two multiplications of about the size of the
+   quotient by nbits bits. */
+
+static int
+long_divrem_barrett(PyLongObject *a, PyLongObject *d, PyLongObject *r,
+                    Py_ssize_t nbits,
+                    PyLongObject **pdiv, PyLongObject **prem)
+{
+    PyLongObject *one = (PyLongObject *)_PyLong_GetOne();
+    PyLongObject *q, *rem = NULL, *t;
+
+    assert(Py_SIZE(a) >= 0);
+    q = (PyLongObject *)_PyLong_Rshift((PyObject *)a, nbits - 1);
+    if (q == NULL)
+        return -1;
+    t = (PyLongObject *)long_mul(q, r);
+    Py_DECREF(q);
+    if (t == NULL)
+        return -1;
+    q = (PyLongObject *)_PyLong_Rshift((PyObject *)t, nbits + 1);
+    Py_DECREF(t);
+    if (q == NULL)
+        return -1;
+    t = (PyLongObject *)long_mul(q, d);
+    if (t == NULL)
+        goto error;
+    rem = (PyLongObject *)long_sub(a, t);
+    Py_DECREF(t);
+    if (rem == NULL)
+        goto error;
+    while (long_compare(rem, d) >= 0) {
+        if (long_iadd(&rem, d, -1) < 0 || long_iadd(&q, one, 1) < 0)
+            goto error;
+    }
+    *pdiv = q;
+    *prem = rem;
+    return 0;
+
+  error:
+    Py_XDECREF(q);
+    Py_XDECREF(rem);
+    return -1;
+}
+
+/* The powers B**(chunk << j) at which the divide-and-conquer conversions
+   split their argument, computed once per conversion by repeated squaring
+   and shared by all levels of the recursion.  recip[j] is the reciprocal of
+   pow[j] (see long_reciprocal) once a division by pow[j] has needed it, else
+   NULL. */
+
+#define DECIMAL_DC_LEVELS 64
+
+typedef struct {
+    int size;
+    Py_ssize_t chunk;
+    PyLongObject *pow[DECIMAL_DC_LEVELS];
+    PyLongObject *recip[DECIMAL_DC_LEVELS];
+    Py_ssize_t nbits[DECIMAL_DC_LEVELS];
+} dc_powers;
+
+static void
+dc_powers_clear(dc_powers *pw)
+{
+    while (pw->size > 0) {
+        pw->size--;
+        Py_DECREF(pw->pow[pw->size]);
+        Py_XDECREF(pw->recip[pw->size]);
+    }
+}
+
+/* Append the next power of B to pw. */
+
+static int
+dc_powers_grow(dc_powers *pw, digit base)
+{
+    PyLongObject *p, *t;
+    size_t nbits;
+    Py_ssize_t i;
+
+    assert(pw->size < DECIMAL_DC_LEVELS);
+    if (pw->size == 0) {
+        p = (PyLongObject *)PyLong_FromUnsignedLong(base);
+        for (i = 1; p != NULL && i < pw->chunk; i <<= 1) {
+            t = (PyLongObject *)long_mul(p, p);
+            Py_SETREF(p, t);
+        }
+    }
+    else {
+        t = pw->pow[pw->size - 1];
+        p = (PyLongObject *)long_mul(t, t);
+    }
+    if (p == NULL)
+        return -1;
+    nbits = _PyLong_NumBits((PyObject *)p);
+    if (nbits == (size_t)-1 && PyErr_Occurred()) {
+        Py_DECREF(p);
+        return -1;
+    }
+    pw->pow[pw->size] = p;
+    pw->recip[pw->size] = NULL;
+    pw->nbits[pw->size] = (Py_ssize_t)nbits;
+    pw->size++;
+    return 0;
+}
+
+/* Divide 0 <= a < pw->pow[j]**2 by pw->pow[j].  If reused is false, this is
+   known to be the only division by pw->pow[j]. */
+
+static int
+dc_powers_divrem(dc_powers *pw, int j, PyLongObject *a, int reused,
+                 PyLongObject **pdiv, PyLongObject **prem)
+{
+    PyLongObject *d = pw->pow[j];
+
+    if (pw->recip[j] == NULL && Py_SIZE(d) > BARRETT_CUTOFF &&
+        (reused || Py_SIZE(d) > 2 * RECIPROCAL_CUTOFF)) {
+        pw->recip[j] = long_reciprocal(d, pw->nbits[j]);
+        if (pw->recip[j] == NULL)
+            return -1;
+    }
+    if (pw->recip[j] != NULL)
+        return long_divrem_barrett(a, d, pw->recip[j], pw->nbits[j],
+                                   pdiv, prem);
+    return long_divrem(a, d, pdiv, prem);
+}
+
+/* Convert the digit vector pin[0:size_a] (LSD first) to base
+   _PyLong_DECIMAL_BASE following Knuth (TAOCP, Volume 2 (3rd edn), section
+   4.4, Method 1b), storing the digits in pout, least significant first.
+   Return their number (0 for a zero vector), or -1 on error. */
+
+static Py_ssize_t
+long_to_decimal_digits(const digit *pin, Py_ssize_t size_a, digit *pout)
+{
+    Py_ssize_t size = 0, i, j;
+
+    for (i = size_a; --i >= 0; ) {
+        digit hi = pin[i];
+        for (j = 0; j < size; j++) {
+            twodigits z = (twodigits)pout[j] << PyLong_SHIFT | hi;
+            hi = (digit)(z / _PyLong_DECIMAL_BASE);
+            pout[j] = (digit)(z - (twodigits)hi *
+                              _PyLong_DECIMAL_BASE);
+        }
+        while (hi) {
+            pout[size++] = hi % _PyLong_DECIMAL_BASE;
+            hi /= _PyLong_DECIMAL_BASE;
+        }
+        /* check for keyboard interrupt */
+        SIGCHECK({
+                return -1;
+            });
+    }
+    return size;
+}
+
+/* Divide-and-conquer version of long_to_decimal_digits() for 0 <= a <
+   pw->pow[j]**2 (or a < pw->pow[0] if j < 0): a is split into quotient and
+   remainder by pw->pow[j], and each part converted recursively.  If pad is
+   true, the result is zero-padded to exactly pw->chunk << (j+1) digits.
+   Padded calls are for all but the most significant part of the number,
+   so at each level only the first unpadded call divides by a power that is
+   not used again. */
+
+static Py_ssize_t
+long_to_decimal_digits_dc(PyLongObject *a, dc_powers *pw, int j,
+                          digit *pout, int pad)
+{
+    PyLongObject *q, *r;
+    Py_ssize_t lo, hi;
+
+    if (!pad) {
+        /* Don't produce leading zeros. */
+        while (j >= 0 && long_compare(a, pw->pow[j]) < 0)
+            j--;
+    }
+    if (j < 0) {
+        Py_ssize_t size = long_to_decimal_digits(a->ob_digit, Py_SIZE(a),
+                                                 pout);
+        while (pad && size >= 0 && size < pw->chunk)
+            pout[size++] = 0;
+        return size;
+    }
+    if (dc_powers_divrem(pw, j, a, pad, &q, &r) < 0)
+        return -1;
+    lo = long_to_decimal_digits_dc(r, pw, j - 1, pout, 1);
+    Py_DECREF(r);
+    if (lo < 0) {
+        Py_DECREF(q);
+        return -1;
+    }
+    assert(lo == pw->chunk << j);
+    hi = long_to_decimal_digits_dc(q, pw, j - 1, pout + lo, pad);
+    Py_DECREF(q);
+    return hi < 0 ? -1 : lo + hi;
+}
+
+/* Convert |a| to base _PyLong_DECIMAL_BASE like long_to_decimal_digits(),
+   in O(M(n) log n) time for M(n) the cost of an n-digit multiplication. */
+
+static Py_ssize_t
+long_to_decimal_digits_large(PyLongObject *a, digit *pout)
+{
+    dc_powers pw;
+    PyLongObject *b;
+    size_t nbits;
+    Py_ssize_t size = -1;
+
+    pw.size = 0;
+    pw.chunk = INT_TO_STR_DC_CHUNK;
+    b = (PyLongObject *)long_abs(a);
+    if (b == NULL)
+        return -1;
+    nbits = _PyLong_NumBits((PyObject *)b);
+    if (nbits == (size_t)-1 && PyErr_Occurred())
+        goto done;
+    /* Grow the table until pow[-1]**2 > b. */
+    do {
+        if (dc_powers_grow(&pw, _PyLong_DECIMAL_BASE) < 0)
+            goto done;
+    } while (2 * ((size_t)pw.nbits[pw.size - 1] - 1) < nbits);
+    size = long_to_decimal_digits_dc(b, &pw, pw.size - 1, pout, 0);
+  done:
+    dc_powers_clear(&pw);
+    Py_DECREF(b);
+    return size;
+}
+
 /* Convert an integer to a base 10 string.  Returns a new non-shared
    string.  (Return value is non-shared so that callers can modify the
    returned value if necessary.) */
@@ -1588,7 +2070,7 @@ long_to_decimal_string_internal(PyObject *aa,
     PyLongObject *scratch, *a;
     PyObject *str = NULL;
     Py_ssize_t size, strlen, size_a, i, j;
-    digit *pout, *pin, rem, tenpow;
+    digit *pout, rem, tenpow;
     int negative;
     int d;
     enum PyUnicode_Kind kind;
@@ -1623,29 +2105,16 @@ long_to_decimal_string_internal(PyObject *aa,
     if (scratch == NULL)
         return -1;
 
-    /* convert array of base _PyLong_BASE digits in pin to an array of
-       base _PyLong_DECIMAL_BASE digits in pout, following Knuth (TAOCP,
-       Volume 2 (3rd edn), section 4.4, Method 1b). */
-    pin = a->ob_digit;
+    /* convert array of base _PyLong_BASE digits in a to an array of
+       base _PyLong_DECIMAL_BASE digits in pout */
     pout = scratch->ob_digit;
-    size = 0;
-    for (i = size_a; --i >= 0; ) {
-        digit hi = pin[i];
-        for (j = 0; j < size; j++) {
-            twodigits z = (twodigits)pout[j] << PyLong_SHIFT | hi;
-            hi = (digit)(z / _PyLong_DECIMAL_BASE);
-            pout[j] = (digit)(z - (twodigits)hi *
-                              _PyLong_DECIMAL_BASE);
-        }
-        while (hi) {
-            pout[size++] = hi % _PyLong_DECIMAL_BASE;
-            hi /= _PyLong_DECIMAL_BASE;
-        }
-        /* check for keyboard interrupt */
-        SIGCHECK({
-                Py_DECREF(scratch);
-                return -1;
-            });
+    if (size_a > INT_TO_STR_DC_CUTOFF)
+        size = long_to_decimal_digits_large(a, pout);
+    else
+        size = long_to_decimal_digits(a->ob_digit, size_a, pout);
+    if (size < 0) {
+        Py_DECREF(scratch);
+        return -1;
     }
     /* pout should have at least one digit, so that the case when a = 0
        works correctly */
@@ -2104,6 +2573,114 @@ long_from_binary_base(const char **str, int base, PyLongObject **res)
     return 0;
 }
 
+/* Return the int whose digits in base B are the chunks c[0:n], least
+   significant first, where B == base and pw->pow[j] == B**(pw->chunk << j).
+   Longer inputs are split at the largest power below n, and the two
+   halves converted recursively and combined with one multiplication. */
+
+static PyLongObject *
+long_from_chunks_dc(const digit *c, Py_ssize_t n, twodigits base,
+                    dc_powers *pw, int j)
+{
+    PyLongObject *lo, *hi, *z;
+    Py_ssize_t lo_n, i;
+
+    if (n <= pw->chunk) {
+        /* Horner's rule, as in PyLong_FromString().  Since B < PyLong_BASE,
+           n digits are enough. */
+        z = _PyLong_New(n);
+        if (z == NULL)
+            return NULL;
+        Py_SET_SIZE(z, 0);
+        for (i = n; --i >= 0; ) {
+            twodigits acc = c[i];
+            digit *pz = z->ob_digit, *pzstop = pz + Py_SIZE(z);
+            for (; pz < pzstop; ++pz) {
+                acc += (twodigits)*pz * base;
+                *pz = (digit)(acc & PyLong_MASK);
+                acc >>= PyLong_SHIFT;
+            }
+            if (acc) {
+                assert(Py_SIZE(z) < n);
+                *pz = (digit)acc;
+                Py_SET_SIZE(z, Py_SIZE(z) + 1);
+            }
+        }
+        return z;
+    }
+    while ((pw->chunk << j) >= n)
+        j--;
+    assert(j >= 0);
+    lo_n = pw->chunk << j;
+    lo = long_from_chunks_dc(c, lo_n, base, pw, j - 1);
+    if (lo == NULL)
+        return NULL;
+    hi = long_from_chunks_dc(c + lo_n, n - lo_n, base, pw, j - 1);
+    if (hi == NULL) {
+        Py_DECREF(lo);
+        return NULL;
+    }
+    z = (PyLongObject *)long_mul(hi, pw->pow[j]);
+    Py_DECREF(hi);
+    if (z != NULL)
+        long_iadd(&z, lo, 1);
+    Py_DECREF(lo);
+    return z;
+}
+
+/* Return the value of the digits in str[0:end] (with single underscores
+   between them, already validated) in the given non-binary base.  ndigits
+   is their number; convwidth and convmultmax are as in PyLong_FromString().
+   The input is first cut into chunks of convwidth digits, aligned at the
+   least significant end, which long_from_chunks_dc() then combines. */
+
+static PyLongObject *
+long_from_string_large(const char *str, const char *end, Py_ssize_t ndigits,
+                       int base, int convwidth, twodigits convmultmax)
+{
+    dc_powers pw;
+    PyLongObject *z = NULL;
+    digit *c;
+    twodigits acc = 0;
+    Py_ssize_t n, i;
+    int k = 0, width;
+
+    n = (ndigits + convwidth - 1) / convwidth;
+    c = PyMem_New(digit, n);
+    if (c == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    /* The most significant chunk takes the leftover digits. */
+    width = (int)(ndigits - (n - 1) * convwidth);
+    i = n;
+    for (; str < end; str++) {
+        if (*str == '_')
+            continue;
+        acc = acc * base + _PyLong_DigitValue[Py_CHARMASK(*str)];
+        if (++k == width) {
+            assert(i > 0 && acc < convmultmax);
+            c[--i] = (digit)acc;
+            acc = 0;
+            k = 0;
+            width = convwidth;
+        }
+    }
+    assert(i == 0);
+
+    pw.size = 0;
+    pw.chunk = STR_TO_INT_DC_CHUNK;
+    while ((pw.chunk << pw.size) < n) {
+        if (dc_powers_grow(&pw, (digit)convmultmax) < 0)
+            goto done;
+    }
+    z = long_from_chunks_dc(c, n, convmultmax, &pw, pw.size - 1);
+  done:
+    dc_powers_clear(&pw);
+    PyMem_Free(c);
+    return z;
+}
+
 /* Parses an int from a bytestring. Leading and trailing whitespace will be
  * ignored.
  *
@@ -2336,82 +2913,93 @@ digit beyond the first.
                             "too many digits in integer");
             return NULL;
         }
-        size_z = (Py_ssize_t)fsize_z;
-        /* Uncomment next line to test exceedingly rare copy code */
-        /* size_z = 1; */
-        assert(size_z > 0);
-        z = _PyLong_New(size_z);
-        if (z == NULL) {
-            return NULL;
+        if (digits > (Py_ssize_t)convwidth_base[base] * STR_TO_INT_DC_CUTOFF) {
+            z = long_from_string_large(str, scan, digits, base,
+                                       convwidth_base[base],
+                                       convmultmax_base[base]);
+            if (z == NULL) {
+                return NULL;
+            }
+            str = scan;
         }
-        Py_SET_SIZE(z, 0);
-
-        /* `convwidth` consecutive input digits are treated as a single
-         * digit in base `convmultmax`.
-         */
-        convwidth = convwidth_base[base];
-        convmultmax = convmultmax_base[base];
-
-        /* Work ;-) */
-        while (str < scan) {
-            if (*str == '_') {
-                str++;
-                continue;
+        else {
+            size_z = (Py_ssize_t)fsize_z;
+            /* Uncomment next line to test exceedingly rare copy code */
+            /* size_z = 1; */
+            assert(size_z > 0);
+            z = _PyLong_New(size_z);
+            if (z == NULL) {
+                return NULL;
             }
-            /* grab up to convwidth digits from the input string */
-            c = (digit)_PyLong_DigitValue[Py_CHARMASK(*str++)];
-            for (i = 1; i < convwidth && str != scan; ++str) {
+            Py_SET_SIZE(z, 0);
+
+            /* `convwidth` consecutive input digits are treated as a single
+             * digit in base `convmultmax`.
+             */
+            convwidth = convwidth_base[base];
+            convmultmax = convmultmax_base[base];
+
+            /* Work ;-) */
+            while (str < scan) {
                 if (*str == '_') {
+                    str++;
                     continue;
                 }
-                i++;
-                c = (twodigits)(c *  base +
-                                (int)_PyLong_DigitValue[Py_CHARMASK(*str)]);
-                assert(c < PyLong_BASE);
-            }
+                /* grab up to convwidth digits from the input string */
+                c = (digit)_PyLong_DigitValue[Py_CHARMASK(*str++)];
+                for (i = 1; i < convwidth && str != scan; ++str) {
+                    if (*str == '_') {
+                        continue;
+                    }
+                    i++;
+                    c = (twodigits)(c *  base +
+                                    (int)_PyLong_DigitValue[Py_CHARMASK(*str)]);
+                    assert(c < PyLong_BASE);
+                }
 
-            convmult = convmultmax;
-            /* Calculate the shift only if we couldn't get
-             * convwidth digits.
-             */
-            if (i != convwidth) {
-                convmult = base;
-                for ( ; i > 1; --i) {
-                    convmult *= base;
+                convmult = convmultmax;
+                /* Calculate the shift only if we couldn't get
+                 * convwidth digits.
+                 */
+                if (i != convwidth) {
+                    convmult = base;
+                    for ( ; i > 1; --i) {
+                        convmult *= base;
+                    }
                 }
-            }
 
-            /* Multiply z by convmult, and add c. */
-            pz = z->ob_digit;
-            pzstop = pz + Py_SIZE(z);
-            for (; pz < pzstop; ++pz) {
-                c += (twodigits)*pz * convmult;
-                *pz = (digit)(c & PyLong_MASK);
-                c >>= PyLong_SHIFT;
-            }
-            /* carry off the current end? */
-            if (c) {
-                assert(c < PyLong_BASE);
-                if (Py_SIZE(z) < size_z) {
-                    *pz = (digit)c;
-                    Py_SET_SIZE(z, Py_SIZE(z) + 1);
+                /* Multiply z by convmult, and add c. */
+                pz = z->ob_digit;
+                pzstop = pz + Py_SIZE(z);
+                for (; pz < pzstop; ++pz) {
+                    c += (twodigits)*pz * convmult;
+                    *pz = (digit)(c & PyLong_MASK);
+                    c >>= PyLong_SHIFT;
                 }
-                else {
-                    PyLongObject *tmp;
-                    /* Extremely rare.  Get more space. */
-                    assert(Py_SIZE(z) == size_z);
-                    tmp = _PyLong_New(size_z + 1);
-                    if (tmp == NULL) {
+                /* carry off the current end? */
+                if (c) {
+                    assert(c < PyLong_BASE);
+                    if (Py_SIZE(z) < size_z) {
+                        *pz = (digit)c;
+                        Py_SET_SIZE(z, Py_SIZE(z) + 1);
+                    }
+                    else {
+                        PyLongObject *tmp;
+                        /* Extremely rare.  Get more space. */
+                        assert(Py_SIZE(z) == size_z);
+                        tmp = _PyLong_New(size_z + 1);
+                        if (tmp == NULL) {
+                            Py_DECREF(z);
+                            return NULL;
+                        }
+                        memcpy(tmp->ob_digit,
+                               z->ob_digit,
+                               sizeof(digit) * size_z);
                         Py_DECREF(z);
-                        return NULL;
+                        z = tmp;
+                        z->ob_digit[size_z] = (digit)c;
+                        ++size_z;
                     }
-                    memcpy(tmp->ob_digit,
-                           z->ob_digit,
-                           sizeof(digit) * size_z);
-                    Py_DECREF(z);
-                    z = tmp;
-                    z->ob_digit[size_z] = (digit)c;
-                    ++size_z;
                 }
             }
         }
@@ -2433,7 +3021,10 @@ digit beyond the first.
         goto onError;
     }
     if (sign < 0) {
-        Py_SET_SIZE(z, -(Py_SIZE(z)));
+        _PyLong_Negate(&z);
+        if (z == NULL) {
+            return NULL;
+        }
     }
     while (*str && Py_ISSPACE(*str)) {
         str++;
@@ -2525,6 +3116,8 @@ PyLong_FromUnicodeObject(PyObject *u, int base)
 /* forward */
 static PyLongObject *x_divrem
     (PyLongObject *, PyLongObject *, PyLongObject **);
+static PyLongObject *x_divrem_barrett
+    (PyLongObject *, PyLongObject *, PyLongObject **);
 static PyObject *long_long(PyObject *v);
 
 /* Int division with remainder, top-level routine */
@@ -2565,6 +3158,11 @@ long_divrem(PyLongObject *a, PyLongObject *b,
             return -1;
         }
     }
+    else if (size_b > DIVISION_CUTOFF && size_a - size_b > DIVISION_CUTOFF) {
+        z = x_divrem_barrett(a, b, prem);
+        if (z == NULL)
+            return -1;
+    }
     else {
         z = x_divrem(a, b, prem);
         if (z == NULL)
@@ -2720,6 +3318,101 @@ x_divrem(PyLongObject *v1, PyLongObject *w1, PyLongObject **prem)
     return long_normalize(a);
 }
 
+/* Unsigned int division with remainder for large divisors, with the same
+   interface as x_divrem().  After normalizing w1 to exactly size_w digits'
+   worth of bits, v1 is divided one block at a time from the top: each block
+   is the previous remainder followed by the next size_w digits of v1, and
+   is divided by Barrett reduction (see long_divrem_barrett) using the
+   reciprocal of w1, giving at most size_w quotient digits.  The cost is
+   that of computing the reciprocal plus two multiplications of size_w-digit
+   numbers per block, instead of size_w**2 digit operations per block. */
+
+static PyLongObject *
+x_divrem_barrett(PyLongObject *v1, PyLongObject *w1, PyLongObject **prem)
+{
+    PyLongObject *v, *w = NULL, *recip = NULL, *rem = NULL, *a = NULL;
+    PyLongObject *cur, *q, *r;
+    Py_ssize_t i, n, nbits, nblocks, size_v, size_w, size_rem;
+    int d;
+    digit carry;
+
+    *prem = NULL;
+    size_v = Py_ABS(Py_SIZE(v1));
+    size_w = Py_ABS(Py_SIZE(w1));
+    assert(size_v >= size_w && size_w >= 2);
+    v = _PyLong_New(size_v + 1);
+    if (v == NULL)
+        return NULL;
+    w = _PyLong_New(size_w);
+    if (w == NULL)
+        goto error;
+
+    /* normalize as in x_divrem() */
+    d = PyLong_SHIFT - bit_length_digit(w1->ob_digit[size_w-1]);
+    carry = v_lshift(w->ob_digit, w1->ob_digit, size_w, d);
+    assert(carry == 0);
+    (void)carry;
+    v->ob_digit[size_v] = v_lshift(v->ob_digit, v1->ob_digit, size_v, d);
+    v = long_normalize(v);
+    size_v = Py_SIZE(v);
+
+    nbits = size_w * PyLong_SHIFT;
+    recip = long_reciprocal(w, nbits);
+    if (recip == NULL)
+        goto error;
+    nblocks = (size_v + size_w - 1) / size_w;
+    a = _PyLong_New(nblocks * size_w);
+    if (a == NULL)
+        goto error;
+    memset(a->ob_digit, 0, Py_SIZE(a) * sizeof(digit));
+    rem = (PyLongObject *)PyLong_FromLong(0);
+    if (rem == NULL)
+        goto error;
+
+    for (i = nblocks; --i >= 0; ) {
+        SIGCHECK({
+                goto error;
+            });
+        n = Py_MIN(size_w, size_v - i * size_w);
+        size_rem = Py_SIZE(rem);
+        cur = _PyLong_New(size_w + size_rem);
+        if (cur == NULL)
+            goto error;
+        memcpy(cur->ob_digit, v->ob_digit + i * size_w, n * sizeof(digit));
+        memset(cur->ob_digit + n, 0, (size_w - n) * sizeof(digit));
+        memcpy(cur->ob_digit + size_w, rem->ob_digit,
+               size_rem * sizeof(digit));
+        cur = long_normalize(cur);
+        n = long_divrem_barrett(cur, w, recip, nbits, &q, &r);
+        Py_DECREF(cur);
+        if (n < 0)
+            goto error;
+        assert(Py_SIZE(q) <= size_w);
+        memcpy(a->ob_digit + i * size_w, q->ob_digit,
+               Py_SIZE(q) * sizeof(digit));
+        Py_DECREF(q);
+        Py_SETREF(rem, r);
+    }
+
+    /* unshift remainder */
+    *prem = (PyLongObject *)_PyLong_Rshift((PyObject *)rem, d);
+    if (*prem == NULL)
+        goto error;
+    Py_DECREF(rem);
+    Py_DECREF(recip);
+    Py_DECREF(w);
+    Py_DECREF(v);
+    return long_normalize(a);
+
+  error:
+    Py_XDECREF(a);
+    Py_XDECREF(rem);
+    Py_XDECREF(recip);
+    Py_XDECREF(w);
+    Py_DECREF(v);
+    return NULL;
+}
+
 /* For a nonzero PyLong a, express a in the form x * 2**e, with 0.5 <=
    abs(x) < 1.0 and e >= 0; return x and put e in *e.  Here x is
    rounded to DBL_MANT_DIG significant bits using round-half-to-even.
@@ -3248,6 +3941,7 @@ kmul_split(PyLongObject *n,
 }
 
 static PyLongObject *k_lopsided_mul(PyLongObject *a, PyLongObject *b);
+static PyLongObject *toom3_mul(PyLongObject *a, PyLongObject *b);
 
 /* Karatsuba multiplication.  Ignores the input signs, and returns the
  * absolute value of the product (or NULL if error).
@@ -3306,6 +4000,10 @@ k_mul(PyLongObject *a, PyLongObject *b)
     if (2 * asize <= bsize)
         return k_lopsided_mul(a, b);
 
+    /* Large balanced inputs are faster to split into three pieces. */
+    if (asize > (a == b ? TOOM3_SQUARE_CUTOFF : TOOM3_CUTOFF))
+        return toom3_mul(a, b);
+
     /* Split a & b into hi & lo pieces. */
     shift = bsize >> 1;
     if (kmul_split(a, shift, &ah, &al) < 0) goto fail;
@@ -3528,6 +4226,169 @@ k_lopsided_mul(PyLongObject *a, PyLongObject *b)
     return NULL;
 }
 
+/* Split |n| into pieces n2*X**2 + n1*X + n0, where X = BASE**k, and store
+   the values of that polynomial at 0, 1, -1, -2 and infinity in v[0:5].
+   Returns 0 on success, -1 on failure (leaving v cleared). */
+static int
+toom3_evaluate(PyLongObject *n, Py_ssize_t k, PyLongObject *v[5])
+{
+    PyLongObject *rest, *t;
+    int i;
+
+    for (i = 0; i < 5; i++)
+        v[i] = NULL;
+    if (kmul_split(n, k, &rest, &v[0]) < 0)
+        return -1;
+    if (kmul_split(rest, k, &v[4], &t) < 0) {
+        Py_DECREF(rest);
+        goto fail;
+    }
+    Py_DECREF(rest);
+    /* v[1] = n0 + n1 + n2 and v[2] = n0 - n1 + n2 */
+    rest = (PyLongObject *)long_add(v[0], v[4]);
+    if (rest == NULL) {
+        Py_DECREF(t);
+        goto fail;
+    }
+    v[1] = (PyLongObject *)long_add(rest, t);
+    v[2] = (PyLongObject *)long_sub(rest, t);
+    Py_DECREF(rest);
+    Py_DECREF(t);
+    if (v[1] == NULL || v[2] == NULL)
+        goto fail;
+    /* v[3] = n0 - 2*n1 + 4*n2 = 2*(v[2] + n2) - n0 */
+    t = (PyLongObject *)long_add(v[2], v[4]);
+    if (t == NULL)
+        goto fail;
+    v[3] = (PyLongObject *)_PyLong_Lshift((PyObject *)t, 1);
+    Py_DECREF(t);
+    if (v[3] == NULL || long_iadd(&v[3], v[0], -1) < 0)
+        goto fail;
+    return 0;
+
+  fail:
+    for (i = 0; i < 5; i++)
+        Py_CLEAR(v[i]);
+    return -1;
+}
+
+/* Toom-Cook 3-way multiplication.  Ignores the input signs, and returns the
+ * absolute value of the product (or NULL if error).
+ *
+ * With both inputs split into three pieces of k digits as in
+ * toom3_evaluate(), the product is a polynomial of degree 4 in X = BASE**k.
+ * It is determined by its values at 0, 1, -1, -2 and infinity, which are
+ * the products of the inputs' values there:  5 multiplications of about
+ * bsize/3 digits, against Karatsuba's 3 of bsize/2, for O(n**1.465)
+ * instead of O(n**1.585) digit operations.  The coefficients are recovered
+ * by Bodrato's interpolation sequence, whose only divisions are exact ones
+ * by 2 and 3.
+ */
+static PyLongObject *
+toom3_mul(PyLongObject *a, PyLongObject *b)
+{
+    const Py_ssize_t asize = Py_ABS(Py_SIZE(a));
+    const Py_ssize_t bsize = Py_ABS(Py_SIZE(b));
+    const Py_ssize_t k = (bsize + 2) / 3;
+    PyLongObject *va[5], *vb[5], *r[5] = {NULL, NULL, NULL, NULL, NULL};
+    PyLongObject *ret, *t, *rem, *three = NULL;
+    int i;
+
+    assert(asize <= bsize);
+    if (toom3_evaluate(a, k, va) < 0)
+        return NULL;
+    if (a == b) {
+        for (i = 0; i < 5; i++) {
+            vb[i] = va[i];
+            Py_INCREF(vb[i]);
+        }
+    }
+    else if (toom3_evaluate(b, k, vb) < 0) {
+        for (i = 0; i < 5; i++)
+            Py_DECREF(va[i]);
+        return NULL;
+    }
+
+    three = (PyLongObject *)PyLong_FromLong(3);
+    if (three == NULL)
+        goto fail;
+
+    /* Pointwise products r[i] = a(x)*b(x) at the five points. */
+    for (i = 0; i < 5; i++) {
+        r[i] = (PyLongObject *)long_mul(va[i], vb[i]);
+        Py_CLEAR(va[i]);
+        Py_CLEAR(vb[i]);
+        if (r[i] == NULL)
+            goto fail;
+    }
+
+    /* Interpolation.  With r = [r(0), r(1), r(-1), r(-2), r(inf)]:
+     *     r3 = (r(-2) - r(1)) / 3
+     *     r1 = (r(1) - r(-1)) / 2
+     *     r2 = r(-1) - r(0)
+     *     r3 = (r2 - r3) / 2 + 2*r(inf)
+     *     r2 = r2 + r1 - r(inf)
+     *     r1 = r1 - r3
+     * leaves the coefficients of X**0 ... X**4 in r[0], r[1], r[2], r[3]
+     * and r[4].
+     */
+    if (long_iadd(&r[3], r[1], -1) < 0)
+        goto fail;
+    if (long_divrem(r[3], three, &t, &rem) < 0)
+        goto fail;
+    assert(Py_SIZE(rem) == 0);
+    Py_DECREF(rem);
+    Py_SETREF(r[3], t);
+    if (long_iadd(&r[1], r[2], -1) < 0)
+        goto fail;
+    Py_SETREF(r[1], (PyLongObject *)_PyLong_Rshift((PyObject *)r[1], 1));
+    if (r[1] == NULL || long_iadd(&r[2], r[0], -1) < 0)
+        goto fail;
+    t = (PyLongObject *)long_sub(r[2], r[3]);
+    if (t == NULL)
+        goto fail;
+    Py_SETREF(r[3], (PyLongObject *)_PyLong_Rshift((PyObject *)t, 1));
+    Py_DECREF(t);
+    if (r[3] == NULL)
+        goto fail;
+    t = (PyLongObject *)_PyLong_Lshift((PyObject *)r[4], 1);
+    if (t == NULL)
+        goto fail;
+    i = long_iadd(&r[3], t, 1);
+    Py_DECREF(t);
+    if (i < 0 || long_iadd(&r[2], r[1], 1) < 0 ||
+        long_iadd(&r[2], r[4], -1) < 0 || long_iadd(&r[1], r[3], -1) < 0)
+        goto fail;
+    Py_CLEAR(three);
+
+    /* Add the coefficients into the result at their offsets.  Each is
+       non-negative and, shifted, no larger than the product, so it fits in
+       the space left above its offset, and there is no final carry. */
+    ret = _PyLong_New(asize + bsize);
+    if (ret == NULL)
+        goto fail;
+    memset(ret->ob_digit, 0, Py_SIZE(ret) * sizeof(digit));
+    for (i = 0; i < 5; i++) {
+        assert(Py_SIZE(r[i]) >= 0);
+        if (Py_SIZE(r[i]) != 0) {
+            assert(i * k + Py_SIZE(r[i]) <= Py_SIZE(ret));
+            (void)v_iadd(ret->ob_digit + i * k, Py_SIZE(ret) - i * k,
+                         r[i]->ob_digit, Py_SIZE(r[i]));
+        }
+        Py_CLEAR(r[i]);
+    }
+    return long_normalize(ret);
+
+  fail:
+    for (i = 0; i < 5; i++) {
+        Py_XDECREF(va[i]);
+        Py_XDECREF(vb[i]);
+        Py_XDECREF(r[i]);
+    }
+    Py_XDECREF(three);
+    return NULL;
+}
+
 static PyObject *
 long_mul(PyLongObject *a, PyLongObject *b)
 {
@@ -3538,7 +4399,7 @@ long_mul(PyLongObject *a, PyLongObject *b)
     /* fast path for single-digit multiplication */
     if (Py_ABS(Py_SIZE(a)) <= 1 && Py_ABS(Py_SIZE(b)) <= 1) {
         stwodigits v = (stwodigits)(MEDIUM_VALUE(a)) * MEDIUM_VALUE(b);
-        return PyLong_FromLongLong((long long)v);
+        return _PyLong_FromSTwoDigits(v);
     }
 
     z = k_mul(a, b);
@@ -4102,6 +4963,11 @@ long_pow(PyObject *v, PyObject *w, PyObject *x)
     PyLongObject *z = NULL;  /* accumulated result */
     Py_ssize_t i, j, k;             /* counters */
     PyLongObject *temp = NULL;
+    PyLongObject *quot = NULL;
+
+    /* Reciprocal of a large modulus c, and c's bit length. */
+    PyLongObject *c_recip = NULL;
+    Py_ssize_t c_nbits = 0;
 
     /* 5-ary values.  If the exponent is large enough, table is
      * precomputed so that table[i] == a**i % c for i in range(32).
@@ -4194,15 +5060,28 @@ long_pow(PyObject *v, PyObject *w, PyObject *x)
               while the "large exponent" case multiplies directly by base 31
               times.  It can be unboundedly faster to multiply by
               base % modulus instead.
+           3. If base >= modulus and the modulus is large enough for the
+              reductions below to use its reciprocal, which requires
+              reduced operands.
            We could _always_ do this reduction, but l_divmod() isn't cheap,
            so we only do it when it buys something. */
-        if (Py_SIZE(a) < 0 || Py_SIZE(a) > Py_SIZE(c)) {
+        if (Py_SIZE(a) < 0 || Py_SIZE(a) > Py_SIZE(c) ||
+            (Py_SIZE(c) > DIVISION_CUTOFF && long_compare(a, c) >= 0)) {
             if (l_divmod(a, c, NULL, &temp) < 0)
                 goto Error;
             Py_DECREF(a);
             a = temp;
             temp = NULL;
         }
+
+        /* Dividing by a large modulus is much faster with its reciprocal,
+           computed once here (see long_divrem_barrett). */
+        if (Py_SIZE(c) > DIVISION_CUTOFF) {
+            c_nbits = (Py_ssize_t)_PyLong_NumBits((PyObject *)c);
+            c_recip = long_reciprocal(c, c_nbits);
+            if (c_recip == NULL)
+                goto Error;
+        }
     }
 
     /* At this point a, b, and c are guaranteed non-negative UNLESS
@@ -4217,7 +5096,17 @@ long_pow(PyObject *v, PyObject *w, PyObject *x)
      */
 #define REDUCE(X)                                       \
     do {                                                \
-        if (c != NULL) {                                \
+        if (c_recip != NULL) {                          \
+            if (long_divrem_barrett(X, c, c_recip,      \
+                                    c_nbits, &quot,     \
+                                    &temp) < 0)         \
+                goto Error;                             \
+            Py_CLEAR(quot);                             \
+            Py_XDECREF(X);                              \
+            X = temp;                                   \
+            temp = NULL;                                \
+        }                                               \
+        else if (c != NULL) {                           \
             if (l_divmod(X, c, NULL, &temp) < 0)        \
                 goto Error;                             \
             Py_XDECREF(X);                              \
@@ -4293,6 +5182,7 @@ long_pow(PyObject *v, PyObject *w, PyObject *x)
     Py_DECREF(a);
     Py_DECREF(b);
     Py_XDECREF(c);
+    Py_XDECREF(c_recip);
     Py_XDECREF(temp);
     return (PyObject *)z;
 }
@@ -4877,7 +5767,12 @@ _PyLong_GCD(PyObject *aarg, PyObject *barg)
     x = PyLong_AsLongLong((PyObject *)a);
     y = PyLong_AsLongLong((PyObject *)b);
 #else
-# error "_PyLong_GCD"
+    /* a and b have at most two digits, so they fit into a stwodigits */
+    x = y = 0;
+    for (k = (int)Py_ABS(Py_SIZE(a)); --k >= 0; )
+        x = (x << PyLong_SHIFT) | a->ob_digit[k];
+    for (k = (int)Py_ABS(Py_SIZE(b)); --k >= 0; )
+        y = (y << PyLong_SHIFT) | b->ob_digit[k];
 #endif
     x = Py_ABS(x);
     y = Py_ABS(y);
@@ -4895,7 +5790,7 @@ _PyLong_GCD(PyObject *aarg, PyObject *barg)
 #elif LLONG_MAX >> PyLong_SHIFT >> PyLong_SHIFT
     return PyLong_FromLongLong(x);
 #else
-# error "_PyLong_GCD"
+    return _PyLong_FromSTwoDigits(x);
 #endif
 
 error:
@@ -5310,8 +6205,13 @@ popcount_digit(digit d)
 {
     // digit can be larger than uint32_t, but only PyLong_SHIFT bits
     // of it will be ever used.
+#if PyLong_SHIFT > 32
+    Py_BUILD_ASSERT(PyLong_SHIFT <= 64);
+    return _Py_popcount32((uint32_t)d) + _Py_popcount32((uint32_t)(d >> 32));
+#else
     Py_BUILD_ASSERT(PyLong_SHIFT <= 32);
     return _Py_popcount32((uint32_t)d);
+#endif
 }
 
 /*[clinic input]
@@ -5623,7 +6523,7 @@ PyTypeObject PyLong_Type = {
     "int",                                      /* tp_name */
     offsetof(PyLongObject, ob_digit),           /* tp_basicsize */
     sizeof(digit),                              /* tp_itemsize */
-    0,                                          /* tp_dealloc */
+    long_dealloc,                               /* tp_dealloc */
     0,                                          /* tp_vectorcall_offset */
     0,                                          /* tp_getattr */
     0,                                          /* tp_setattr */
@@ -5705,6 +6605,11 @@ PyLong_GetInfo(void)
 int
 _PyLong_Init(PyInterpreterState *interp)
 {
+    /* The small ints are stored in a single digit. */
+    Py_BUILD_ASSERT(SMALL_ALLOC_MARK > PyLong_MASK);
+    Py_BUILD_ASSERT(NSMALLPOSINTS <= PyLong_MASK);
+    Py_BUILD_ASSERT(NSMALLNEGINTS <= PyLong_MASK);
+
     for (Py_ssize_t i=0; i < NSMALLNEGINTS + NSMALLPOSINTS; i++) {
         sdigit ival = (sdigit)i - NSMALLNEGINTS;
         int size = (ival < 0) ? -1 : ((ival == 0) ? 0 : 1);
@@ -5715,7 +6620,7 @@ _PyLong_Init(PyInterpreterState *interp)
         }
 
         Py_SET_SIZE(v, size);
-        v->ob_digit[0] = (digit)abs(ival);
+        v->ob_digit[0] = (digit)Py_ABS(ival);
 
         interp->small_ints[i] = v;
     }
@@ -5735,10 +6640,40 @@ _PyLong_InitTypes(void)
     return 0;
 }
 
+void
+_PyLong_ClearFreeList(PyInterpreterState *interp)
+{
+    struct _Py_long_state *state = &interp->long_state;
+    PyLongObject *v = state->free_list;
+    while (v != NULL) {
+        PyLongObject *next = (PyLongObject *) Py_TYPE(v);
+        PyObject_Free(v);
+        v = next;
+    }
+    state->free_list = NULL;
+    state->numfree = 0;
+}
+
 void
 _PyLong_Fini(PyInterpreterState *interp)
 {
     for (Py_ssize_t i = 0; i < NSMALLNEGINTS + NSMALLPOSINTS; i++) {
         Py_CLEAR(interp->small_ints[i]);
     }
+    _PyLong_ClearFreeList(interp);
+#ifdef Py_DEBUG
+    struct _Py_long_state *state = &interp->long_state;
+    state->numfree = -1;
+#endif
+}
+
+/* Print summary info about the state of the optimized allocator */
+void
+_PyLong_DebugMallocStats(FILE *out)
+{
+    struct _Py_long_state *state = get_long_state();
+    _PyDebugAllocatorStats(out,
+                           "free PyLongObject",
+                           state->numfree,
+                           SMALL_ALLOC_SIZE);
 }
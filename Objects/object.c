@@ -1825,6 +1825,7 @@ _PyTypes_Init(void)
     INIT_TYPE(PyEnum_Type);
     INIT_TYPE(PyFloat_Type);
     INIT_TYPE(PyFrame_Type);
+    INIT_TYPE(PyFrozenDict_Type);
     INIT_TYPE(PyFrozenSet_Type);
     INIT_TYPE(PyFunction_Type);
     INIT_TYPE(PyGen_Type);
@@ -2009,6 +2010,7 @@ _PyObject_DebugTypeStats(FILE *out)
     _PyFloat_DebugMallocStats(out);
     _PyFrame_DebugMallocStats(out);
     _PyList_DebugMallocStats(out);
+    _PyLong_DebugMallocStats(out);
     _PyTuple_DebugMallocStats(out);
 }
 
@@ -1,5 +1,7 @@
 #include "Python.h"
+#include "pycore_interp.h"         // PyInterpreterState.tstate_head
 #include "pycore_pymem.h"         // _PyTraceMalloc_Config
+#include "pycore_pystate.h"       // _PyThreadState_GET()
 
 #include <stdbool.h>
 
@@ -143,6 +145,97 @@ _PyObject_ArenaVirtualFree(void *ctx, void *ptr, size_t size)
 }
 
 #elif defined(ARENAS_USE_MMAP)
+/* Huge pages (-X hugepages).
+ *
+ * Only pymalloc arenas are backed by huge pages: new_arena() calls
+ * _PyObject_ArenaMmapHuge() directly, with the GIL held, which protects the
+ * state below.  Other users of the arena allocator always get plain mmap()
+ * memory.
+ *
+ * Arenas whose size is a multiple of HUGE_PAGE_SIZE are first tried with
+ * explicit huge pages (MAP_HUGETLB), which only succeeds if the
+ * administrator reserved some.  Otherwise, the memory is mapped at a
+ * HUGE_PAGE_SIZE boundary and the kernel is asked to back it with
+ * transparent huge pages.  Smaller arenas, which divide HUGE_PAGE_SIZE, are
+ * carved out of such regions, so that consecutive arenas share a huge
+ * page.  Unmapping one of them would split the huge page, so a region is
+ * only unmapped as a whole once all its arenas were freed, see
+ * free_huge_arena().
+ *
+ * Whether the kernel actually backs an advised region with a transparent
+ * huge page is not known here: sys._debugmallocstats() reports the number
+ * of regions advised, not the huge pages obtained.
+ */
+#define HUGE_PAGE_SIZE ((size_t)2 << 20)    /* 2 MiB */
+
+static int use_hugepages = 0;
+/* Unused part of the last region advised for transparent huge pages */
+static char *thp_spare = NULL;
+static size_t thp_spare_size = 0;
+/* Number of allocations backed by explicit huge pages */
+static size_t nhugetlb_allocated = 0;
+/* Total number of HUGE_PAGE_SIZE regions advised for transparent huge
+   pages */
+static size_t nthp_advised_regions = 0;
+
+/* Map 'size' bytes aligned on HUGE_PAGE_SIZE and advise the kernel to back
+   them with transparent huge pages.  'size' must be a multiple of
+   HUGE_PAGE_SIZE. */
+static void *
+mmap_thp(size_t size)
+{
+    char *ptr = mmap(NULL, size + HUGE_PAGE_SIZE, PROT_READ|PROT_WRITE,
+                     MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+        return NULL;
+    }
+    char *aligned = _Py_ALIGN_UP(ptr, HUGE_PAGE_SIZE);
+    if (aligned != ptr) {
+        munmap(ptr, aligned - ptr);
+        munmap(aligned + size, ptr + HUGE_PAGE_SIZE - aligned);
+    }
+    else {
+        munmap(aligned + size, HUGE_PAGE_SIZE);
+    }
+#ifdef MADV_HUGEPAGE
+    (void)madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+    nthp_advised_regions += size / HUGE_PAGE_SIZE;
+    return aligned;
+}
+
+static void *
+_PyObject_ArenaMmapHuge(size_t size)
+{
+    void *ptr;
+    if (size % HUGE_PAGE_SIZE == 0) {
+#ifdef MAP_HUGETLB
+        ptr = mmap(NULL, size, PROT_READ|PROT_WRITE,
+                   MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+        if (ptr != MAP_FAILED) {
+            nhugetlb_allocated++;
+            return ptr;
+        }
+#endif
+        return mmap_thp(size);
+    }
+
+    assert(HUGE_PAGE_SIZE % size == 0);
+    if (thp_spare_size == 0) {
+        thp_spare = mmap_thp(HUGE_PAGE_SIZE);
+        if (thp_spare == NULL) {
+            return NULL;
+        }
+        thp_spare_size = HUGE_PAGE_SIZE;
+    }
+    /* the sizes are powers of two, so the spare region stays aligned */
+    assert(thp_spare_size % size == 0);
+    ptr = thp_spare;
+    thp_spare += size;
+    thp_spare_size -= size;
+    return ptr;
+}
+
 static void *
 _PyObject_ArenaMmap(void *ctx, size_t size)
 {
@@ -175,6 +268,14 @@ _PyObject_ArenaFree(void *ctx, void *ptr, size_t size)
 }
 #endif
 
+void
+_PyObject_SetArenaHugePages(int enabled)
+{
+#ifdef ARENAS_USE_MMAP
+    use_hugepages = enabled;
+#endif
+}
+
 #define MALLOC_ALLOC {NULL, _PyMem_RawMalloc, _PyMem_RawCalloc, _PyMem_RawRealloc, _PyMem_RawFree}
 #ifdef WITH_PYMALLOC
 #  define PYMALLOC_ALLOC {NULL, _PyObject_Malloc, _PyObject_Calloc, _PyObject_Realloc, _PyObject_Free}
@@ -923,11 +1024,15 @@ static int running_on_valgrind = -1;
  * Arenas are allocated with mmap() on systems supporting anonymous memory
  * mappings to reduce heap fragmentation.
  */
+#ifndef ARENA_BITS
+/* Can be overridden at build time, for example with -DARENA_BITS=21 for
+ * arenas made of a single 2 MiB huge page, see -X hugepages. */
 #ifdef USE_LARGE_ARENAS
 #define ARENA_BITS              20                    /* 1 MiB */
 #else
 #define ARENA_BITS              18                    /* 256 KiB */
 #endif
+#endif
 #define ARENA_SIZE              (1 << ARENA_BITS)
 #define ARENA_SIZE_MASK         (ARENA_SIZE - 1)
 
@@ -1020,6 +1125,9 @@ struct arena_object {
      */
     struct arena_object* nextarena;
     struct arena_object* prevarena;
+
+    /* Non-zero if the arena was allocated by _PyObject_ArenaMmapHuge() */
+    int huge;
 };
 
 #define POOL_OVERHEAD   _Py_SIZE_ROUND_UP(sizeof(struct pool_header), ALIGNMENT)
@@ -1242,10 +1350,15 @@ static size_t narenas_highwater = 0;
 
 static Py_ssize_t raw_allocated_blocks;
 
+static void block_cache_flush_current(void);
+static int print_malloc_stats(FILE *out);
+
 Py_ssize_t
 _Py_GetAllocatedBlocks(void)
 {
     Py_ssize_t n = raw_allocated_blocks;
+    /* the blocks cached by the thread are free */
+    block_cache_flush_current();
     /* add up allocated blocks for used pools */
     for (uint i = 0; i < maxarenas; ++i) {
         /* Skip arenas which are not allocated. */
@@ -1265,6 +1378,51 @@ _Py_GetAllocatedBlocks(void)
     return n;
 }
 
+/* Total number of bytes given back to the OS by _PyObject_TrimArenas() */
+static size_t ntrimmed_bytes = 0;
+
+/* Give the pages of the free pools of the arenas which are still in use back
+ * to the OS.  The first page of a pool holds its header, which links it in
+ * its arena's freepools list, so it is kept.  The size class of a trimmed pool
+ * is reset so that its free list, which lived in the released pages, is
+ * rebuilt when the pool is used again, and so that it is not trimmed twice.
+ *
+ * Return the number of bytes released.
+ */
+Py_ssize_t
+_PyObject_TrimArenas(void)
+{
+    size_t n = 0;
+#if defined(ARENAS_USE_MMAP) && defined(MADV_DONTNEED)
+    /* only the memory mapped by the default arena allocator is known to be
+       zero-filled again after MADV_DONTNEED */
+    if (_PyObject_Arena.alloc != _PyObject_ArenaMmap) {
+        return 0;
+    }
+#if POOL_SIZE > SYSTEM_PAGE_SIZE
+    /* the blocks cached by the thread may be all that keeps some pools in
+       use */
+    block_cache_flush_current();
+    for (struct arena_object *ao = usable_arenas; ao != NULL;
+         ao = ao->nextarena)
+    {
+        for (poolp pool = ao->freepools; pool != NULL; pool = pool->nextpool) {
+            if (pool->szidx == DUMMY_SIZE_IDX) {
+                continue;
+            }
+            if (madvise((block *)pool + SYSTEM_PAGE_SIZE,
+                        POOL_SIZE - SYSTEM_PAGE_SIZE, MADV_DONTNEED) == 0) {
+                pool->szidx = DUMMY_SIZE_IDX;
+                n += POOL_SIZE - SYSTEM_PAGE_SIZE;
+            }
+        }
+    }
+#endif
+#endif
+    ntrimmed_bytes += n;
+    return (Py_ssize_t)n;
+}
+
 #if WITH_PYMALLOC_RADIX_TREE
 /*==========================================================================*/
 /* radix tree for tracking arena usage
@@ -1529,6 +1687,52 @@ arena_map_is_used(block *p)
  * describing the new arena.  It's expected that the caller will set
  * `usable_arenas` to the return value.
  */
+#ifdef ARENAS_USE_MMAP
+/* Free an arena allocated by _PyObject_ArenaMmapHuge().  An arena smaller
+ * than HUGE_PAGE_SIZE shares its region with other arenas: the region is
+ * only unmapped, or carved again if it is the spare region, once none of
+ * its arenas are in use.  Until then, the freed arenas stay mapped.
+ */
+static void
+free_huge_arena(void *address)
+{
+    if (ARENA_SIZE % HUGE_PAGE_SIZE == 0) {
+        munmap(address, ARENA_SIZE);
+        return;
+    }
+    uintptr_t region = (uintptr_t)address & ~(uintptr_t)(HUGE_PAGE_SIZE - 1);
+    for (uint i = 0; i < maxarenas; i++) {
+        uintptr_t other = arenas[i].address;
+        if (other != 0 && other != (uintptr_t)address && arenas[i].huge
+            && (other & ~(uintptr_t)(HUGE_PAGE_SIZE - 1)) == region) {
+            return;
+        }
+    }
+    if (thp_spare_size != 0
+        && ((uintptr_t)thp_spare & ~(uintptr_t)(HUGE_PAGE_SIZE - 1)) == region)
+    {
+        thp_spare = (char *)region;
+        thp_spare_size = HUGE_PAGE_SIZE;
+    }
+    else {
+        munmap((void *)region, HUGE_PAGE_SIZE);
+    }
+}
+#endif
+
+/* Free the memory of an arena allocated by new_arena() */
+static void
+free_arena_memory(void *address, int huge)
+{
+#ifdef ARENAS_USE_MMAP
+    if (huge) {
+        free_huge_arena(address);
+        return;
+    }
+#endif
+    _PyObject_Arena.free(_PyObject_Arena.ctx, address, ARENA_SIZE);
+}
+
 static struct arena_object*
 new_arena(void)
 {
@@ -1542,7 +1746,7 @@ new_arena(void)
         debug_stats = (opt != NULL && *opt != '\0');
     }
     if (debug_stats)
-        _PyObject_DebugMallocStats(stderr);
+        (void)print_malloc_stats(stderr);
 
     if (unused_arena_objects == NULL) {
         uint i;
@@ -1591,12 +1795,24 @@ new_arena(void)
     arenaobj = unused_arena_objects;
     unused_arena_objects = arenaobj->nextarena;
     assert(arenaobj->address == 0);
-    address = _PyObject_Arena.alloc(_PyObject_Arena.ctx, ARENA_SIZE);
+    arenaobj->huge = 0;
+#ifdef ARENAS_USE_MMAP
+    /* ARENA_SIZE and HUGE_PAGE_SIZE are powers of two: one divides the
+       other */
+    if (use_hugepages && _PyObject_Arena.alloc == _PyObject_ArenaMmap) {
+        address = _PyObject_ArenaMmapHuge(ARENA_SIZE);
+        arenaobj->huge = 1;
+    }
+    else
+#endif
+    {
+        address = _PyObject_Arena.alloc(_PyObject_Arena.ctx, ARENA_SIZE);
+    }
 #if WITH_PYMALLOC_RADIX_TREE
     if (address != NULL) {
         if (!arena_map_mark_used((uintptr_t)address, 1)) {
             /* marking arena in radix tree failed, abort */
-            _PyObject_Arena.free(_PyObject_Arena.ctx, address, ARENA_SIZE);
+            free_arena_memory(address, arenaobj->huge);
             address = NULL;
         }
     }
@@ -1889,6 +2105,96 @@ allocate_from_new_pool(uint size)
     return bp;
 }
 
+/*==========================================================================*/
+
+/* Per-thread caches of free blocks.
+ *
+ * The blocks of the smallest size classes which are freed by a thread are
+ * kept in a cache in its PyThreadState, and handed out first by the next
+ * allocations of the thread.  Allocating from or freeing to the cache only
+ * touches the block and the thread state, not the pool header nor
+ * usedpools, and reuses the blocks most recently freed by the thread, which
+ * are likely still in the CPU cache.  When the cache of a size class is
+ * full, its older half is returned to the pools at once.
+ *
+ * A thread flushes its cache each time it releases the GIL (see
+ * PyEval_SaveThread()) and when another thread state is swapped in.  So only the current thread
+ * state has cached blocks: the threads which are blocked or waiting don't
+ * keep pools or arenas alive, and flushing the cache of the current thread
+ * returns all the cached blocks to their pools.
+ */
+#define NB_CACHED_SIZE_CLASSES \
+    Py_MIN(NB_SMALL_SIZE_CLASSES, _PyObject_NB_CACHED_SIZE_CLASSES)
+#define CACHED_BLOCKS_PER_CLASS 64
+
+static inline void free_to_pool(poolp pool, block *p);
+
+/* Return a list of blocks linked through their first word to their pools */
+static void
+free_blocks_to_pools(block *bp)
+{
+    while (bp != NULL) {
+        block *next = *(block **)bp;
+        free_to_pool(POOL_ADDR(bp), bp);
+        bp = next;
+    }
+}
+
+static void
+block_cache_flush(_PyObject_BlockCache *cache)
+{
+    for (uint i = 0; i < NB_CACHED_SIZE_CLASSES; i++) {
+        block *bp = cache->free_blocks[i];
+        cache->free_blocks[i] = NULL;
+        cache->count[i] = 0;
+        free_blocks_to_pools(bp);
+    }
+}
+
+/* Return all the cached blocks to their pools: the caches of the threads
+ * which don't hold the GIL are already empty. */
+static void
+block_cache_flush_current(void)
+{
+    PyThreadState *tstate = _PyThreadState_GET();
+    if (tstate != NULL) {
+        block_cache_flush(&tstate->obmalloc_cache);
+    }
+}
+
+static inline void
+block_cache_push(_PyObject_BlockCache *cache, uint size, block *p)
+{
+    if (UNLIKELY(cache->count[size] == CACHED_BLOCKS_PER_CLASS)) {
+        /* Keep the most recently freed half */
+        block *bp = cache->free_blocks[size];
+        for (uint i = 1; i < CACHED_BLOCKS_PER_CLASS / 2; i++) {
+            bp = *(block **)bp;
+        }
+        block *older = *(block **)bp;
+        *(block **)bp = NULL;
+        cache->count[size] = CACHED_BLOCKS_PER_CLASS / 2;
+        free_blocks_to_pools(older);
+    }
+    *(block **)p = cache->free_blocks[size];
+    cache->free_blocks[size] = p;
+    cache->count[size]++;
+}
+
+void
+_PyObject_FlushBlockCache(PyThreadState *tstate)
+{
+    block_cache_flush(&tstate->obmalloc_cache);
+}
+
+void
+_PyObject_ClearBlockCache(PyThreadState *tstate)
+{
+    block_cache_flush(&tstate->obmalloc_cache);
+    tstate->obmalloc_cache.enabled = 0;
+}
+
+
 /* pymalloc allocator
 
    Return a pointer to newly allocated memory if pymalloc allocated memory.
@@ -1917,9 +2223,22 @@ pymalloc_alloc(void *ctx, size_t nbytes)
     }
 
     uint size = (uint)(nbytes - 1) >> ALIGNMENT_SHIFT;
-    poolp pool = usedpools[size + size];
     block *bp;
 
+    if (size < NB_CACHED_SIZE_CLASSES) {
+        PyThreadState *tstate = _PyThreadState_GET();
+        if (LIKELY(tstate != NULL)) {
+            _PyObject_BlockCache *cache = &tstate->obmalloc_cache;
+            bp = cache->free_blocks[size];
+            if (LIKELY(bp != NULL)) {
+                cache->free_blocks[size] = *(block **)bp;
+                cache->count[size]--;
+                return (void *)bp;
+            }
+        }
+    }
+
+    poolp pool = usedpools[size + size];
     if (LIKELY(pool != pool->nextpool)) {
         /*
          * There is a used pool for this size class.
@@ -2085,8 +2404,7 @@ insert_to_freepool(poolp pool)
 #endif
 
         /* Free the entire arena. */
-        _PyObject_Arena.free(_PyObject_Arena.ctx,
-                             (void *)ao->address, ARENA_SIZE);
+        free_arena_memory((void *)ao->address, ao->huge);
         ao->address = 0;                        /* mark unassociated */
         --narenas_currently_allocated;
 
@@ -2184,6 +2502,22 @@ pymalloc_free(void *ctx, void *p)
     }
     /* We allocated this address. */
 
+    uint size = pool->szidx;
+    if (size < NB_CACHED_SIZE_CLASSES) {
+        PyThreadState *tstate = _PyThreadState_GET();
+        if (LIKELY(tstate != NULL && tstate->obmalloc_cache.enabled)) {
+            block_cache_push(&tstate->obmalloc_cache, size, (block *)p);
+            return 1;
+        }
+    }
+    free_to_pool(pool, (block *)p);
+    return 1;
+}
+
+/* Return a block to its pool */
+static inline void
+free_to_pool(poolp pool, block *p)
+{
     /* Link p to the start of the pool's freeblock list.  Since
      * the pool had at least the p block outstanding, the pool
      * wasn't empty (so it's already in a usedpools[] list, or
@@ -2193,7 +2527,7 @@ pymalloc_free(void *ctx, void *p)
     assert(pool->ref.count > 0);            /* else it was empty */
     block *lastfree = pool->freeblock;
     *(block **)p = lastfree;
-    pool->freeblock = (block *)p;
+    pool->freeblock = p;
     pool->ref.count--;
 
     if (UNLIKELY(lastfree == NULL)) {
@@ -2204,7 +2538,7 @@ pymalloc_free(void *ctx, void *p)
          * blocks of the same size class.
          */
         insert_to_usedpool(pool);
-        return 1;
+        return;
     }
 
     /* freeblock wasn't NULL, so the pool wasn't full,
@@ -2212,7 +2546,7 @@ pymalloc_free(void *ctx, void *p)
      */
     if (LIKELY(pool->ref.count != 0)) {
         /* pool isn't empty:  leave it in usedpools */
-        return 1;
+        return;
     }
 
     /* Pool is now empty:  unlink from usedpools, and
@@ -2221,7 +2555,6 @@ pymalloc_free(void *ctx, void *p)
      * (being not referenced, they are perhaps paged out).
      */
     insert_to_freepool(pool);
-    return 1;
 }
 
 
@@ -2339,6 +2672,22 @@ _Py_GetAllocatedBlocks(void)
     return 0;
 }
 
+void
+_PyObject_FlushBlockCache(PyThreadState *tstate)
+{
+}
+
+void
+_PyObject_ClearBlockCache(PyThreadState *tstate)
+{
+}
+
+Py_ssize_t
+_PyObject_TrimArenas(void)
+{
+    return 0;
+}
+
 #endif /* WITH_PYMALLOC */
 
 
@@ -2902,13 +3251,13 @@ pool_is_in_list(const poolp target, poolp list)
 
 /* Print summary info to "out" about the state of pymalloc's structures.
  * In Py_DEBUG mode, also perform some expensive internal consistency
- * checks.
+ * checks.  The blocks in the per-thread caches are counted as allocated.
  *
  * Return 0 if the memory debug hooks are not installed or no statistics was
  * written into out, return 1 otherwise.
  */
-int
-_PyObject_DebugMallocStats(FILE *out)
+static int
+print_malloc_stats(FILE *out)
 {
     if (!_PyMem_PymallocEnabled()) {
         return 0;
@@ -3027,6 +3376,11 @@ _PyObject_DebugMallocStats(FILE *out)
     (void)printone(out, "# arenas reclaimed", ntimes_arena_allocated - narenas);
     (void)printone(out, "# arenas highwater mark", narenas_highwater);
     (void)printone(out, "# arenas allocated current", narenas);
+#ifdef ARENAS_USE_MMAP
+    (void)printone(out, "# explicit huge page allocations", nhugetlb_allocated);
+    (void)printone(out, "# regions advised for THP", nthp_advised_regions);
+#endif
+    (void)printone(out, "# bytes trimmed from free pools", ntrimmed_bytes);
 
     PyOS_snprintf(buf, sizeof(buf),
                   "%zu arenas * %d bytes/arena",
@@ -3069,4 +3423,16 @@ _PyObject_DebugMallocStats(FILE *out)
     return 1;
 }
 
+/* Same as print_malloc_stats(), after returning the blocks cached by the
+ * thread to their pools, so that they are counted as free.  This must not
+ * be called by the allocator itself, which is why new_arena() calls
+ * print_malloc_stats() directly.
+ */
+int
+_PyObject_DebugMallocStats(FILE *out)
+{
+    block_cache_flush_current();
+    return print_malloc_stats(out);
+}
+
 #endif /* #ifdef WITH_PYMALLOC */
@@ -19,6 +19,86 @@
 /* 10xxxxxx */
 #define IS_CONTINUATION_BYTE(ch) ((ch) >= 0x80 && (ch) < 0xC0)
 
+/* Runs of ASCII characters are decoded, and runs of ASCII or 2-byte
+   characters are encoded, 16 bytes at a time with SSE2 or NEON vectors.
+   Both are part of the baseline instruction set of x86-64 and AArch64, so
+   they need no runtime CPU detection.  Unlike the size_t loops, the vector
+   loads don't need to be aligned. */
+#if defined(__SSE2__) || defined(_M_X64)
+#  include <emmintrin.h>
+#  define UTF8_SIMD_SSE2
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && PY_LITTLE_ENDIAN
+#  include <arm_neon.h>
+#  define UTF8_SIMD_NEON
+#endif
+
+#if defined(UTF8_SIMD_SSE2) || defined(UTF8_SIMD_NEON)
+#define HAVE_UTF8_SIMD
+
+/* Decode the ASCII characters at the start of [start, end) to dest, 16 at a
+   time.  Return the number of characters decoded. */
+Py_LOCAL_INLINE(Py_ssize_t)
+STRINGLIB(ascii_decode_simd)(const char *start, const char *end,
+                             STRINGLIB_CHAR *dest)
+{
+    const char *s = start;
+    STRINGLIB_CHAR *p = dest;
+
+    while (end - s >= 16) {
+#ifdef UTF8_SIMD_SSE2
+        __m128i v = _mm_loadu_si128((const __m128i *)s);
+        if (_mm_movemask_epi8(v)) {
+            break;
+        }
+# if STRINGLIB_SIZEOF_CHAR == 1
+        _mm_storeu_si128((__m128i *)p, v);
+# else
+        const __m128i zero = _mm_setzero_si128();
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+#  if STRINGLIB_SIZEOF_CHAR == 2
+        _mm_storeu_si128((__m128i *)p, lo);
+        _mm_storeu_si128((__m128i *)(p + 8), hi);
+#  else
+        _mm_storeu_si128((__m128i *)p, _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128((__m128i *)(p + 4), _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128((__m128i *)(p + 8), _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128((__m128i *)(p + 12), _mm_unpackhi_epi16(hi, zero));
+#  endif
+# endif
+#else
+        uint8x16_t v = vld1q_u8((const uint8_t *)s);
+        if (vmaxvq_u8(v) & 0x80) {
+            break;
+        }
+# if STRINGLIB_SIZEOF_CHAR == 1
+        vst1q_u8(p, v);
+# else
+        uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+        uint16x8_t hi = vmovl_high_u8(v);
+#  if STRINGLIB_SIZEOF_CHAR == 2
+        vst1q_u16(p, lo);
+        vst1q_u16(p + 8, hi);
+#  else
+        vst1q_u32(p, vmovl_u16(vget_low_u16(lo)));
+        vst1q_u32(p + 4, vmovl_high_u16(lo));
+        vst1q_u32(p + 8, vmovl_u16(vget_low_u16(hi)));
+        vst1q_u32(p + 12, vmovl_high_u16(hi));
+#  endif
+# endif
+#endif
+        s += 16;
+        p += 16;
+    }
+    /* Finish the run here, so that the caller doesn't try the vectors again
+       on each of its remaining characters */
+    while (s < end && !(*s & 0x80)) {
+        *p++ = (unsigned char)*s++;
+    }
+    return s - start;
+}
+#endif
+
 Py_LOCAL_INLINE(Py_UCS4)
 STRINGLIB(utf8_decode)(const char **inptr, const char *end,
                        STRINGLIB_CHAR *dest,
@@ -39,6 +119,15 @@ STRINGLIB(utf8_decode)(const char **inptr, const char *end,
                First, check if we can do an aligned read, as most CPUs have
                a penalty for unaligned reads.
             */
+#ifdef HAVE_UTF8_SIMD
+            /* Even faster with vectors, whatever the alignment. */
+            Py_ssize_t n = STRINGLIB(ascii_decode_simd)(s, end, p);
+            s += n;
+            p += n;
+            if (s == end)
+                break;
+            ch = (unsigned char)*s;
+#else
             if (_Py_IS_ALIGNED(s, ALIGNOF_SIZE_T)) {
                 /* Help register allocation */
                 const char *_s = s;
@@ -92,6 +181,7 @@ STRINGLIB(utf8_decode)(const char **inptr, const char *end,
                 *p++ = ch;
                 continue;
             }
+#endif
         }
 
         if (ch < 0xE0) {
@@ -254,6 +344,131 @@ STRINGLIB(utf8_decode)(const char **inptr, const char *end,
 #undef ASCII_CHAR_MASK
 
 
+#ifdef HAVE_UTF8_SIMD
+
+#ifdef UTF8_SIMD_SSE2
+typedef __m128i STRINGLIB(u16x8);
+#else
+typedef uint16x8_t STRINGLIB(u16x8);
+#endif
+
+#if STRINGLIB_SIZEOF_CHAR > 1
+/* Load 8 characters into 16-bit lanes.  Characters above 0xFFFF are
+   saturated, they are never mistaken for ASCII or 2-byte characters. */
+Py_LOCAL_INLINE(STRINGLIB(u16x8))
+STRINGLIB(load_u16x8)(const STRINGLIB_CHAR *in)
+{
+#ifdef UTF8_SIMD_SSE2
+# if STRINGLIB_SIZEOF_CHAR == 2
+    return _mm_loadu_si128((const __m128i *)in);
+# else
+    return _mm_packs_epi32(_mm_loadu_si128((const __m128i *)in),
+                           _mm_loadu_si128((const __m128i *)(in + 4)));
+# endif
+#else
+# if STRINGLIB_SIZEOF_CHAR == 2
+    return vld1q_u16(in);
+# else
+    return vcombine_u16(vqmovn_u32(vld1q_u32(in)),
+                        vqmovn_u32(vld1q_u32(in + 4)));
+# endif
+#endif
+}
+#endif
+
+/* Encode the characters at the start of [in, end) to *outptr, as long as
+   they come in blocks of 16 ASCII characters or of 8 2-byte characters
+   (U+0080-U+07FF).  Return the number of characters encoded.
+
+   The caller encodes the next block character by character: retrying the
+   vectors on each character costs more than it saves in mixed text. */
+Py_LOCAL_INLINE(Py_ssize_t)
+STRINGLIB(utf8_encode_simd)(const STRINGLIB_CHAR *in,
+                            const STRINGLIB_CHAR *end, char **outptr)
+{
+    const STRINGLIB_CHAR *start = in;
+    char *out = *outptr;
+
+    while (end - in >= 16) {
+        STRINGLIB(u16x8) v;
+#ifdef UTF8_SIMD_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i high = _mm_set1_epi16((short)0xFF80);
+# if STRINGLIB_SIZEOF_CHAR == 1
+        __m128i bytes = _mm_loadu_si128((const __m128i *)in);
+        if (!_mm_movemask_epi8(bytes)) {
+            _mm_storeu_si128((__m128i *)out, bytes);
+            in += 16;
+            out += 16;
+            continue;
+        }
+        v = _mm_unpacklo_epi8(bytes, zero);
+# else
+        v = STRINGLIB(load_u16x8)(in);
+        __m128i hi = STRINGLIB(load_u16x8)(in + 8);
+        __m128i high_bits = _mm_and_si128(_mm_or_si128(v, hi), high);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(high_bits, zero)) == 0xFFFF) {
+            _mm_storeu_si128((__m128i *)out, _mm_packus_epi16(v, hi));
+            in += 16;
+            out += 16;
+            continue;
+        }
+# endif
+        /* 2-byte characters: none of them is ASCII, all are below 0x800 */
+        __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(v, high), zero);
+        __m128i small = _mm_cmpeq_epi16(
+            _mm_and_si128(v, _mm_set1_epi16((short)0xF800)), zero);
+        if (_mm_movemask_epi8(_mm_andnot_si128(ascii, small)) != 0xFFFF) {
+            break;
+        }
+        /* 110xxxxx 10xxxxxx: the first byte goes to the low byte of each
+           little-endian lane */
+        __m128i first = _mm_or_si128(_mm_srli_epi16(v, 6),
+                                     _mm_set1_epi16(0xC0));
+        __m128i second = _mm_or_si128(
+            _mm_and_si128(v, _mm_set1_epi16(0x3F)), _mm_set1_epi16(0x80));
+        _mm_storeu_si128((__m128i *)out,
+                         _mm_or_si128(first, _mm_slli_epi16(second, 8)));
+#else
+# if STRINGLIB_SIZEOF_CHAR == 1
+        uint8x16_t bytes = vld1q_u8(in);
+        if (!(vmaxvq_u8(bytes) & 0x80)) {
+            vst1q_u8((uint8_t *)out, bytes);
+            in += 16;
+            out += 16;
+            continue;
+        }
+        v = vmovl_u8(vget_low_u8(bytes));
+# else
+        v = STRINGLIB(load_u16x8)(in);
+        uint16x8_t hi = STRINGLIB(load_u16x8)(in + 8);
+        if (vmaxvq_u16(vorrq_u16(v, hi)) < 0x80) {
+            vst1q_u8((uint8_t *)out,
+                     vcombine_u8(vmovn_u16(v), vmovn_u16(hi)));
+            in += 16;
+            out += 16;
+            continue;
+        }
+# endif
+        if (vminvq_u16(v) < 0x80 || vmaxvq_u16(v) >= 0x800) {
+            break;
+        }
+        uint16x8_t first = vorrq_u16(vshrq_n_u16(v, 6), vdupq_n_u16(0xC0));
+        uint16x8_t second = vorrq_u16(vandq_u16(v, vdupq_n_u16(0x3F)),
+                                      vdupq_n_u16(0x80));
+        vst1q_u8((uint8_t *)out,
+                 vreinterpretq_u8_u16(vorrq_u16(first,
+                                                vshlq_n_u16(second, 8))));
+#endif
+        in += 8;
+        out += 16;
+    }
+    *outptr = out;
+    return in - start;
+}
+
+#endif   /* HAVE_UTF8_SIMD */
+
 /* UTF-8 encoder specialized for a Unicode kind to avoid the slow
    PyUnicode_READ() macro. Delete some parts of the code depending on the kind:
    UCS-1 strings don't need to handle surrogates for example. */
@@ -292,7 +507,28 @@ STRINGLIB(utf8_encoder)(_PyBytesWriter *writer,
     if (p == NULL)
         return NULL;
 
-    for (i = 0; i < size;) {
+#ifdef HAVE_UTF8_SIMD
+    /* Encode with vectors as long as possible, then the characters up to
+       'stop' one by one.  The distance to 'stop' doubles each time the
+       vectors don't help. */
+    Py_ssize_t stop, simd_skip = 16;
+    i = 0;
+  encode_simd:
+    {
+        char *out = p;
+        Py_ssize_t n = STRINGLIB(utf8_encode_simd)(data + i, data + size,
+                                                   &out);
+        p = out;
+        i += n;
+        simd_skip = n ? 16 : Py_MIN(simd_skip * 2, 1024);
+        stop = Py_MIN(i + simd_skip, size);
+    }
+#else
+    const Py_ssize_t stop = size;
+    i = 0;
+#endif
+
+    for (; i < stop;) {
         Py_UCS4 ch = data[i++];
 
         if (ch < 0x80) {
@@ -445,6 +681,11 @@ STRINGLIB(utf8_encoder)(_PyBytesWriter *writer,
 #endif /* STRINGLIB_SIZEOF_CHAR > 2 */
 #endif /* STRINGLIB_SIZEOF_CHAR > 1 */
     }
+#ifdef HAVE_UTF8_SIMD
+    if (i < size) {
+        goto encode_simd;
+    }
+#endif
 
 #if STRINGLIB_SIZEOF_CHAR > 1
     Py_XDECREF(error_handler_obj);
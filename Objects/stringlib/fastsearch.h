@@ -513,6 +513,287 @@ STRINGLIB(_two_way_count)(const STRINGLIB_CHAR *haystack,
 #undef LOG
 #undef LOG_STRING
 
+/* Vectorized search ("generic SIMD" substring search, after Wojciech Mula).
+   Compare 16 bytes of the haystack at once with the first character of the
+   needle, and the 16 bytes m-1 characters further with its last character;
+   only positions where both match are candidates for a full comparison.
+   SSE2 and NEON are part of the baseline instruction set of x86-64 and
+   AArch64, so they need no runtime CPU detection.  The NEON bit mask is
+   read as a 64-bit lane, which gives the bytes in string order only on
+   little-endian targets. */
+#ifndef STRINGLIB_FASTSEARCH_VECTOR_H
+#define STRINGLIB_FASTSEARCH_VECTOR_H
+
+#if defined(__SSE2__) || defined(_M_X64)
+#  include <emmintrin.h>
+#  define FASTSEARCH_SSE2
+typedef __m128i fastsearch_vec;
+/* _mm_movemask_epi8() gives one bit per byte */
+#  define FASTSEARCH_BITS_PER_BYTE 1
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && PY_LITTLE_ENDIAN
+#  include <arm_neon.h>
+#  define FASTSEARCH_NEON
+typedef uint8x16_t fastsearch_vec;
+/* Narrowing the comparison result gives four bits per byte */
+#  define FASTSEARCH_BITS_PER_BYTE 4
+#endif
+
+#if defined(FASTSEARCH_SSE2) || defined(FASTSEARCH_NEON)
+#define FASTSEARCH_VECTOR
+#if defined(_MSC_VER) && !defined(__clang__)
+#  include <intrin.h>
+#endif
+
+Py_LOCAL_INLINE(fastsearch_vec)
+fastsearch_vec_load(const void *s)
+{
+#ifdef FASTSEARCH_SSE2
+    return _mm_loadu_si128((const __m128i *)s);
+#else
+    return vld1q_u8((const uint8_t *)s);
+#endif
+}
+
+Py_LOCAL_INLINE(fastsearch_vec)
+fastsearch_vec_and(fastsearch_vec a, fastsearch_vec b)
+{
+#ifdef FASTSEARCH_SSE2
+    return _mm_and_si128(a, b);
+#else
+    return vandq_u8(a, b);
+#endif
+}
+
+/* Bit mask of the bytes of a comparison result, FASTSEARCH_BITS_PER_BYTE
+   bits per byte. */
+Py_LOCAL_INLINE(uint64_t)
+fastsearch_vec_bits(fastsearch_vec eq)
+{
+#ifdef FASTSEARCH_SSE2
+    return (uint64_t)(unsigned int)_mm_movemask_epi8(eq);
+#else
+    uint8x8_t bits = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(bits), 0);
+#endif
+}
+
+/* Index of the lowest set bit of x, which is not 0. */
+Py_LOCAL_INLINE(int)
+fastsearch_ctz(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return (int)index;
+#else
+    int n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+Py_LOCAL_INLINE(Py_ssize_t)
+fastsearch_popcount(uint64_t x)
+{
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (Py_ssize_t)((x * 0x0101010101010101ULL) >> 56);
+}
+#endif  /* FASTSEARCH_SSE2 || FASTSEARCH_NEON */
+
+#endif  /* !STRINGLIB_FASTSEARCH_VECTOR_H */
+
+#ifdef FASTSEARCH_VECTOR
+
+/* Number of characters in a vector, and the mask keeping one bit per
+   character of fastsearch_vec_bits(). */
+#define VECTOR_CHARS (16 / STRINGLIB_SIZEOF_CHAR)
+#define BITS_PER_CHAR (FASTSEARCH_BITS_PER_BYTE * STRINGLIB_SIZEOF_CHAR)
+#if STRINGLIB_SIZEOF_CHAR == 1
+#  define CHAR_BITS_MASK (FASTSEARCH_BITS_PER_BYTE == 1 ? \
+        0xffffULL : 0x1111111111111111ULL)
+#elif STRINGLIB_SIZEOF_CHAR == 2
+#  define CHAR_BITS_MASK (FASTSEARCH_BITS_PER_BYTE == 1 ? \
+        0x5555ULL : 0x0101010101010101ULL)
+#else
+#  define CHAR_BITS_MASK (FASTSEARCH_BITS_PER_BYTE == 1 ? \
+        0x1111ULL : 0x0001000100010001ULL)
+#endif
+
+Py_LOCAL_INLINE(fastsearch_vec)
+STRINGLIB(_vec_splat)(STRINGLIB_CHAR ch)
+{
+#ifdef FASTSEARCH_SSE2
+# if STRINGLIB_SIZEOF_CHAR == 1
+    return _mm_set1_epi8((char)ch);
+# elif STRINGLIB_SIZEOF_CHAR == 2
+    return _mm_set1_epi16((short)ch);
+# else
+    return _mm_set1_epi32((int)ch);
+# endif
+#else
+# if STRINGLIB_SIZEOF_CHAR == 1
+    return vdupq_n_u8((uint8_t)ch);
+# elif STRINGLIB_SIZEOF_CHAR == 2
+    return vreinterpretq_u8_u16(vdupq_n_u16((uint16_t)ch));
+# else
+    return vreinterpretq_u8_u32(vdupq_n_u32((uint32_t)ch));
+# endif
+#endif
+}
+
+/* Compare the characters at s with those of the vector v. */
+Py_LOCAL_INLINE(fastsearch_vec)
+STRINGLIB(_vec_eq)(const STRINGLIB_CHAR *s, fastsearch_vec v)
+{
+    fastsearch_vec a = fastsearch_vec_load(s);
+#ifdef FASTSEARCH_SSE2
+# if STRINGLIB_SIZEOF_CHAR == 1
+    return _mm_cmpeq_epi8(a, v);
+# elif STRINGLIB_SIZEOF_CHAR == 2
+    return _mm_cmpeq_epi16(a, v);
+# else
+    return _mm_cmpeq_epi32(a, v);
+# endif
+#else
+# if STRINGLIB_SIZEOF_CHAR == 1
+    return vceqq_u8(a, v);
+# elif STRINGLIB_SIZEOF_CHAR == 2
+    return vreinterpretq_u8_u16(vceqq_u16(vreinterpretq_u16_u8(a),
+                                          vreinterpretq_u16_u8(v)));
+# else
+    return vreinterpretq_u8_u32(vceqq_u32(vreinterpretq_u32_u8(a),
+                                          vreinterpretq_u32_u8(v)));
+# endif
+#endif
+}
+
+/* Count the occurrences of ch in s[0:n], up to maxcount. */
+Py_LOCAL_INLINE(Py_ssize_t)
+STRINGLIB(_vector_count_char)(const STRINGLIB_CHAR *s, Py_ssize_t n,
+                              STRINGLIB_CHAR ch, Py_ssize_t maxcount)
+{
+    const fastsearch_vec v = STRINGLIB(_vec_splat)(ch);
+    Py_ssize_t i, count = 0;
+
+    for (i = 0; i + VECTOR_CHARS <= n; i += VECTOR_CHARS) {
+        uint64_t bits = fastsearch_vec_bits(STRINGLIB(_vec_eq)(s + i, v));
+        count += fastsearch_popcount(bits & CHAR_BITS_MASK);
+        if (count >= maxcount) {
+            return maxcount;
+        }
+    }
+    for (; i < n; i++) {
+        if (s[i] == ch) {
+            count++;
+            if (count == maxcount) {
+                return maxcount;
+            }
+        }
+    }
+    return count;
+}
+
+/* Find (FAST_SEARCH) or count (FAST_COUNT) p[0:m] in s[0:n], with m >= 2.
+   As with the Horspool loop of FASTSEARCH(), a degenerate haystack can make
+   every position a candidate; for long needles and haystacks, switch to
+   the two-way algorithm once the fruitless comparisons add up. */
+Py_LOCAL_INLINE(Py_ssize_t)
+STRINGLIB(_vector_search)(const STRINGLIB_CHAR *s, Py_ssize_t n,
+                          const STRINGLIB_CHAR *p, Py_ssize_t m,
+                          Py_ssize_t maxcount, int mode)
+{
+    const Py_ssize_t w = n - m;
+    const Py_ssize_t mlast = m - 1;
+    const fastsearch_vec first = STRINGLIB(_vec_splat)(p[0]);
+    const fastsearch_vec last = STRINGLIB(_vec_splat)(p[mlast]);
+    const int adaptive = (m >= 100 && w >= 8000);
+    Py_ssize_t i = 0, j, count = 0, hits = 0;
+
+    while (i <= w - VECTOR_CHARS + 1) {
+        fastsearch_vec eq = fastsearch_vec_and(
+            STRINGLIB(_vec_eq)(s + i, first),
+            STRINGLIB(_vec_eq)(s + i + mlast, last));
+        uint64_t bits = fastsearch_vec_bits(eq) & CHAR_BITS_MASK;
+        Py_ssize_t next = i + VECTOR_CHARS;
+
+        while (bits) {
+            Py_ssize_t k = i + fastsearch_ctz(bits) / BITS_PER_CHAR;
+            bits &= bits - 1;
+            for (j = 1; j < mlast; j++) {
+                if (s[k+j] != p[j]) {
+                    break;
+                }
+            }
+            if (j >= mlast) {
+                /* got a match! */
+                if (mode != FAST_COUNT) {
+                    return k;
+                }
+                count++;
+                if (count == maxcount) {
+                    return maxcount;
+                }
+                /* matches don't overlap */
+                next = k + m;
+                break;
+            }
+            hits += j;
+            if (adaptive && hits >= m / 4 && k < w - 1000) {
+                Py_ssize_t res;
+                k++;
+                if (mode == FAST_COUNT) {
+                    res = STRINGLIB(_two_way_count)(s+k, n-k, p, m,
+                                                    maxcount-count);
+                    return count + res;
+                }
+                res = STRINGLIB(_two_way_find)(s+k, n-k, p, m);
+                if (res == -1) {
+                    return -1;
+                }
+                return k + res;
+            }
+        }
+        i = next;
+    }
+    /* Less than a vector of positions left */
+    for (; i <= w; i++) {
+        if (s[i] == p[0] && s[i+mlast] == p[mlast]) {
+            for (j = 1; j < mlast; j++) {
+                if (s[i+j] != p[j]) {
+                    break;
+                }
+            }
+            if (j >= mlast) {
+                if (mode != FAST_COUNT) {
+                    return i;
+                }
+                count++;
+                if (count == maxcount) {
+                    return maxcount;
+                }
+                i = i + mlast;
+            }
+        }
+    }
+    if (mode != FAST_COUNT) {
+        return -1;
+    }
+    return count;
+}
+
+#undef VECTOR_CHARS
+#undef BITS_PER_CHAR
+#undef CHAR_BITS_MASK
+
+#endif  /* FASTSEARCH_VECTOR */
+
 Py_LOCAL_INLINE(Py_ssize_t)
 FASTSEARCH(const STRINGLIB_CHAR* s, Py_ssize_t n,
            const STRINGLIB_CHAR* p, Py_ssize_t m,
@@ -537,6 +818,9 @@ FASTSEARCH(const STRINGLIB_CHAR* s, Py_ssize_t n,
         else if (mode == FAST_RSEARCH)
             return STRINGLIB(rfind_char)(s, n, p[0]);
         else {  /* FAST_COUNT */
+#ifdef FASTSEARCH_VECTOR
+            return STRINGLIB(_vector_count_char)(s, n, p[0], maxcount);
+#else
             for (i = 0; i < n; i++)
                 if (s[i] == p[0]) {
                     count++;
@@ -544,6 +828,7 @@ FASTSEARCH(const STRINGLIB_CHAR* s, Py_ssize_t n,
                         return maxcount;
                 }
             return count;
+#endif
         }
     }
 
@@ -564,6 +849,11 @@ FASTSEARCH(const STRINGLIB_CHAR* s, Py_ssize_t n,
                 return STRINGLIB(_two_way_count)(s, n, p, m, maxcount);
             }
         }
+#ifdef FASTSEARCH_VECTOR
+        if (w >= 16 / STRINGLIB_SIZEOF_CHAR) {
+            return STRINGLIB(_vector_search)(s, n, p, m, maxcount, mode);
+        }
+#endif
         const STRINGLIB_CHAR *ss = s + m - 1;
         const STRINGLIB_CHAR *pp = p + m - 1;
 
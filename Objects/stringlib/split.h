@@ -47,9 +47,67 @@
     count++; }
 
 
+/* Store the next item of a list allocated at its final size. */
+#define SPLIT_SET(data, left, right) {          \
+    sub = STRINGLIB_NEW((data) + (left),        \
+                        (right) - (left));      \
+    if (sub == NULL)                            \
+        goto onError;                           \
+    PyList_SET_ITEM(list, count, sub);          \
+    count++; }
+
 /* Always force the list to the expected size. */
 #define FIX_PREALLOC_SIZE(list) Py_SET_SIZE(list, count)
 
+/* Return the index of the first character of str[i:str_len] which is at
+   most limit, or which could be a non-ASCII whitespace or line break
+   (U+0085 and U+00A0).  Runs of ordinary characters are skipped 16 at a
+   time; the result is only a lower bound for the callers' scalar loops,
+   which classify the characters exactly. */
+Py_LOCAL_INLINE(Py_ssize_t)
+STRINGLIB(skip_plain)(const STRINGLIB_CHAR* str, Py_ssize_t i,
+                      Py_ssize_t str_len, unsigned char limit)
+{
+#if defined(FASTSEARCH_VECTOR) && STRINGLIB_SIZEOF_CHAR == 1
+#ifdef FASTSEARCH_SSE2
+    const __m128i vlimit = _mm_set1_epi8((char)limit);
+# if STRINGLIB_IS_UNICODE
+    const __m128i nel = _mm_set1_epi8((char)0x85);
+    const __m128i nbsp = _mm_set1_epi8((char)0xA0);
+# endif
+#else
+    const uint8x16_t vlimit = vdupq_n_u8(limit);
+# if STRINGLIB_IS_UNICODE
+    const uint8x16_t nel = vdupq_n_u8(0x85);
+    const uint8x16_t nbsp = vdupq_n_u8(0xA0);
+# endif
+#endif
+    for (; i + 16 <= str_len; i += 16) {
+        fastsearch_vec v = fastsearch_vec_load(str + i);
+        uint64_t bits;
+#ifdef FASTSEARCH_SSE2
+        __m128i special = _mm_cmpeq_epi8(_mm_min_epu8(v, vlimit), v);
+# if STRINGLIB_IS_UNICODE
+        special = _mm_or_si128(special,
+                               _mm_or_si128(_mm_cmpeq_epi8(v, nel),
+                                            _mm_cmpeq_epi8(v, nbsp)));
+# endif
+#else
+        uint8x16_t special = vcleq_u8(v, vlimit);
+# if STRINGLIB_IS_UNICODE
+        special = vorrq_u8(special, vorrq_u8(vceqq_u8(v, nel),
+                                             vceqq_u8(v, nbsp)));
+# endif
+#endif
+        bits = fastsearch_vec_bits(special);
+        if (bits) {
+            return i + fastsearch_ctz(bits) / FASTSEARCH_BITS_PER_BYTE;
+        }
+    }
+#endif
+    return i;
+}
+
 Py_LOCAL_INLINE(PyObject *)
 STRINGLIB(split_whitespace)(PyObject* str_obj,
                            const STRINGLIB_CHAR* str, Py_ssize_t str_len,
@@ -68,6 +126,7 @@ STRINGLIB(split_whitespace)(PyObject* str_obj,
             i++;
         if (i == str_len) break;
         j = i; i++;
+        i = STRINGLIB(skip_plain)(str, i, str_len, ' ');
         while (i < str_len && !STRINGLIB_ISSPACE(str[i]))
             i++;
 #ifndef STRINGLIB_MUTABLE
@@ -105,35 +164,32 @@ STRINGLIB(split_char)(PyObject* str_obj,
                      Py_ssize_t maxcount)
 {
     Py_ssize_t i, j, count=0;
-    PyObject *list = PyList_New(PREALLOC_SIZE(maxcount));
-    PyObject *sub;
+    PyObject *list, *sub;
 
+    /* Count the separators first, so that the list is allocated at its
+       final size: counting a single character is vectorized. */
+    maxcount = FASTSEARCH(str, str_len, &ch, 1, maxcount, FAST_COUNT);
+    if (maxcount < 0)
+        maxcount = 0;
+    list = PyList_New(maxcount + 1);
     if (list == NULL)
         return NULL;
-
-    i = j = 0;
-    while ((j < str_len) && (maxcount-- > 0)) {
-        for(; j < str_len; j++) {
-            /* I found that using memchr makes no difference */
-            if (str[j] == ch) {
-                SPLIT_ADD(str, i, j);
-                i = j = j + 1;
-                break;
-            }
-        }
-    }
 #ifndef STRINGLIB_MUTABLE
-    if (count == 0 && STRINGLIB_CHECK_EXACT(str_obj)) {
+    if (maxcount == 0 && STRINGLIB_CHECK_EXACT(str_obj)) {
         /* ch not in str_obj, so just use str_obj as list[0] */
         Py_INCREF(str_obj);
         PyList_SET_ITEM(list, 0, (PyObject *)str_obj);
-        count++;
-    } else
+        return list;
+    }
 #endif
-    if (i <= str_len) {
-        SPLIT_ADD(str, i, str_len);
+
+    i = 0;
+    while (count < maxcount) {
+        j = i + STRINGLIB(find_char)(str + i, str_len - i, ch);
+        SPLIT_SET(str, i, j);
+        i = j + 1;
     }
-    FIX_PREALLOC_SIZE(list);
+    SPLIT_SET(str, i, str_len);
     return list;
 
   onError:
@@ -157,31 +213,31 @@ STRINGLIB(split)(PyObject* str_obj,
     else if (sep_len == 1)
         return STRINGLIB(split_char)(str_obj, str, str_len, sep[0], maxcount);
 
-    list = PyList_New(PREALLOC_SIZE(maxcount));
+    /* Count the (non-overlapping) separators first, so that the list is
+       allocated at its final size. */
+    maxcount = FASTSEARCH(str, str_len, sep, sep_len, maxcount, FAST_COUNT);
+    if (maxcount < 0)
+        maxcount = 0;
+    list = PyList_New(maxcount + 1);
     if (list == NULL)
         return NULL;
-
-    i = j = 0;
-    while (maxcount-- > 0) {
-        pos = FASTSEARCH(str+i, str_len-i, sep, sep_len, -1, FAST_SEARCH);
-        if (pos < 0)
-            break;
-        j = i + pos;
-        SPLIT_ADD(str, i, j);
-        i = j + sep_len;
-    }
 #ifndef STRINGLIB_MUTABLE
-    if (count == 0 && STRINGLIB_CHECK_EXACT(str_obj)) {
+    if (maxcount == 0 && STRINGLIB_CHECK_EXACT(str_obj)) {
         /* No match in str_obj, so just use it as list[0] */
         Py_INCREF(str_obj);
         PyList_SET_ITEM(list, 0, (PyObject *)str_obj);
-        count++;
-    } else
+        return list;
+    }
 #endif
-    {
-        SPLIT_ADD(str, i, str_len);
+
+    i = 0;
+    while (count < maxcount) {
+        pos = FASTSEARCH(str+i, str_len-i, sep, sep_len, -1, FAST_SEARCH);
+        j = i + pos;
+        SPLIT_SET(str, i, j);
+        i = j + sep_len;
     }
-    FIX_PREALLOC_SIZE(list);
+    SPLIT_SET(str, i, str_len);
     return list;
 
   onError:
@@ -357,6 +413,7 @@ STRINGLIB(splitlines)(PyObject* str_obj,
         Py_ssize_t eol;
 
         /* Find a line and append it */
+        i = STRINGLIB(skip_plain)(str, i, str_len, 0x1E);
         while (i < str_len && !STRINGLIB_ISLINEBREAK(str[i]))
             i++;
 
@@ -5077,6 +5077,9 @@ PyUnicode_DecodeUTF8(const char *s,
 static Py_ssize_t
 ascii_decode(const char *start, const char *end, Py_UCS1 *dest)
 {
+#ifdef HAVE_UTF8_SIMD
+    return asciilib_ascii_decode_simd(start, end, dest);
+#else
     const char *p = start;
 
 #if SIZEOF_SIZE_T <= SIZEOF_VOID_P
@@ -5126,6 +5129,7 @@ ascii_decode(const char *start, const char *end, Py_UCS1 *dest)
     }
     memcpy(dest, start, p - start);
     return p - start;
+#endif
 }
 
 static PyObject *
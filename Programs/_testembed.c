@@ -491,6 +491,9 @@ static int test_init_from_config(void)
     config.use_hash_seed = 1;
     config.hash_seed = 123;
 
+    putenv("PYTHONHASHALGORITHM=fnv");
+    config_set_string(&config, &config.hash_algorithm, L"siphash13");
+
     /* dev_mode=1 is tested in test_init_dev_mode() */
 
     putenv("PYTHONFAULTHANDLER=");
@@ -657,6 +660,7 @@ static int test_init_dont_parse_argv(void)
 static void set_most_env_vars(void)
 {
     putenv("PYTHONHASHSEED=42");
+    putenv("PYTHONHASHALGORITHM=siphash13");
     putenv("PYTHONMALLOC=malloc");
     putenv("PYTHONTRACEMALLOC=2");
     putenv("PYTHONPROFILEIMPORTTIME=1");
@@ -1547,6 +1551,36 @@ static int tune_config(void)
 }
 
 
+static int test_init_hash_algorithm_reinit(void)
+{
+    /* The first initialization selects the hash algorithm of the process */
+    PyConfig config;
+    PyConfig_InitPythonConfig(&config);
+    config_set_program_name(&config);
+    config_set_string(&config, &config.hash_algorithm, L"fnv");
+    init_from_config_clear(&config);
+    PyRun_SimpleString("import sys; print(sys.hash_info.algorithm)");
+    Py_Finalize();
+
+    _testembed_Py_Initialize();
+    PyRun_SimpleString("import sys; print(sys.hash_info.algorithm)");
+    Py_Finalize();
+
+    /* Asking for another one later is an error */
+    PyConfig_InitPythonConfig(&config);
+    config_set_program_name(&config);
+    config_set_string(&config, &config.hash_algorithm, L"siphash13");
+    PyStatus status = Py_InitializeFromConfig(&config);
+    PyConfig_Clear(&config);
+    if (!PyStatus_IsError(status)) {
+        printf("no error\n");
+        return 1;
+    }
+    printf("%s\n", status.err_msg);
+    return 0;
+}
+
+
 static int test_init_set_config(void)
 {
     // Initialize core
@@ -1793,6 +1827,7 @@ static struct TestCase TestCases[] = {
     {"test_init_setpythonhome", test_init_setpythonhome},
     {"test_init_warnoptions", test_init_warnoptions},
     {"test_init_set_config", test_init_set_config},
+    {"test_init_hash_algorithm_reinit", test_init_hash_algorithm_reinit},
     {"test_run_main", test_run_main},
     {"test_get_argc_argv", test_get_argc_argv},
 
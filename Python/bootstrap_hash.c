@@ -1,5 +1,6 @@
 #include "Python.h"
 #include "pycore_initconfig.h"
+#include "pycore_pyhash.h"        // _PyHash_SetFuncDef()
 #ifdef MS_WINDOWS
 #  include <windows.h>
 /* All sample MSDN wincrypt programs include the header below. It is at least
@@ -575,11 +576,28 @@ _Py_HashRandomization_Init(const PyConfig *config)
     void *secret = &_Py_HashSecret;
     Py_ssize_t secret_size = sizeof(_Py_HashSecret_t);
 
+    PyHash_FuncDef *funcdef = NULL;
+    if (config->hash_algorithm != NULL) {
+        funcdef = _PyHash_LookupFuncDef(config->hash_algorithm);
+        if (funcdef == NULL) {
+            return _PyStatus_ERR("unknown hash algorithm");
+        }
+    }
+
     if (_Py_HashSecret_Initialized) {
+        /* str and bytes objects which survive Py_Finalize(), like the keys
+           of static types' dicts, keep hashes computed with the first
+           secret and algorithm: neither can change afterwards. */
+        if (funcdef != NULL && funcdef != PyHash_GetFuncDef()) {
+            return _PyStatus_ERR("the hash algorithm cannot be changed "
+                                 "after the first Python initialization");
+        }
         return _PyStatus_OK();
     }
     _Py_HashSecret_Initialized = 1;
 
+    _PyHash_SetFuncDef(funcdef);
+
     if (config->use_hash_seed) {
         if (config->hash_seed == 0) {
             /* disable the randomized hash */
@@ -60,6 +60,10 @@ Py_LOCAL_INLINE(PyObject *) call_function(
 static PyObject * do_call_core(
     PyThreadState *tstate, PyTraceInfo *, PyObject *func,
     PyObject *callargs, PyObject *kwdict);
+PyFrameObject *_PyEval_MakeFrameVector(
+    PyThreadState *tstate, PyFrameConstructor *con, PyObject *locals,
+    PyObject *const *args, Py_ssize_t argcount, PyObject *kwnames);
+static void release_frame(PyThreadState *tstate, PyFrameObject *f);
 
 #ifdef LLTRACE
 static int lltrace;
@@ -118,7 +122,6 @@ static long dxp[256];
 /* per opcode cache */
 static int opcache_min_runs = 1024;  /* create opcache when code executed this many times */
 #define OPCODE_CACHE_MAX_TRIES 20
-#define OPCACHE_STATS 0  /* Enable stats */
 
 // This function allows to deactivate the opcode cache. As different cache mechanisms may hold
 // references, this can mess with the reference leak detector functionality so the cache needs
@@ -129,20 +132,100 @@ _PyEval_DeactivateOpCache(void)
     opcache_min_runs = 0;
 }
 
-#if OPCACHE_STATS
+/* Opcode cache statistics.  Collection is off by default and costs a single
+   predictable branch per cached opcode; it is turned on by -X opcachestats
+   or sys._set_opcache_stats(). */
+static int opcache_stats_enabled = 0;
 static size_t opcache_code_objects = 0;
 static size_t opcache_code_objects_extra_mem = 0;
+static _PyOpcacheStats opcache_opcode_stats[256];
+
+/* Opcodes that can have a cache entry, see _PyCode_InitOpcache() */
+static const struct {
+    int opcode;
+    const char *name;
+} opcache_opcodes[] = {
+    {LOAD_GLOBAL, "LOAD_GLOBAL"},
+    {LOAD_ATTR, "LOAD_ATTR"},
+    {STORE_ATTR, "STORE_ATTR"},
+    {LOAD_METHOD, "LOAD_METHOD"},
+    {BINARY_ADD, "BINARY_ADD"},
+    {INPLACE_ADD, "INPLACE_ADD"},
+    {COMPARE_OP, "COMPARE_OP"},
+    {CALL_FUNCTION, "CALL_FUNCTION"},
+};
 
-static size_t opcache_global_opts = 0;
-static size_t opcache_global_hits = 0;
-static size_t opcache_global_misses = 0;
+void
+_PyEval_SetOpcacheStats(int enabled)
+{
+    opcache_stats_enabled = enabled;
+}
 
-static size_t opcache_attr_opts = 0;
-static size_t opcache_attr_hits = 0;
-static size_t opcache_attr_misses = 0;
-static size_t opcache_attr_deopts = 0;
-static size_t opcache_attr_total = 0;
-#endif
+/* Return the per-code counters of co, allocating them on first use.
+   Return NULL on memory allocation failure: the event is then only
+   accounted in the per-opcode counters. */
+static _PyOpcacheStats *
+opcache_code_stats(PyCodeObject *co)
+{
+    if (co->co_opcache_stats == NULL) {
+        co->co_opcache_stats = PyMem_Calloc(1, sizeof(_PyOpcacheStats));
+    }
+    return co->co_opcache_stats;
+}
+
+static PyObject *
+opcache_stats_as_dict(const _PyOpcacheStats *stats)
+{
+    return Py_BuildValue("{snsnsnsn}",
+                         "hits", (Py_ssize_t)stats->hits,
+                         "misses", (Py_ssize_t)stats->misses,
+                         "opts", (Py_ssize_t)stats->opts,
+                         "deopts", (Py_ssize_t)stats->deopts);
+}
+
+PyObject *
+_PyEval_GetOpcacheStats(PyObject *code)
+{
+    if (code != NULL) {
+        if (!PyCode_Check(code)) {
+            PyErr_Format(PyExc_TypeError,
+                         "expected a code object, got %.200s",
+                         Py_TYPE(code)->tp_name);
+            return NULL;
+        }
+        _PyOpcacheStats *stats = ((PyCodeObject *)code)->co_opcache_stats;
+        if (stats == NULL) {
+            Py_RETURN_NONE;
+        }
+        return opcache_stats_as_dict(stats);
+    }
+
+    PyObject *opcodes = PyDict_New();
+    if (opcodes == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < Py_ARRAY_LENGTH(opcache_opcodes); i++) {
+        PyObject *item = opcache_stats_as_dict(
+            &opcache_opcode_stats[opcache_opcodes[i].opcode]);
+        if (item == NULL) {
+            goto error;
+        }
+        int err = PyDict_SetItemString(opcodes, opcache_opcodes[i].name, item);
+        Py_DECREF(item);
+        if (err < 0) {
+            goto error;
+        }
+    }
+    return Py_BuildValue("{sOsnsnsN}",
+                         "enabled", opcache_stats_enabled ? Py_True : Py_False,
+                         "code_objects", (Py_ssize_t)opcache_code_objects,
+                         "extra_mem", (Py_ssize_t)opcache_code_objects_extra_mem,
+                         "opcodes", opcodes);
+
+error:
+    Py_DECREF(opcodes);
+    return NULL;
+}
 
 
 #ifndef NDEBUG
@@ -369,49 +452,31 @@ PyEval_InitThreads(void)
 void
 _PyEval_Fini(void)
 {
-#if OPCACHE_STATS
+    if (!_Py_GetConfig()->opcache_stats) {
+        return;
+    }
     fprintf(stderr, "-- Opcode cache number of objects  = %zd\n",
             opcache_code_objects);
 
     fprintf(stderr, "-- Opcode cache total extra mem    = %zd\n",
             opcache_code_objects_extra_mem);
 
-    fprintf(stderr, "\n");
-
-    fprintf(stderr, "-- Opcode cache LOAD_GLOBAL hits   = %zd (%d%%)\n",
-            opcache_global_hits,
-            (int) (100.0 * opcache_global_hits /
-                (opcache_global_hits + opcache_global_misses)));
-
-    fprintf(stderr, "-- Opcode cache LOAD_GLOBAL misses = %zd (%d%%)\n",
-            opcache_global_misses,
-            (int) (100.0 * opcache_global_misses /
-                (opcache_global_hits + opcache_global_misses)));
-
-    fprintf(stderr, "-- Opcode cache LOAD_GLOBAL opts   = %zd\n",
-            opcache_global_opts);
-
-    fprintf(stderr, "\n");
-
-    fprintf(stderr, "-- Opcode cache LOAD_ATTR hits     = %zd (%d%%)\n",
-            opcache_attr_hits,
-            (int) (100.0 * opcache_attr_hits /
-                opcache_attr_total));
-
-    fprintf(stderr, "-- Opcode cache LOAD_ATTR misses   = %zd (%d%%)\n",
-            opcache_attr_misses,
-            (int) (100.0 * opcache_attr_misses /
-                opcache_attr_total));
-
-    fprintf(stderr, "-- Opcode cache LOAD_ATTR opts     = %zd\n",
-            opcache_attr_opts);
-
-    fprintf(stderr, "-- Opcode cache LOAD_ATTR deopts   = %zd\n",
-            opcache_attr_deopts);
-
-    fprintf(stderr, "-- Opcode cache LOAD_ATTR total    = %zd\n",
-            opcache_attr_total);
-#endif
+    for (size_t i = 0; i < Py_ARRAY_LENGTH(opcache_opcodes); i++) {
+        const _PyOpcacheStats *stats =
+            &opcache_opcode_stats[opcache_opcodes[i].opcode];
+        size_t total = stats->hits + stats->misses;
+        fprintf(stderr, "\n");
+        fprintf(stderr, "-- Opcode cache %-13s hits   = %zd (%d%%)\n",
+                opcache_opcodes[i].name, stats->hits,
+                total ? (int) (100.0 * stats->hits / total) : 0);
+        fprintf(stderr, "-- Opcode cache %-13s misses = %zd (%d%%)\n",
+                opcache_opcodes[i].name, stats->misses,
+                total ? (int) (100.0 * stats->misses / total) : 0);
+        fprintf(stderr, "-- Opcode cache %-13s opts   = %zd\n",
+                opcache_opcodes[i].name, stats->opts);
+        fprintf(stderr, "-- Opcode cache %-13s deopts = %zd\n",
+                opcache_opcodes[i].name, stats->deopts);
+    }
 }
 
 void
@@ -434,6 +499,7 @@ PyEval_ReleaseLock(void)
        in debug mode. */
     struct _ceval_runtime_state *ceval = &runtime->ceval;
     struct _ceval_state *ceval2 = &tstate->interp->ceval;
+    _PyObject_FlushBlockCache(tstate);
     drop_gil(ceval, ceval2, tstate);
 }
 
@@ -474,6 +540,7 @@ PyEval_ReleaseThread(PyThreadState *tstate)
     }
     struct _ceval_runtime_state *ceval = &runtime->ceval;
     struct _ceval_state *ceval2 = &tstate->interp->ceval;
+    _PyObject_FlushBlockCache(tstate);
     drop_gil(ceval, ceval2, tstate);
 }
 
@@ -537,6 +604,9 @@ PyEval_SaveThread(void)
 #else
     assert(gil_created(&ceval->gil));
 #endif
+    /* Only the thread holding the GIL keeps blocks cached by pymalloc, see
+       Objects/obmalloc.c */
+    _PyObject_FlushBlockCache(tstate);
     drop_gil(ceval, ceval2, tstate);
     return tstate;
 }
@@ -1184,6 +1254,7 @@ eval_frame_handle_pending(PyThreadState *tstate)
         if (_PyThreadState_Swap(&runtime->gilstate, NULL) != tstate) {
             Py_FatalError("tstate mix-up");
         }
+        _PyObject_FlushBlockCache(tstate);
         drop_gil(ceval, ceval2, tstate);
 
         /* Other threads may run now */
@@ -1320,6 +1391,18 @@ eval_frame_handle_pending(PyThreadState *tstate)
         continue; \
     }
 
+/* Calls to Python functions are run in the same invocation of
+   _PyEval_EvalFrameDefault() as their caller, without recursing on the C
+   stack, unless something needs to observe the call from C: a tracing or
+   profiling function, or a PEP 523 frame evaluation function.  Generators
+   and coroutines are still created by the normal call path. */
+#define CAN_INLINE_CALL(func) \
+    (PyFunction_Check(func) && \
+     !trace_info.cframe.use_tracing && \
+     tstate->interp->eval_frame == _PyEval_EvalFrameDefault && \
+     (((PyCodeObject *)PyFunction_GET_CODE(func))->co_flags & \
+      (CO_GENERATOR | CO_COROUTINE | CO_ASYNC_GENERATOR)) == 0)
+
 
 /* Tuple access macros */
 
@@ -1467,85 +1550,168 @@ eval_frame_handle_pending(PyThreadState *tstate)
 #define OPCACHE_DEOPT() \
     do { \
         if (co_opcache != NULL) { \
+            OPCACHE_STAT_DEOPT(); \
             co_opcache->optimized = -1; \
-            unsigned char co_opcache_offset = \
-                co->co_opcache_map[next_instr - first_instr]; \
-            assert(co_opcache_offset <= co->co_opcache_size); \
-            co->co_opcache_map[co_opcache_offset] = 0; \
+            assert(co->co_opcache_map[next_instr - first_instr] <= \
+                   co->co_opcache_size); \
+            co->co_opcache_map[next_instr - first_instr] = 0; \
             co_opcache = NULL; \
         } \
     } while (0)
 
-#define OPCACHE_DEOPT_LOAD_ATTR() \
+#define OPCACHE_MAYBE_DEOPT() \
     do { \
-        if (co_opcache != NULL) { \
-            OPCACHE_STAT_ATTR_DEOPT(); \
+        if (co_opcache != NULL && --co_opcache->optimized <= 0) { \
             OPCACHE_DEOPT(); \
         } \
     } while (0)
 
-#define OPCACHE_MAYBE_DEOPT_LOAD_ATTR() \
+/* Record the operand kind observed by a specializable opcode.  The first
+   observation picks the specialization (or deoptimizes right away if there
+   is none); later mismatches count towards deoptimization. */
+#define OPCACHE_SPECIALIZE(observed_kind) \
     do { \
-        if (co_opcache != NULL && --co_opcache->optimized <= 0) { \
-            OPCACHE_DEOPT_LOAD_ATTR(); \
+        if (co_opcache->optimized == 0) { \
+            if ((observed_kind) == OPCACHE_KIND_NONE) { \
+                OPCACHE_DEOPT(); \
+            } \
+            else { \
+                OPCACHE_STAT_OPT(); \
+                co_opcache->u.sp.kind = (observed_kind); \
+                co_opcache->optimized = OPCODE_CACHE_MAX_TRIES; \
+            } \
+        } \
+        else if (co_opcache->u.sp.kind != (observed_kind)) { \
+            OPCACHE_STAT_MISS(); \
+            OPCACHE_MAYBE_DEOPT(); \
+        } \
+        else { \
+            OPCACHE_STAT_HIT(); \
         } \
     } while (0)
 
-#if OPCACHE_STATS
-
-#define OPCACHE_STAT_GLOBAL_HIT() \
-    do { \
-        if (co->co_opcache != NULL) opcache_global_hits++; \
-    } while (0)
-
-#define OPCACHE_STAT_GLOBAL_MISS() \
-    do { \
-        if (co->co_opcache != NULL) opcache_global_misses++; \
-    } while (0)
-
-#define OPCACHE_STAT_GLOBAL_OPT() \
-    do { \
-        if (co->co_opcache != NULL) opcache_global_opts++; \
-    } while (0)
-
-#define OPCACHE_STAT_ATTR_HIT() \
+#define OPCACHE_STAT(field) \
     do { \
-        if (co->co_opcache != NULL) opcache_attr_hits++; \
+        if (opcache_stats_enabled && co->co_opcache != NULL) { \
+            opcache_opcode_stats[opcode].field++; \
+            _PyOpcacheStats *code_stats = opcache_code_stats(co); \
+            if (code_stats != NULL) { \
+                code_stats->field++; \
+            } \
+        } \
     } while (0)
 
-#define OPCACHE_STAT_ATTR_MISS() \
-    do { \
-        if (co->co_opcache != NULL) opcache_attr_misses++; \
-    } while (0)
+#define OPCACHE_STAT_HIT() OPCACHE_STAT(hits)
+#define OPCACHE_STAT_MISS() OPCACHE_STAT(misses)
+#define OPCACHE_STAT_OPT() OPCACHE_STAT(opts)
+#define OPCACHE_STAT_DEOPT() OPCACHE_STAT(deopts)
 
-#define OPCACHE_STAT_ATTR_OPT() \
-    do { \
-        if (co->co_opcache!= NULL) opcache_attr_opts++; \
-    } while (0)
+/* Helpers for the specialized opcodes */
 
-#define OPCACHE_STAT_ATTR_DEOPT() \
-    do { \
-        if (co->co_opcache != NULL) opcache_attr_deopts++; \
-    } while (0)
+static inline int
+opcache_binary_kind(PyObject *left, PyObject *right)
+{
+    PyTypeObject *type = Py_TYPE(left);
+    if (type != Py_TYPE(right)) {
+        return OPCACHE_KIND_NONE;
+    }
+    if (type == &PyLong_Type) {
+        return OPCACHE_KIND_INT;
+    }
+    if (type == &PyFloat_Type) {
+        return OPCACHE_KIND_FLOAT;
+    }
+    if (type == &PyUnicode_Type) {
+        return OPCACHE_KIND_UNICODE;
+    }
+    return OPCACHE_KIND_NONE;
+}
 
-#define OPCACHE_STAT_ATTR_TOTAL() \
-    do { \
-        if (co->co_opcache != NULL) opcache_attr_total++; \
-    } while (0)
+/* Return a borrowed reference to Py_True or Py_False */
+static inline PyObject *
+opcache_float_compare(double i, double j, int op)
+{
+    int r;
+    switch (op) {
+    case Py_LT: r = i < j; break;
+    case Py_LE: r = i <= j; break;
+    case Py_EQ: r = i == j; break;
+    case Py_NE: r = i != j; break;
+    case Py_GT: r = i > j; break;
+    default: r = i >= j; break;
+    }
+    return r ? Py_True : Py_False;
+}
 
-#else /* OPCACHE_STATS */
+static inline int
+opcache_call_kind(PyObject *func, int nargs)
+{
+    if (!PyCFunction_CheckExact(func)) {
+        return OPCACHE_KIND_NONE;
+    }
+    int flags = PyCFunction_GET_FLAGS(func);
+    if (flags == METH_O && nargs == 1) {
+        return OPCACHE_KIND_BUILTIN_O;
+    }
+    if (flags == METH_FASTCALL) {
+        return OPCACHE_KIND_BUILTIN_FAST;
+    }
+    return OPCACHE_KIND_NONE;
+}
 
-#define OPCACHE_STAT_GLOBAL_HIT()
-#define OPCACHE_STAT_GLOBAL_MISS()
-#define OPCACHE_STAT_GLOBAL_OPT()
+/* Fill the STORE_ATTR cache after owner.name was successfully set by the
+   generic path.  Return 1 if the store can be cached, 0 otherwise. */
+static int
+opcache_specialize_store_attr(_PyOpcache *co_opcache, PyObject *owner,
+                              PyObject *name)
+{
+    PyTypeObject *type = Py_TYPE(owner);
+    _PyOpCodeOpt_LoadAttr *la = &co_opcache->u.la;
+    Py_ssize_t hint;
 
-#define OPCACHE_STAT_ATTR_HIT()
-#define OPCACHE_STAT_ATTR_MISS()
-#define OPCACHE_STAT_ATTR_OPT()
-#define OPCACHE_STAT_ATTR_DEOPT()
-#define OPCACHE_STAT_ATTR_TOTAL()
+    if (type->tp_setattro != PyObject_GenericSetAttr ||
+        !PyUnicode_CheckExact(name))
+    {
+        return 0;
+    }
+    PyObject *descr = _PyType_Lookup(type, name);
+    if (!PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG)) {
+        return 0;
+    }
+    if (descr != NULL) {
+        // Only __slots__ members are handled, like in LOAD_ATTR.
+        if (!Py_IS_TYPE(descr, &PyMemberDescr_Type)) {
+            return 0;
+        }
+        struct PyMemberDef *dmem = ((PyMemberDescrObject *)descr)->d_member;
+        if (dmem->type != T_OBJECT_EX || (dmem->flags & READONLY)) {
+            return 0;
+        }
+        assert(dmem->offset > 0);
+        hint = ~dmem->offset;
+    }
+    else if (type->tp_dictoffset > 0) {
+        PyObject *dict = *(PyObject **)((char *)owner + type->tp_dictoffset);
+        PyObject *res = NULL;
+        if (dict == NULL || !PyDict_CheckExact(dict)) {
+            return 0;
+        }
+        hint = _PyDict_GetItemHint((PyDictObject *)dict, name, -1, &res);
+        if (res == NULL) {
+            PyErr_Clear();
+            return 0;
+        }
+        assert(hint >= 0);
+    }
+    else {
+        return 0;
+    }
 
-#endif
+    la->type = type;
+    la->tp_version_tag = type->tp_version_tag;
+    la->hint = hint;
+    return 1;
+}
 
 
 PyObject* _Py_HOT_FUNCTION
@@ -1575,6 +1741,14 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
     PyObject *consts;
     _PyOpcache *co_opcache;
 
+    /* The frame this invocation was called for; frames of inlined calls
+       are linked to it through f_back */
+    PyFrameObject *entry_frame = f;
+    /* Arguments of an inlined call, see inline_call below */
+    Py_ssize_t inline_oparg;
+    PyObject *inline_kwnames;
+    int inline_pop_null;
+
 #ifdef LLTRACE
     _Py_IDENTIFIER(__ltrace__);
 #endif
@@ -1596,6 +1770,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
     trace_info.cframe.previous = prev_cframe;
     tstate->cframe = &trace_info.cframe;
 
+start_frame:
     /* push frame */
     tstate->frame = f;
     co = f->f_code;
@@ -1679,14 +1854,15 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
         co->co_opcache_flag++;
         if (co->co_opcache_flag == opcache_min_runs) {
             if (_PyCode_InitOpcache(co) < 0) {
+                f->f_stackdepth = 0;
                 goto exit_eval_frame;
             }
-#if OPCACHE_STATS
-            opcache_code_objects_extra_mem +=
-                PyBytes_Size(co->co_code) / sizeof(_Py_CODEUNIT) +
-                sizeof(_PyOpcache) * co->co_opcache_size;
-            opcache_code_objects++;
-#endif
+            if (opcache_stats_enabled) {
+                opcache_code_objects_extra_mem +=
+                    PyBytes_Size(co->co_code) / sizeof(_Py_CODEUNIT) +
+                    sizeof(_PyOpcache) * co->co_opcache_size;
+                opcache_code_objects++;
+            }
         }
     }
 
@@ -1701,6 +1877,8 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
 #endif
 
     if (throwflag) { /* support for generator.throw() */
+        /* Only the entry frame is thrown into, not inlined calls */
+        throwflag = 0;
         goto error;
     }
 
@@ -1712,6 +1890,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
 #endif
 
     for (;;) {
+    main_loop:
         assert(stack_pointer >= f->f_valuestack); /* else underflow */
         assert(STACK_LEVEL() <= co->co_stacksize);  /* else overflow */
         assert(!_PyErr_Occurred(tstate));
@@ -2029,13 +2208,27 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
             PyObject *right = POP();
             PyObject *left = TOP();
             PyObject *sum;
-            /* NOTE(vstinner): Please don't try to micro-optimize int+int on
-               CPython using bytecode, it is simply worthless.
-               See http://bugs.python.org/issue21955 and
-               http://bugs.python.org/issue10044 for the discussion. In short,
-               no patch shown any impact on a realistic benchmark, only a minor
-               speedup on microbenchmarks. */
-            if (PyUnicode_CheckExact(left) &&
+            /* The int+int and float+float paths are only taken once the
+               opcode cache has seen monomorphic operands at this site, so
+               cold and polymorphic code pays nothing for them.  See
+               http://bugs.python.org/issue21955 for why an unguarded
+               version of this is not worth it. */
+            int kind = OPCACHE_KIND_NONE;
+            OPCACHE_CHECK();
+            if (co_opcache != NULL) {
+                kind = opcache_binary_kind(left, right);
+                OPCACHE_SPECIALIZE(kind);
+            }
+            if (kind == OPCACHE_KIND_INT) {
+                sum = PyLong_Type.tp_as_number->nb_add(left, right);
+                Py_DECREF(left);
+            }
+            else if (kind == OPCACHE_KIND_FLOAT) {
+                sum = PyFloat_FromDouble(PyFloat_AS_DOUBLE(left) +
+                                         PyFloat_AS_DOUBLE(right));
+                Py_DECREF(left);
+            }
+            else if (PyUnicode_CheckExact(left) &&
                      PyUnicode_CheckExact(right)) {
                 sum = unicode_concatenate(tstate, left, right, f, next_instr);
                 /* unicode_concatenate consumed the ref to left */
@@ -2235,7 +2428,24 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
             PyObject *right = POP();
             PyObject *left = TOP();
             PyObject *sum;
-            if (PyUnicode_CheckExact(left) && PyUnicode_CheckExact(right)) {
+            int kind = OPCACHE_KIND_NONE;
+            OPCACHE_CHECK();
+            if (co_opcache != NULL) {
+                kind = opcache_binary_kind(left, right);
+                OPCACHE_SPECIALIZE(kind);
+            }
+            /* int and float have no in-place add, so nb_add is what
+               PyNumber_InPlaceAdd() would end up calling. */
+            if (kind == OPCACHE_KIND_INT) {
+                sum = PyLong_Type.tp_as_number->nb_add(left, right);
+                Py_DECREF(left);
+            }
+            else if (kind == OPCACHE_KIND_FLOAT) {
+                sum = PyFloat_FromDouble(PyFloat_AS_DOUBLE(left) +
+                                         PyFloat_AS_DOUBLE(right));
+                Py_DECREF(left);
+            }
+            else if (PyUnicode_CheckExact(left) && PyUnicode_CheckExact(right)) {
                 sum = unicode_concatenate(tstate, left, right, f, next_instr);
                 /* unicode_concatenate consumed the ref to left */
             }
@@ -2843,9 +3053,55 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
             PyObject *name = GETITEM(names, oparg);
             PyObject *owner = TOP();
             PyObject *v = SECOND();
+            PyTypeObject *type = Py_TYPE(owner);
+            _PyOpCodeOpt_LoadAttr *la;
             int err;
             STACK_SHRINK(2);
+
+            OPCACHE_CHECK();
+            if (co_opcache != NULL && co_opcache->optimized > 0) {
+                la = &co_opcache->u.la;
+                if (la->type == type &&
+                    la->tp_version_tag == type->tp_version_tag &&
+                    PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG))
+                {
+                    if (la->hint < -1) {
+                        // Slot hint: store straight into the member.
+                        PyObject **addr = (PyObject **)((char *)owner + ~la->hint);
+                        PyObject *old = *addr;
+                        *addr = v;  /* steals the reference */
+                        OPCACHE_STAT_HIT();
+                        Py_XDECREF(old);
+                        Py_DECREF(owner);
+                        DISPATCH();
+                    }
+                    PyObject *dict = *(PyObject **)((char *)owner + type->tp_dictoffset);
+                    if (dict != NULL && PyDict_CheckExact(dict) &&
+                        _PyDict_SetItemHint((PyDictObject *)dict, name,
+                                            la->hint, v) >= 0)
+                    {
+                        OPCACHE_STAT_HIT();
+                        Py_DECREF(v);
+                        Py_DECREF(owner);
+                        DISPATCH();
+                    }
+                }
+                OPCACHE_STAT_MISS();
+                OPCACHE_MAYBE_DEOPT();
+            }
+
             err = PyObject_SetAttr(owner, name, v);
+            if (err == 0 && co_opcache != NULL) {
+                if (opcache_specialize_store_attr(co_opcache, owner, name)) {
+                    if (co_opcache->optimized == 0) {
+                        OPCACHE_STAT_OPT();
+                        co_opcache->optimized = OPCODE_CACHE_MAX_TRIES;
+                    }
+                }
+                else if (co_opcache->optimized == 0) {
+                    OPCACHE_DEOPT();
+                }
+            }
             Py_DECREF(v);
             Py_DECREF(owner);
             if (err != 0)
@@ -2969,7 +3225,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
                            ((PyDictObject *)f->f_builtins)->ma_version_tag)
                     {
                         PyObject *ptr = lg->ptr;
-                        OPCACHE_STAT_GLOBAL_HIT();
+                        OPCACHE_STAT_HIT();
                         assert(ptr != NULL);
                         Py_INCREF(ptr);
                         PUSH(ptr);
@@ -2996,9 +3252,9 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
 
                     if (co_opcache->optimized == 0) {
                         /* Wasn't optimized before. */
-                        OPCACHE_STAT_GLOBAL_OPT();
+                        OPCACHE_STAT_OPT();
                     } else {
-                        OPCACHE_STAT_GLOBAL_MISS();
+                        OPCACHE_STAT_MISS();
                     }
 
                     co_opcache->optimized = 1;
@@ -3239,20 +3495,12 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
         }
 
         case TARGET(BUILD_MAP): {
-            Py_ssize_t i;
-            PyObject *map = _PyDict_NewPresized((Py_ssize_t)oparg);
+            PyObject *map = _PyDict_FromItems(
+                    &PEEK(2*oparg), 2,
+                    &PEEK(2*oparg - 1), 2,
+                    oparg);
             if (map == NULL)
                 goto error;
-            for (i = oparg; i > 0; i--) {
-                int err;
-                PyObject *key = PEEK(2*i);
-                PyObject *value = PEEK(2*i - 1);
-                err = PyDict_SetItem(map, key, value);
-                if (err != 0) {
-                    Py_DECREF(map);
-                    goto error;
-                }
-            }
 
             while (oparg--) {
                 Py_DECREF(POP());
@@ -3322,7 +3570,6 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
         }
 
         case TARGET(BUILD_CONST_KEY_MAP): {
-            Py_ssize_t i;
             PyObject *map;
             PyObject *keys = TOP();
             if (!PyTuple_CheckExact(keys) ||
@@ -3331,20 +3578,12 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
                                  "bad BUILD_CONST_KEY_MAP keys argument");
                 goto error;
             }
-            map = _PyDict_NewPresized((Py_ssize_t)oparg);
+            map = _PyDict_FromItems(
+                    &PyTuple_GET_ITEM(keys, 0), 1,
+                    &PEEK(oparg + 1), 1, oparg);
             if (map == NULL) {
                 goto error;
             }
-            for (i = oparg; i > 0; i--) {
-                int err;
-                PyObject *key = PyTuple_GET_ITEM(keys, oparg - i);
-                PyObject *value = PEEK(i + 1);
-                err = PyDict_SetItem(map, key, value);
-                if (err != 0) {
-                    Py_DECREF(map);
-                    goto error;
-                }
-            }
 
             Py_DECREF(POP());
             while (oparg--) {
@@ -3411,8 +3650,6 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
             PyObject *dict;
             _PyOpCodeOpt_LoadAttr *la;
 
-            OPCACHE_STAT_ATTR_TOTAL();
-
             OPCACHE_CHECK();
             if (co_opcache != NULL && PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG))
             {
@@ -3431,6 +3668,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
                             char *addr = (char *)owner + offset;
                             res = *(PyObject **)addr;
                             if (res != NULL) {
+                                OPCACHE_STAT_HIT();
                                 Py_INCREF(res);
                                 SET_TOP(res);
                                 Py_DECREF(owner);
@@ -3455,11 +3693,11 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
                                     assert(la->hint >= 0);
                                     if (la->hint == hint && hint >= 0) {
                                         // Our hint has helped -- cache hit.
-                                        OPCACHE_STAT_ATTR_HIT();
+                                        OPCACHE_STAT_HIT();
                                     } else {
                                         // The hint we provided didn't work.
                                         // Maybe next time?
-                                        OPCACHE_MAYBE_DEOPT_LOAD_ATTR();
+                                        OPCACHE_MAYBE_DEOPT();
                                     }
 
                                     Py_INCREF(res);
@@ -3472,22 +3710,22 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
                                     _PyErr_Clear(tstate);
                                     // This attribute can be missing sometimes;
                                     // we don't want to optimize this lookup.
-                                    OPCACHE_DEOPT_LOAD_ATTR();
+                                    OPCACHE_DEOPT();
                                     Py_DECREF(dict);
                                 }
                             }
                             else {
                                 // There is no dict, or __dict__ doesn't satisfy PyDict_CheckExact.
-                                OPCACHE_DEOPT_LOAD_ATTR();
+                                OPCACHE_DEOPT();
                             }
                         }
                     }
                     else {
                         // The type of the object has either been updated,
                         // or is different.  Maybe it will stabilize?
-                        OPCACHE_MAYBE_DEOPT_LOAD_ATTR();
+                        OPCACHE_MAYBE_DEOPT();
                     }
-                    OPCACHE_STAT_ATTR_MISS();
+                    OPCACHE_STAT_MISS();
                 }
 
                 if (co_opcache != NULL && // co_opcache can be NULL after a DEOPT() call.
@@ -3513,7 +3751,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
 
                                 if (co_opcache->optimized == 0) {
                                     // First time we optimize this opcode.
-                                    OPCACHE_STAT_ATTR_OPT();
+                                    OPCACHE_STAT_OPT();
                                     co_opcache->optimized = OPCODE_CACHE_MAX_TRIES;
                                     // fprintf(stderr, "Setting hint for %s, offset %zd\n", dmem->name, offset);
                                 }
@@ -3537,7 +3775,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
                             // Else it's a slot of a different type.  We don't handle those.
                         }
                         // Else it's some other kind of descriptor that we don't handle.
-                        OPCACHE_DEOPT_LOAD_ATTR();
+                        OPCACHE_DEOPT();
                     }
                     else if (type->tp_dictoffset > 0) {
                         // We found an instance with a __dict__.
@@ -3557,7 +3795,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
 
                                 if (co_opcache->optimized == 0) {
                                     // First time we optimize this opcode.
-                                    OPCACHE_STAT_ATTR_OPT();
+                                    OPCACHE_STAT_OPT();
                                     co_opcache->optimized = OPCODE_CACHE_MAX_TRIES;
                                 }
 
@@ -3575,14 +3813,14 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
                             Py_DECREF(dict);
                         } else {
                             // There is no dict, or __dict__ doesn't satisfy PyDict_CheckExact.
-                            OPCACHE_DEOPT_LOAD_ATTR();
+                            OPCACHE_DEOPT();
                         }
                     } else {
                         // The object's class does not have a tp_dictoffset we can use.
-                        OPCACHE_DEOPT_LOAD_ATTR();
+                        OPCACHE_DEOPT();
                     }
                 } else if (type->tp_getattro != PyObject_GenericGetAttr) {
-                    OPCACHE_DEOPT_LOAD_ATTR();
+                    OPCACHE_DEOPT();
                 }
             }
 
@@ -3599,7 +3837,27 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
             assert(oparg <= Py_GE);
             PyObject *right = POP();
             PyObject *left = TOP();
-            PyObject *res = PyObject_RichCompare(left, right, oparg);
+            PyObject *res;
+            int kind = OPCACHE_KIND_NONE;
+            OPCACHE_CHECK();
+            if (co_opcache != NULL) {
+                kind = opcache_binary_kind(left, right);
+                OPCACHE_SPECIALIZE(kind);
+            }
+            if (kind == OPCACHE_KIND_INT) {
+                res = PyLong_Type.tp_richcompare(left, right, oparg);
+            }
+            else if (kind == OPCACHE_KIND_FLOAT) {
+                res = opcache_float_compare(PyFloat_AS_DOUBLE(left),
+                                            PyFloat_AS_DOUBLE(right), oparg);
+                Py_INCREF(res);
+            }
+            else if (kind == OPCACHE_KIND_UNICODE) {
+                res = PyUnicode_RichCompare(left, right, oparg);
+            }
+            else {
+                res = PyObject_RichCompare(left, right, oparg);
+            }
             SET_TOP(res);
             Py_DECREF(left);
             Py_DECREF(right);
@@ -4130,6 +4388,42 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
             PyObject *name = GETITEM(names, oparg);
             PyObject *obj = TOP();
             PyObject *meth = NULL;
+            PyTypeObject *type = Py_TYPE(obj);
+
+            OPCACHE_CHECK();
+            if (co_opcache != NULL && co_opcache->optimized > 0) {
+                _PyOpcache_LoadMethod *lm = &co_opcache->u.lm;
+                if (lm->type == type &&
+                    lm->tp_version_tag == type->tp_version_tag &&
+                    PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG))
+                {
+                    /* The type still resolves name to the cached method
+                       descriptor; make sure the instance doesn't shadow it. */
+                    int shadowed = 0;
+                    if (type->tp_dictoffset != 0) {
+                        PyObject **dictptr = _PyObject_GetDictPtr(obj);
+                        PyObject *dict = dictptr != NULL ? *dictptr : NULL;
+                        if (dict != NULL) {
+                            Py_INCREF(dict);
+                            shadowed = PyDict_GetItemWithError(dict, name) != NULL;
+                            Py_DECREF(dict);
+                            if (!shadowed && _PyErr_Occurred(tstate)) {
+                                goto error;
+                            }
+                        }
+                    }
+                    if (!shadowed) {
+                        OPCACHE_STAT_HIT();
+                        meth = lm->descr;
+                        Py_INCREF(meth);
+                        SET_TOP(meth);
+                        PUSH(obj);  // self
+                        DISPATCH();
+                    }
+                }
+                OPCACHE_STAT_MISS();
+                OPCACHE_MAYBE_DEOPT();
+            }
 
             int meth_found = _PyObject_GetMethod(obj, name, &meth);
 
@@ -4138,6 +4432,25 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
                 goto error;
             }
 
+            if (co_opcache != NULL) {
+                if (meth_found &&
+                    type->tp_getattro == PyObject_GenericGetAttr &&
+                    PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG))
+                {
+                    _PyOpcache_LoadMethod *lm = &co_opcache->u.lm;
+                    if (co_opcache->optimized == 0) {
+                        OPCACHE_STAT_OPT();
+                        co_opcache->optimized = OPCODE_CACHE_MAX_TRIES;
+                    }
+                    lm->type = type;
+                    lm->tp_version_tag = type->tp_version_tag;
+                    lm->descr = meth;  /* borrowed, kept alive by the type */
+                }
+                else if (co_opcache->optimized == 0) {
+                    OPCACHE_DEOPT();
+                }
+            }
+
             if (meth_found) {
                 /* We can bypass temporary bound method object.
                    meth is unbound method and obj is self.
@@ -4184,6 +4497,12 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
                    `callable` will be POPed by call_function.
                    NULL will will be POPed manually later.
                 */
+                if (CAN_INLINE_CALL(PEEK(oparg + 1))) {
+                    inline_oparg = oparg;
+                    inline_kwnames = NULL;
+                    inline_pop_null = 1;
+                    goto inline_call;
+                }
                 res = call_function(tstate, &trace_info, &sp, oparg, NULL);
                 stack_pointer = sp;
                 (void)POP(); /* POP the NULL. */
@@ -4201,6 +4520,12 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
                   We'll be passing `oparg + 1` to call_function, to
                   make it accept the `self` as a first argument.
                 */
+                if (CAN_INLINE_CALL(meth)) {
+                    inline_oparg = oparg + 1;
+                    inline_kwnames = NULL;
+                    inline_pop_null = 0;
+                    goto inline_call;
+                }
                 res = call_function(tstate, &trace_info, &sp, oparg + 1, NULL);
                 stack_pointer = sp;
             }
@@ -4215,6 +4540,46 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
         case TARGET(CALL_FUNCTION): {
             PREDICTED(CALL_FUNCTION);
             PyObject **sp, *res;
+            OPCACHE_CHECK();
+            if (co_opcache != NULL && !trace_info.cframe.use_tracing) {
+                PyObject *func = PEEK(oparg + 1);
+                int kind = opcache_call_kind(func, oparg);
+                OPCACHE_SPECIALIZE(kind);
+                if (kind != OPCACHE_KIND_NONE) {
+                    /* Builtin function: call the C function directly
+                       instead of going through vectorcall. */
+                    if (_Py_EnterRecursiveCall(tstate, " while calling a Python object")) {
+                        goto error;
+                    }
+                    PyCFunction cfunc = PyCFunction_GET_FUNCTION(func);
+                    PyObject *self = PyCFunction_GET_SELF(func);
+                    if (kind == OPCACHE_KIND_BUILTIN_O) {
+                        res = cfunc(self, TOP());
+                    }
+                    else {
+                        res = ((_PyCFunctionFast)(void(*)(void))cfunc)(
+                            self, stack_pointer - oparg, oparg);
+                    }
+                    _Py_LeaveRecursiveCall(tstate);
+                    res = _Py_CheckFunctionResult(tstate, func, res, NULL);
+                    for (int i = 0; i <= oparg; i++) {
+                        PyObject *w = POP();
+                        Py_DECREF(w);
+                    }
+                    PUSH(res);
+                    if (res == NULL) {
+                        goto error;
+                    }
+                    CHECK_EVAL_BREAKER();
+                    DISPATCH();
+                }
+            }
+            if (CAN_INLINE_CALL(PEEK(oparg + 1))) {
+                inline_oparg = oparg;
+                inline_kwnames = NULL;
+                inline_pop_null = 0;
+                goto inline_call;
+            }
             sp = stack_pointer;
             res = call_function(tstate, &trace_info, &sp, oparg, NULL);
             stack_pointer = sp;
@@ -4233,6 +4598,12 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
             assert(PyTuple_Check(names));
             assert(PyTuple_GET_SIZE(names) <= oparg);
             /* We assume without checking that names contains only strings */
+            if (CAN_INLINE_CALL(PEEK(oparg + 1))) {
+                inline_oparg = oparg;
+                inline_kwnames = names;
+                inline_pop_null = 0;
+                goto inline_call;
+            }
             sp = stack_pointer;
             res = call_function(tstate, &trace_info, &sp, oparg, names);
             stack_pointer = sp;
@@ -4437,6 +4808,49 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
            or goto error. */
         Py_UNREACHABLE();
 
+inline_call:
+        {
+            /* Call the Python function below the inline_oparg arguments
+               on the stack by pushing a new frame and continuing the
+               loop with it.  The frame is returned from in
+               exit_eval_frame below. */
+            PyObject **pfunc = stack_pointer - inline_oparg - 1;
+            PyFrameConstructor *con = PyFunction_AS_FRAME_CONSTRUCTOR(*pfunc);
+            Py_ssize_t nkwargs = (inline_kwnames == NULL) ? 0 :
+                                 PyTuple_GET_SIZE(inline_kwnames);
+            PyObject *locals = NULL;
+            if ((((PyCodeObject *)con->fc_code)->co_flags & CO_OPTIMIZED) == 0) {
+                locals = con->fc_globals;
+            }
+            PyFrameObject *callee = _PyEval_MakeFrameVector(
+                tstate, con, locals, pfunc + 1, inline_oparg - nkwargs,
+                inline_kwnames);
+            Py_XDECREF(inline_kwnames);
+            while (stack_pointer > pfunc) {
+                PyObject *w = POP();
+                Py_DECREF(w);
+            }
+            if (inline_pop_null) {
+                (void)POP();
+            }
+            if (callee == NULL) {
+                goto error;
+            }
+            if (_Py_EnterRecursiveCall(tstate, "")) {
+                release_frame(tstate, callee);
+                goto error;
+            }
+            /* The caller's value stack and position are saved in the frame
+               while the callee runs.  f_lasti is not up to date when the
+               call instruction was reached through PREDICT(). */
+            f->f_stackdepth = (int)(stack_pointer - f->f_valuestack);
+            f->f_lasti = INSTR_OFFSET() - 1;
+            f = callee;
+            /* Line tracing bounds refer to the caller */
+            trace_info.code = NULL;
+            goto start_frame;
+        }
+
 error:
         /* Double-check exception status. */
 #ifdef NDEBUG
@@ -4538,6 +4952,40 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
 
     /* pop frame */
 exit_eval_frame:
+    if (f != entry_frame) {
+        /* Return from an inlined call to its caller */
+        PyFrameObject *callee = f;
+        if (PyDTrace_FUNCTION_RETURN_ENABLED())
+            dtrace_function_return(callee);
+        _Py_LeaveRecursiveCall(tstate);
+        f = callee->f_back;
+        tstate->frame = f;
+        retval = _Py_CheckFunctionResult(tstate, NULL, retval, __func__);
+        release_frame(tstate, callee);
+
+        co = f->f_code;
+        names = co->co_names;
+        consts = co->co_consts;
+        fastlocals = f->f_localsplus;
+        freevars = f->f_localsplus + co->co_nlocals;
+        first_instr = (_Py_CODEUNIT *) PyBytes_AS_STRING(co->co_code);
+        next_instr = first_instr + f->f_lasti + 1;
+        stack_pointer = f->f_valuestack + f->f_stackdepth;
+        f->f_stackdepth = -1;
+        /* Line tracing bounds refer to the callee */
+        trace_info.code = NULL;
+
+        PUSH(retval);
+        retval = NULL;
+        if (TOP() == NULL) {
+            goto error;
+        }
+        if (_Py_atomic_load_relaxed(eval_breaker)) {
+            goto main_loop;
+        }
+        DISPATCH();
+    }
+
     /* Restore previous cframe */
     tstate->cframe = trace_info.cframe.previous;
     tstate->cframe->use_tracing = trace_info.cframe.use_tracing;
@@ -4869,6 +5317,27 @@ get_exception_handler(PyCodeObject *code, int index)
     return res;
 }
 
+/* Drop the reference to a frame created by _PyEval_MakeFrameVector() once
+   it has finished executing. */
+static void
+release_frame(PyThreadState *tstate, PyFrameObject *f)
+{
+    /* decref'ing the frame can cause __del__ methods to get invoked,
+       which can call back into Python.  While we're done with the
+       current Python frame (f), the associated C stack is still in use,
+       so recursion_depth must be boosted for the duration.
+    */
+    if (Py_REFCNT(f) > 1) {
+        Py_DECREF(f);
+        _PyObject_GC_TRACK(f);
+    }
+    else {
+        ++tstate->recursion_depth;
+        Py_DECREF(f);
+        --tstate->recursion_depth;
+    }
+}
+
 PyFrameObject *
 _PyEval_MakeFrameVector(PyThreadState *tstate,
            PyFrameConstructor *con, PyObject *locals,
@@ -5096,21 +5565,7 @@ _PyEval_MakeFrameVector(PyThreadState *tstate,
     return f;
 
 fail: /* Jump here from prelude on failure */
-
-    /* decref'ing the frame can cause __del__ methods to get invoked,
-       which can call back into Python.  While we're done with the
-       current Python frame (f), the associated C stack is still in use,
-       so recursion_depth must be boosted for the duration.
-    */
-    if (Py_REFCNT(f) > 1) {
-        Py_DECREF(f);
-        _PyObject_GC_TRACK(f);
-    }
-    else {
-        ++tstate->recursion_depth;
-        Py_DECREF(f);
-        --tstate->recursion_depth;
-    }
+    release_frame(tstate, f);
     return NULL;
 }
 
@@ -5158,21 +5613,7 @@ _PyEval_Vector(PyThreadState *tstate, PyFrameConstructor *con,
         return make_coro(con, f);
     }
     PyObject *retval = _PyEval_EvalFrame(tstate, f, 0);
-
-    /* decref'ing the frame can cause __del__ methods to get invoked,
-       which can call back into Python.  While we're done with the
-       current Python frame (f), the associated C stack is still in use,
-       so recursion_depth must be boosted for the duration.
-    */
-    if (Py_REFCNT(f) > 1) {
-        Py_DECREF(f);
-        _PyObject_GC_TRACK(f);
-    }
-    else {
-        ++tstate->recursion_depth;
-        Py_DECREF(f);
-        --tstate->recursion_depth;
-    }
+    release_frame(tstate, f);
     return retval;
 }
 
@@ -738,6 +738,36 @@ sys_getallocatedblocks(PyObject *module, PyObject *Py_UNUSED(ignored))
     return return_value;
 }
 
+PyDoc_STRVAR(sys__trim_memory__doc__,
+"_trim_memory($module, /)\n"
+"--\n"
+"\n"
+"Release the memory of the free pools of pymalloc arenas to the OS.\n"
+"\n"
+"Return the number of bytes released.");
+
+#define SYS__TRIM_MEMORY_METHODDEF    \
+    {"_trim_memory", (PyCFunction)sys__trim_memory, METH_NOARGS, sys__trim_memory__doc__},
+
+static Py_ssize_t
+sys__trim_memory_impl(PyObject *module);
+
+static PyObject *
+sys__trim_memory(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    Py_ssize_t _return_value;
+
+    _return_value = sys__trim_memory_impl(module);
+    if ((_return_value == -1) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyLong_FromSsize_t(_return_value);
+
+exit:
+    return return_value;
+}
+
 PyDoc_STRVAR(sys__getframe__doc__,
 "_getframe($module, depth=0, /)\n"
 "--\n"
@@ -956,6 +986,75 @@ sys__deactivate_opcache(PyObject *module, PyObject *Py_UNUSED(ignored))
     return sys__deactivate_opcache_impl(module);
 }
 
+PyDoc_STRVAR(sys__opcache_stats__doc__,
+"_opcache_stats($module, code=None, /)\n"
+"--\n"
+"\n"
+"Return opcode cache statistics.\n"
+"\n"
+"Without argument, return a dictionary with the number of code objects that\n"
+"got an opcode cache, the memory used by the caches and the hit, miss,\n"
+"optimization and deoptimization counts of each cached opcode.\n"
+"\n"
+"If a code object is given, return its own counts, or None if nothing was\n"
+"recorded for it.\n"
+"\n"
+"Statistics are only collected while enabled, see sys._set_opcache_stats().");
+
+#define SYS__OPCACHE_STATS_METHODDEF    \
+    {"_opcache_stats", (PyCFunction)(void(*)(void))sys__opcache_stats, METH_FASTCALL, sys__opcache_stats__doc__},
+
+static PyObject *
+sys__opcache_stats_impl(PyObject *module, PyObject *code);
+
+static PyObject *
+sys__opcache_stats(PyObject *module, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *code = Py_None;
+
+    if (!_PyArg_CheckPositional("_opcache_stats", nargs, 0, 1)) {
+        goto exit;
+    }
+    if (nargs < 1) {
+        goto skip_optional;
+    }
+    code = args[0];
+skip_optional:
+    return_value = sys__opcache_stats_impl(module, code);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(sys__set_opcache_stats__doc__,
+"_set_opcache_stats($module, enabled, /)\n"
+"--\n"
+"\n"
+"Enable or disable the collection of opcode cache statistics.");
+
+#define SYS__SET_OPCACHE_STATS_METHODDEF    \
+    {"_set_opcache_stats", (PyCFunction)sys__set_opcache_stats, METH_O, sys__set_opcache_stats__doc__},
+
+static PyObject *
+sys__set_opcache_stats_impl(PyObject *module, int enabled);
+
+static PyObject *
+sys__set_opcache_stats(PyObject *module, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    int enabled;
+
+    enabled = PyObject_IsTrue(arg);
+    if (enabled < 0) {
+        goto exit;
+    }
+    return_value = sys__set_opcache_stats_impl(module, enabled);
+
+exit:
+    return return_value;
+}
+
 #ifndef SYS_GETWINDOWSVERSION_METHODDEF
     #define SYS_GETWINDOWSVERSION_METHODDEF
 #endif /* !defined(SYS_GETWINDOWSVERSION_METHODDEF) */
@@ -983,4 +1082,4 @@ sys__deactivate_opcache(PyObject *module, PyObject *Py_UNUSED(ignored))
 #ifndef SYS_GETANDROIDAPILEVEL_METHODDEF
     #define SYS_GETANDROIDAPILEVEL_METHODDEF
 #endif /* !defined(SYS_GETANDROIDAPILEVEL_METHODDEF) */
-/*[clinic end generated code: output=68c62b9ca317a0c8 input=a9049054013a1b77]*/
+/*[clinic end generated code: output=62b86f7f01ff88ec input=a9049054013a1b77]*/
@@ -6,6 +6,7 @@
 #include "pycore_pathconfig.h"    // _Py_path_config
 #include "pycore_pyerrors.h"      // _PyErr_Fetch()
 #include "pycore_pylifecycle.h"   // _Py_PreInitializeFromConfig()
+#include "pycore_pyhash.h"        // _PyHash_LookupFuncDef()
 #include "pycore_pymem.h"         // _PyMem_SetDefaultAllocator()
 #include "pycore_pystate.h"       // _PyThreadState_GET()
 
@@ -95,6 +96,10 @@ static const char usage_3[] = "\
          -X pycache_prefix=PATH: enable writing .pyc files to a parallel tree rooted at the\n\
              given directory instead of to the code tree\n\
          -X warn_default_encoding: enable opt-in EncodingWarning for 'encoding=None'\n\
+         -X opcachestats: collect opcode cache statistics, see sys._opcache_stats(),\n\
+             and dump them when the program finishes\n\
+         -X hugepages: back pymalloc arenas with 2 MiB huge pages when the OS\n\
+             supports them. It also can be set using PYTHONHUGEPAGES.\n\
 \n\
 --check-hash-based-pycs always|default|never:\n\
     control how Python invalidates hash-based .pyc files\n\
@@ -121,6 +126,8 @@ static const char usage_6[] =
 "   to seed the hashes of str and bytes objects.  It can also be set to an\n"
 "   integer in the range [0,4294967295] to get hash values with a\n"
 "   predictable seed.\n"
+"PYTHONHASHALGORITHM: hash function of str and bytes objects: 'siphash13',\n"
+"   'siphash24' or 'fnv'.\n"
 "PYTHONMALLOC: set the Python memory allocators and/or install debug hooks\n"
 "   on Python memory allocators. Use PYTHONMALLOC=debug to install debug\n"
 "   hooks.\n"
@@ -598,8 +605,10 @@ config_check_consistency(const PyConfig *config)
     assert(config->tracemalloc >= 0);
     assert(config->import_time >= 0);
     assert(config->show_ref_count >= 0);
+    assert(config->opcache_stats >= 0);
     assert(config->dump_refs >= 0);
     assert(config->malloc_stats >= 0);
+    assert(config->hugepages >= 0);
     assert(config->site_import >= 0);
     assert(config->bytes_warning >= 0);
     assert(config->warn_default_encoding >= 0);
@@ -651,6 +660,7 @@ PyConfig_Clear(PyConfig *config)
         ATTR = NULL; \
     } while (0)
 
+    CLEAR(config->hash_algorithm);
     CLEAR(config->pycache_prefix);
     CLEAR(config->pythonpath_env);
     CLEAR(config->home);
@@ -880,13 +890,16 @@ _PyConfig_Copy(PyConfig *config, const PyConfig *config2)
     COPY_ATTR(install_signal_handlers);
     COPY_ATTR(use_hash_seed);
     COPY_ATTR(hash_seed);
+    COPY_WSTR_ATTR(hash_algorithm);
     COPY_ATTR(_install_importlib);
     COPY_ATTR(faulthandler);
     COPY_ATTR(tracemalloc);
     COPY_ATTR(import_time);
     COPY_ATTR(show_ref_count);
+    COPY_ATTR(opcache_stats);
     COPY_ATTR(dump_refs);
     COPY_ATTR(malloc_stats);
+    COPY_ATTR(hugepages);
 
     COPY_WSTR_ATTR(pycache_prefix);
     COPY_WSTR_ATTR(pythonpath_env);
@@ -985,12 +998,15 @@ _PyConfig_AsDict(const PyConfig *config)
     SET_ITEM_INT(install_signal_handlers);
     SET_ITEM_INT(use_hash_seed);
     SET_ITEM_UINT(hash_seed);
+    SET_ITEM_WSTR(hash_algorithm);
     SET_ITEM_INT(faulthandler);
     SET_ITEM_INT(tracemalloc);
     SET_ITEM_INT(import_time);
     SET_ITEM_INT(show_ref_count);
+    SET_ITEM_INT(opcache_stats);
     SET_ITEM_INT(dump_refs);
     SET_ITEM_INT(malloc_stats);
+    SET_ITEM_INT(hugepages);
     SET_ITEM_WSTR(filesystem_encoding);
     SET_ITEM_WSTR(filesystem_errors);
     SET_ITEM_WSTR(pycache_prefix);
@@ -1261,12 +1277,15 @@ _PyConfig_FromDict(PyConfig *config, PyObject *dict)
         return -1;
     }
     CHECK_VALUE("hash_seed", config->hash_seed <= MAX_HASH_SEED);
+    GET_WSTR_OPT(hash_algorithm);
     GET_UINT(faulthandler);
     GET_UINT(tracemalloc);
     GET_UINT(import_time);
     GET_UINT(show_ref_count);
+    GET_UINT(opcache_stats);
     GET_UINT(dump_refs);
     GET_UINT(malloc_stats);
+    GET_UINT(hugepages);
     GET_WSTR(filesystem_encoding);
     GET_WSTR(filesystem_errors);
     GET_WSTR_OPT(pycache_prefix);
@@ -1686,6 +1705,9 @@ config_read_env_vars(PyConfig *config)
     if (config_get_env(config, "PYTHONMALLOCSTATS")) {
         config->malloc_stats = 1;
     }
+    if (config_get_env(config, "PYTHONHUGEPAGES")) {
+        config->hugepages = 1;
+    }
 
     if (config->pythonpath_env == NULL) {
         status = CONFIG_GET_ENV_DUP(config, &config->pythonpath_env,
@@ -1710,6 +1732,15 @@ config_read_env_vars(PyConfig *config)
         }
     }
 
+    if (config->hash_algorithm == NULL) {
+        status = CONFIG_GET_ENV_DUP(config, &config->hash_algorithm,
+                                    L"PYTHONHASHALGORITHM",
+                                    "PYTHONHASHALGORITHM");
+        if (_PyStatus_EXCEPTION(status)) {
+            return status;
+        }
+    }
+
     return _PyStatus_OK();
 }
 
@@ -2054,6 +2085,12 @@ config_read(PyConfig *config, int compute_path_config)
     if (config_get_xoption(config, L"showrefcount")) {
         config->show_ref_count = 1;
     }
+    if (config_get_xoption(config, L"opcachestats")) {
+        config->opcache_stats = 1;
+    }
+    if (config_get_xoption(config, L"hugepages")) {
+        config->hugepages = 1;
+    }
 
     status = config_read_complex_options(config);
     if (_PyStatus_EXCEPTION(status)) {
@@ -2105,6 +2142,12 @@ config_read(PyConfig *config, int compute_path_config)
         config->use_hash_seed = 0;
         config->hash_seed = 0;
     }
+    if (config->hash_algorithm != NULL
+        && _PyHash_LookupFuncDef(config->hash_algorithm) == NULL)
+    {
+        return _PyStatus_ERR("PYTHONHASHALGORITHM must be \"siphash13\", "
+                             "\"siphash24\" or \"fnv\"");
+    }
 
     if (config->filesystem_encoding == NULL || config->filesystem_errors == NULL) {
         status = config_init_fs_encoding(config, preconfig);
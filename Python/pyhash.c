@@ -4,6 +4,7 @@
    All the utility functions (_Py_Hash*()) return "-1" to signify an error.
 */
 #include "Python.h"
+#include "pycore_pyhash.h"        // _PyHash_LookupFuncDef()
 
 #ifdef __APPLE__
 #  include <libkern/OSByteOrder.h>
@@ -21,9 +22,36 @@ _Py_HashSecret_t _Py_HashSecret = {{0}};
 
 #if Py_HASH_ALGORITHM == Py_HASH_EXTERNAL
 extern PyHash_FuncDef PyHash_Func;
+#endif
+static PyHash_FuncDef fnv_func;
+static PyHash_FuncDef siphash13_func;
+static PyHash_FuncDef siphash24_func;
+
+/* The hash function used for str, bytes and memoryview.  It defaults to the
+   one selected at build time with Py_HASH_ALGORITHM, and can be changed at
+   startup with PYTHONHASHALGORITHM, before any string is hashed. */
+#if Py_HASH_ALGORITHM == Py_HASH_EXTERNAL
+#  define DEFAULT_HASH_FUNC (&PyHash_Func)
+#elif Py_HASH_ALGORITHM == Py_HASH_SIPHASH13
+#  define DEFAULT_HASH_FUNC (&siphash13_func)
+#elif Py_HASH_ALGORITHM == Py_HASH_SIPHASH24
+#  define DEFAULT_HASH_FUNC (&siphash24_func)
+#elif Py_HASH_ALGORITHM == Py_HASH_FNV
+#  define DEFAULT_HASH_FUNC (&fnv_func)
 #else
-static PyHash_FuncDef PyHash_Func;
+#  error "unknown Py_HASH_ALGORITHM"
+#endif
+static PyHash_FuncDef *hash_func = DEFAULT_HASH_FUNC;
+
+/* Hash functions which can be selected by name at startup */
+static PyHash_FuncDef *const hash_funcs[] = {
+#if Py_HASH_ALGORITHM == Py_HASH_EXTERNAL
+    &PyHash_Func,
 #endif
+    &siphash13_func,
+    &siphash24_func,
+    &fnv_func,
+};
 
 /* Count _Py_HashBytes() calls */
 #ifdef Py_HASH_STATS
@@ -195,7 +223,7 @@ _Py_HashBytes(const void *src, Py_ssize_t len)
     }
     else
 #endif /* Py_HASH_CUTOFF */
-        x = PyHash_Func.hash(src, len);
+        x = hash_func->hash(src, len);
 
     if (x == -1)
         return -2;
@@ -220,7 +248,34 @@ _PyHash_Fini(void)
 PyHash_FuncDef *
 PyHash_GetFuncDef(void)
 {
-    return &PyHash_Func;
+    return hash_func;
+}
+
+/* Return the hash function called name, or NULL if there is none. */
+PyHash_FuncDef *
+_PyHash_LookupFuncDef(const wchar_t *name)
+{
+    for (size_t i = 0; i < Py_ARRAY_LENGTH(hash_funcs); i++) {
+        const char *s = hash_funcs[i]->name;
+        const wchar_t *w = name;
+        while (*s != '\0' && (wchar_t)*s == *w) {
+            s++;
+            w++;
+        }
+        if (*s == '\0' && *w == L'\0') {
+            return hash_funcs[i];
+        }
+    }
+    return NULL;
+}
+
+/* Select the hash function of str, bytes and memoryview, or the build
+   default if funcdef is NULL.  This must be done before any of them is
+   hashed, since hashes are cached. */
+void
+_PyHash_SetFuncDef(PyHash_FuncDef *funcdef)
+{
+    hash_func = (funcdef != NULL) ? funcdef : DEFAULT_HASH_FUNC;
 }
 
 /* Optimized memcpy() for Windows */
@@ -242,7 +297,6 @@ PyHash_GetFuncDef(void)
 #endif /* _MSC_VER */
 
 
-#if Py_HASH_ALGORITHM == Py_HASH_FNV
 /* **************************************************************************
  * Modified Fowler-Noll-Vo (FNV) hash function
  */
@@ -286,10 +340,8 @@ fnv(const void *src, Py_ssize_t len)
     return x;
 }
 
-static PyHash_FuncDef PyHash_Func = {fnv, "fnv", 8 * SIZEOF_PY_HASH_T,
-                                     16 * SIZEOF_PY_HASH_T};
-
-#endif /* Py_HASH_ALGORITHM == Py_HASH_FNV */
+static PyHash_FuncDef fnv_func = {fnv, "fnv", 8 * SIZEOF_PY_HASH_T,
+                                  16 * SIZEOF_PY_HASH_T};
 
 
 /* **************************************************************************
@@ -364,12 +416,69 @@ static PyHash_FuncDef PyHash_Func = {fnv, "fnv", 8 * SIZEOF_PY_HASH_T,
     d = ROTATE(d, t) ^ c;           \
     a = ROTATE(a, 32);
 
-#define DOUBLE_ROUND(v0,v1,v2,v3)       \
-    HALF_ROUND(v0,v1,v2,v3,13,16);      \
-    HALF_ROUND(v2,v1,v0,v3,17,21);      \
+#define SINGLE_ROUND(v0,v1,v2,v3)       \
     HALF_ROUND(v0,v1,v2,v3,13,16);      \
     HALF_ROUND(v2,v1,v0,v3,17,21);
 
+#define DOUBLE_ROUND(v0,v1,v2,v3)       \
+    SINGLE_ROUND(v0,v1,v2,v3);          \
+    SINGLE_ROUND(v0,v1,v2,v3);
+
+
+/* SipHash-1-3: one compression round per 8-byte block and three finalization
+   rounds instead of two and four for SipHash-2-4.  This is the variant
+   recommended by its authors for hash tables, and much faster on long
+   inputs. */
+static uint64_t
+siphash13(uint64_t k0, uint64_t k1, const void *src, Py_ssize_t src_sz) {
+    uint64_t b = (uint64_t)src_sz << 56;
+    const uint8_t *in = (const uint8_t*)src;
+
+    uint64_t v0 = k0 ^ 0x736f6d6570736575ULL;
+    uint64_t v1 = k1 ^ 0x646f72616e646f6dULL;
+    uint64_t v2 = k0 ^ 0x6c7967656e657261ULL;
+    uint64_t v3 = k1 ^ 0x7465646279746573ULL;
+
+    uint64_t t;
+    uint8_t *pt;
+
+    while (src_sz >= 8) {
+        uint64_t mi;
+        memcpy(&mi, in, sizeof(mi));
+        mi = _le64toh(mi);
+        in += sizeof(mi);
+        src_sz -= sizeof(mi);
+        v3 ^= mi;
+        SINGLE_ROUND(v0,v1,v2,v3);
+        v0 ^= mi;
+    }
+
+    t = 0;
+    pt = (uint8_t *)&t;
+    switch (src_sz) {
+        case 7: pt[6] = in[6]; /* fall through */
+        case 6: pt[5] = in[5]; /* fall through */
+        case 5: pt[4] = in[4]; /* fall through */
+        case 4: memcpy(pt, in, sizeof(uint32_t)); break;
+        case 3: pt[2] = in[2]; /* fall through */
+        case 2: pt[1] = in[1]; /* fall through */
+        case 1: pt[0] = in[0]; /* fall through */
+    }
+    b |= _le64toh(t);
+
+    v3 ^= b;
+    SINGLE_ROUND(v0,v1,v2,v3);
+    v0 ^= b;
+    v2 ^= 0xff;
+    SINGLE_ROUND(v0,v1,v2,v3);
+    SINGLE_ROUND(v0,v1,v2,v3);
+    SINGLE_ROUND(v0,v1,v2,v3);
+
+    /* modified */
+    t = (v0 ^ v1) ^ (v2 ^ v3);
+    return t;
+}
+
 
 static uint64_t
 siphash24(uint64_t k0, uint64_t k1, const void *src, Py_ssize_t src_sz) {
@@ -421,13 +530,21 @@ siphash24(uint64_t k0, uint64_t k1, const void *src, Py_ssize_t src_sz) {
 }
 
 uint64_t
-_Py_KeyedHash(uint64_t key, const void *src, Py_ssize_t src_sz)
+_Py_KeyedHash(uint64_t key, const char *src, Py_ssize_t src_sz)
 {
     return siphash24(key, 0, src, src_sz);
 }
 
 
-#if Py_HASH_ALGORITHM == Py_HASH_SIPHASH24
+static Py_hash_t
+pysiphash13(const void *src, Py_ssize_t src_sz) {
+    return (Py_hash_t)siphash13(
+        _le64toh(_Py_HashSecret.siphash.k0), _le64toh(_Py_HashSecret.siphash.k1),
+        src, src_sz);
+}
+
+static PyHash_FuncDef siphash13_func = {pysiphash13, "siphash13", 64, 128};
+
 static Py_hash_t
 pysiphash(const void *src, Py_ssize_t src_sz) {
     return (Py_hash_t)siphash24(
@@ -435,8 +552,7 @@ pysiphash(const void *src, Py_ssize_t src_sz) {
         src, src_sz);
 }
 
-static PyHash_FuncDef PyHash_Func = {pysiphash, "siphash24", 64, 128};
-#endif
+static PyHash_FuncDef siphash24_func = {pysiphash, "siphash24", 64, 128};
 
 #ifdef __cplusplus
 }
@@ -648,6 +648,8 @@ new_threadstate(PyInterpreterState *interp, int init)
 
     tstate->trash_delete_nesting = 0;
     tstate->trash_delete_later = NULL;
+    memset(&tstate->obmalloc_cache, 0, sizeof(tstate->obmalloc_cache));
+    tstate->obmalloc_cache.enabled = 1;
     tstate->on_delete = NULL;
     tstate->on_delete_data = NULL;
 
@@ -869,6 +871,8 @@ PyThreadState_Clear(PyThreadState *tstate)
 
     Py_CLEAR(tstate->context);
 
+    _PyObject_ClearBlockCache(tstate);
+
     if (tstate->on_delete != NULL) {
         tstate->on_delete(tstate->on_delete_data);
     }
@@ -1023,6 +1027,12 @@ _PyThreadState_Swap(struct _gilstate_runtime_state *gilstate, PyThreadState *new
     PyThreadState *oldts = _PyRuntimeGILState_GetThreadState(gilstate);
 #endif
 
+    if (oldts != NULL && newts != NULL && oldts != newts) {
+        /* Only the current thread state keeps blocks cached by pymalloc, see
+           PyEval_SaveThread() for the other case.  oldts may already be
+           deleted when newts is NULL. */
+        _PyObject_FlushBlockCache(oldts);
+    }
     _PyRuntimeGILState_SetThreadState(gilstate, newts);
     /* It should not be possible for more than one thread state
        to be used for a thread.  Check this the best we can in debug
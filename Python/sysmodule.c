@@ -1779,6 +1779,22 @@ sys_getallocatedblocks_impl(PyObject *module)
 }
 
 
+/*[clinic input]
+sys._trim_memory -> Py_ssize_t
+
+Release the memory of the free pools of pymalloc arenas to the OS.
+
+Return the number of bytes released.
+[clinic start generated code]*/
+
+static Py_ssize_t
+sys__trim_memory_impl(PyObject *module)
+/*[clinic end generated code: output=3126d241cfc76942 input=c518f447fd867931]*/
+{
+    return _PyObject_TrimArenas();
+}
+
+
 /*[clinic input]
 sys._getframe
 
@@ -1974,6 +1990,50 @@ sys__deactivate_opcache_impl(PyObject *module)
 }
 
 
+/*[clinic input]
+sys._opcache_stats
+
+    code: object = None
+    /
+
+Return opcode cache statistics.
+
+Without argument, return a dictionary with the number of code objects that
+got an opcode cache, the memory used by the caches and the hit, miss,
+optimization and deoptimization counts of each cached opcode.
+
+If a code object is given, return its own counts, or None if nothing was
+recorded for it.
+
+Statistics are only collected while enabled, see sys._set_opcache_stats().
+[clinic start generated code]*/
+
+static PyObject *
+sys__opcache_stats_impl(PyObject *module, PyObject *code)
+/*[clinic end generated code: output=e46ea3986f0c32ce input=2ba379e8d84be44d]*/
+{
+    return _PyEval_GetOpcacheStats(code == Py_None ? NULL : code);
+}
+
+
+/*[clinic input]
+sys._set_opcache_stats
+
+    enabled: bool
+    /
+
+Enable or disable the collection of opcode cache statistics.
+[clinic start generated code]*/
+
+static PyObject *
+sys__set_opcache_stats_impl(PyObject *module, int enabled)
+/*[clinic end generated code: output=9dcf8e34ec417ff5 input=232b9852baf2af28]*/
+{
+    _PyEval_SetOpcacheStats(enabled);
+    Py_RETURN_NONE;
+}
+
+
 static PyMethodDef sys_methods[] = {
     /* Might as well keep this in alphabetic order */
     SYS_ADDAUDITHOOK_METHODDEF
@@ -1990,6 +2050,7 @@ static PyMethodDef sys_methods[] = {
     SYS_GETDEFAULTENCODING_METHODDEF
     SYS_GETDLOPENFLAGS_METHODDEF
     SYS_GETALLOCATEDBLOCKS_METHODDEF
+    SYS__TRIM_MEMORY_METHODDEF
 #ifdef DYNAMIC_EXECUTION_PROFILE
     {"getdxp",          _Py_GetDXProfile, METH_VARARGS},
 #endif
@@ -2027,6 +2088,8 @@ static PyMethodDef sys_methods[] = {
     SYS_GETANDROIDAPILEVEL_METHODDEF
     SYS_UNRAISABLEHOOK_METHODDEF
     SYS__DEACTIVATE_OPCACHE_METHODDEF
+    SYS__OPCACHE_STATS_METHODDEF
+    SYS__SET_OPCACHE_STATS_METHODDEF
     {NULL,              NULL}           /* sentinel */
 };
 
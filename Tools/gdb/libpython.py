@@ -806,6 +806,7 @@ def proxyval(self, visited):
             zero is represented by ob_size == 0.
 
         where SHIFT can be either:
+            #define PyLong_SHIFT        60
             #define PyLong_SHIFT        30
             #define PyLong_SHIFT        15
         '''
@@ -815,8 +816,11 @@ def proxyval(self, visited):
 
         ob_digit = self.field('ob_digit')
 
-        if gdb.lookup_type('digit').sizeof == 2:
+        digit_size = gdb.lookup_type('digit').sizeof
+        if digit_size == 2:
             SHIFT = 15
+        elif digit_size == 8:
+            SHIFT = 60
         else:
             SHIFT = 30
 
@@ -0,0 +1,126 @@
+"""Micro-benchmarks for hashing str and bytes objects.
+
+Each benchmark hashes keys of several lengths, given in bytes, and the best
+of a few runs is reported per hash call.  Every algorithm listed with -a is
+timed in a separate interpreter started with PYTHONHASHALGORITHM set; by
+default only the current algorithm is timed.  For example:
+
+    ./python Tools/hashbench/hashbench.py -a siphash13,siphash24,fnv bytes
+"""
+
+import argparse
+import os
+import sys
+import time
+
+
+def make_bytes(length):
+    """Return a pseudo-random bytes object of the given length."""
+    x = length + 1
+    out = bytearray(length)
+    for i in range(length):
+        x = (x * 214013 + 2531011) & 0x7fffffff
+        out[i] = (x >> 16) & 0xff
+    return bytes(out)
+
+
+def bench_bytes(length):
+    # A new memoryview is hashed each time since hashes are cached.
+    b = make_bytes(length)
+    return lambda: hash(memoryview(b))
+
+
+def bench_str(length):
+    # s + 'x' builds a new string, so the timing includes a copy.
+    s = make_bytes(length - 1).decode('latin-1')
+    return lambda: hash(s + 'x')
+
+
+def bench_ucs2(length):
+    s = '\u20ac' + make_bytes(length // 2 - 2).decode('latin-1')
+    return lambda: hash(s + '\u20ac')
+
+
+BENCHMARKS = {
+    'bytes': (bench_bytes, "hash(memoryview(b)), b with N bytes"),
+    'str': (bench_str, "hash(s + 'x'), s a latin-1 str of N bytes"),
+    'ucs2': (bench_ucs2, "hash(s + '\\u20ac'), s a UCS-2 str of N bytes"),
+}
+
+
+def timeit(func, min_time, loops=100):
+    best = float('inf')
+    total = 0.0
+    runs = 0
+    calls = range(loops)
+    while runs < 3 or total < min_time:
+        t0 = time.perf_counter()
+        for _ in calls:
+            func()
+        dt = time.perf_counter() - t0
+        best = min(best, dt)
+        total += dt
+        runs += 1
+    return best / loops
+
+
+def run(names, sizes, min_time):
+    print("Python %s, %s hash"
+          % (sys.version.split()[0], sys.hash_info.algorithm))
+    for name in names:
+        setup, description = BENCHMARKS[name]
+        print()
+        print("%s: %s" % (name, description))
+        for length in sizes:
+            t = timeit(setup(length), min_time)
+            print("  N = %-10d %12.1f ns" % (length, t * 1e9))
+            sys.stdout.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('-s', '--sizes',
+                        default='8,16,32,64,256,1024,16384,65536',
+                        help="comma-separated key lengths in bytes "
+                             "(default: %(default)s)")
+    parser.add_argument('-t', '--min-time', type=float, default=0.2,
+                        help="minimum total time per measurement in seconds "
+                             "(default: %(default)s)")
+    parser.add_argument('-a', '--algorithms',
+                        help="comma-separated hash algorithms to compare, "
+                             "e.g. siphash13,siphash24,fnv "
+                             "(default: the current one)")
+    parser.add_argument('benchmarks', nargs='*', metavar='BENCHMARK',
+                        help="benchmarks to run, among: %s (default: all)"
+                             % ', '.join(BENCHMARKS))
+    args = parser.parse_args()
+
+    sizes = [int(float(s)) for s in args.sizes.split(',')]
+    if min(sizes) < 4:
+        parser.error("key lengths must be at least 4")
+    names = args.benchmarks or list(BENCHMARKS)
+    for name in names:
+        if name not in BENCHMARKS:
+            parser.error("unknown benchmark: %s" % name)
+
+    if not args.algorithms:
+        run(names, sizes, args.min_time)
+        return
+
+    # Imported here so that a single algorithm can be timed on a build
+    # without extension modules.
+    import subprocess
+    for i, algorithm in enumerate(args.algorithms.split(',')):
+        if i:
+            print()
+        sys.stdout.flush()
+        env = dict(os.environ, PYTHONHASHALGORITHM=algorithm)
+        cmd = [sys.executable, __file__, '-s', args.sizes,
+               '-t', str(args.min_time), *names]
+        proc = subprocess.run(cmd, env=env)
+        if proc.returncode:
+            sys.exit(proc.returncode)
+
+
+if __name__ == '__main__':
+    main()
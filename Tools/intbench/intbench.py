@@ -0,0 +1,113 @@
+"""Micro-benchmarks for operations on very large ints.
+
+Each benchmark is run on operands of several sizes, given as a number of
+decimal digits, and the best of a few runs is reported.  For example:
+
+    ./python Tools/intbench/intbench.py -s 1e3,1e4,1e5,1e6 str int
+"""
+
+import argparse
+import sys
+import time
+
+
+def make_int(ndigits, seed=0):
+    """Return a pseudo-random int with exactly ndigits decimal digits.
+
+    The result only depends on ndigits and seed, so that different builds
+    are timed on the same operands.
+    """
+    nwords = ndigits * 415 // 32000 + 1
+    x = ndigits * 2 + seed + 1
+    words = []
+    for i in range(nwords):
+        x = (x * 6364136223846793005 + 1442695040888963407) % 2 ** 64
+        words.append((x >> 32).to_bytes(4, 'little'))
+    n = int.from_bytes(b''.join(words), 'little') % 10 ** (ndigits - 1)
+    return n + 10 ** (ndigits - 1)
+
+
+def bench_str(ndigits):
+    n = make_int(ndigits)
+    return lambda: str(n)
+
+
+def bench_int(ndigits):
+    s = str(make_int(ndigits))
+    return lambda: int(s)
+
+
+def bench_mul(ndigits):
+    a = make_int(ndigits)
+    b = make_int(ndigits, 1)
+    return lambda: a * b
+
+
+def bench_divmod(ndigits):
+    a = make_int(2 * ndigits)
+    b = make_int(ndigits, 1)
+    return lambda: divmod(a, b)
+
+
+def bench_powmod(ndigits):
+    a = make_int(ndigits)
+    m = make_int(ndigits, 1)
+    return lambda: pow(a, 0xffff, m)
+
+
+BENCHMARKS = {
+    'str': (bench_str, "str(n), n with N digits"),
+    'int': (bench_int, "int(s), s a string of N digits"),
+    'mul': (bench_mul, "a * b, a and b with N digits"),
+    'divmod': (bench_divmod, "divmod(a, b), a with 2*N and b with N digits"),
+    'powmod': (bench_powmod, "pow(a, 2**16-1, m), a and m with N digits"),
+}
+
+
+def timeit(func, min_time):
+    best = float('inf')
+    total = 0.0
+    runs = 0
+    while runs < 3 or total < min_time:
+        t0 = time.perf_counter()
+        func()
+        dt = time.perf_counter() - t0
+        best = min(best, dt)
+        total += dt
+        runs += 1
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('-s', '--sizes', default='1e3,1e4,1e5,1e6',
+                        help="comma-separated operand sizes in decimal "
+                             "digits (default: %(default)s)")
+    parser.add_argument('-t', '--min-time', type=float, default=0.5,
+                        help="minimum total time per measurement in seconds "
+                             "(default: %(default)s)")
+    parser.add_argument('benchmarks', nargs='*', metavar='BENCHMARK',
+                        help="benchmarks to run, among: %s (default: all)"
+                             % ', '.join(BENCHMARKS))
+    args = parser.parse_args()
+
+    sizes = [int(float(s)) for s in args.sizes.split(',')]
+    names = args.benchmarks or list(BENCHMARKS)
+    for name in names:
+        if name not in BENCHMARKS:
+            parser.error("unknown benchmark: %s" % name)
+
+    print("Python %s, %d-bit digits"
+          % (sys.version.split()[0], sys.int_info.bits_per_digit))
+    for name in names:
+        setup, description = BENCHMARKS[name]
+        print()
+        print("%s: %s" % (name, description))
+        for ndigits in sizes:
+            t = timeit(setup(ndigits), args.min_time)
+            print("  N = %-10d %12.6f s" % (ndigits, t))
+            sys.stdout.flush()
+
+
+if __name__ == '__main__':
+    main()
@@ -218,6 +218,60 @@ def find_test_slow_match_100_characters_bis(STR):
     for x in _RANGE_100:
         s1_find(s2)
 
+@bench('("ABCDEFGHIJ"*1000+"W").find("W")',
+       "late match, 1 character", 100)
+def find_test_late_match_1_character(STR):
+    s1 = STR("ABCDEFGHIJ"*1000 + "W")
+    s2 = STR("W")
+    s1_find = s1.find
+    for x in _RANGE_100:
+        s1_find(s2)
+
+@bench('("ABCDEFGHIJ"*1000+"XYZW").find("XYZW")',
+       "late match, 4 characters", 100)
+def find_test_late_match_4_characters(STR):
+    s1 = STR("ABCDEFGHIJ"*1000 + "XYZW")
+    s2 = STR("XYZW")
+    s1_find = s1.find
+    for x in _RANGE_100:
+        s1_find(s2)
+
+@bench('("ABCDEFGHIJ"*1000+"XYZW"*4).find("XYZW"*4)',
+       "late match, 16 characters", 100)
+def find_test_late_match_16_characters(STR):
+    s1 = STR("ABCDEFGHIJ"*1000 + "XYZW"*4)
+    s2 = STR("XYZW"*4)
+    s1_find = s1.find
+    for x in _RANGE_100:
+        s1_find(s2)
+
+@bench('("ABCDEFGHIJ"*1000+"XYZW"*16).find("XYZW"*16)',
+       "late match, 64 characters", 100)
+def find_test_late_match_64_characters(STR):
+    s1 = STR("ABCDEFGHIJ"*1000 + "XYZW"*16)
+    s2 = STR("XYZW"*16)
+    s1_find = s1.find
+    for x in _RANGE_100:
+        s1_find(s2)
+
+@bench('("ABCDEFGHIJ"*1000+"XYZW"*64).find("XYZW"*64)',
+       "late match, 256 characters", 100)
+def find_test_late_match_256_characters(STR):
+    s1 = STR("ABCDEFGHIJ"*1000 + "XYZW"*64)
+    s2 = STR("XYZW"*64)
+    s1_find = s1.find
+    for x in _RANGE_100:
+        s1_find(s2)
+
+@bench('("ABCDEFGHIJ"*1000+"XYZW"*250).find("XYZW"*250)',
+       "late match, 1000 characters", 100)
+def find_test_late_match_1000_characters(STR):
+    s1 = STR("ABCDEFGHIJ"*1000 + "XYZW"*250)
+    s2 = STR("XYZW"*250)
+    s1_find = s1.find
+    for x in _RANGE_100:
+        s1_find(s2)
+
 
 #### Same tests for 'rfind'
 